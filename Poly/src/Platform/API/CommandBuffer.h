@@ -24,10 +24,11 @@ namespace Poly
 
 	struct CopyBufferDesc
 	{
-		// Width, height and aspect mask is presumed to be the same values from the texture image
-		uint64 BufferOffset      = 0;
-		uint32 BufferRowLength   = 0;
-		uint32 BufferImageHeight = 0;
+		// Width, height and aspect mask is presumed to be the same values from the texture image. Sizes are in texels
+		// for block-compressed formats too, the buffer then holds whole blocks (see GetFormatImageSize())
+		uint64 BufferOffset      = 0; // Multiple of the format's block size
+		uint32 BufferRowLength   = 0; // 0 - tightly packed
+		uint32 BufferImageHeight = 0; // 0 - tightly packed
 		uint32 MipLevel          = 0;
 		uint32 ArrayLayer        = 0;
 		uint32 ArrayCount        = 0;
@@ -59,6 +60,8 @@ namespace Poly
 		uint32         DstQueueIndex = 0;
 		Texture*       pTexture      = nullptr;
 		FImageViewFlag AspectMask    = FImageViewFlag::NONE;
+		uint32         MipLevel      = 0;
+		uint32         MipLevelCount = 0; // 0 - every level from MipLevel down
 	};
 
 	struct AccessBarrier
@@ -87,8 +90,30 @@ namespace Poly
 		std::vector<RenderingAttachmentInfo> ColorAttachments;
 		RenderingAttachmentInfo*             pDepthAttachment   = nullptr;
 		RenderingAttachmentInfo*             pStencilAttachment = nullptr;
+		bool                                 SecondaryContents  = false; // Contents come from ExecuteCommands() only - no inline draws
 	};
 
+	// Attachment formats a secondary command buffer inherits from the BeginRendering() scope it's executed in
+	struct RenderingInheritanceDesc
+	{
+		std::vector<EFormat> ColorAttachmentFormats;
+		EFormat              DepthAttachmentFormat   = EFormat::UNDEFINED;
+		EFormat              StencilAttachmentFormat = EFormat::UNDEFINED;
+		uint32               ViewMask                = 0;
+	};
+
+	// Layout of one command in a DrawIndexedIndirectCount() argument buffer - matches VkDrawIndexedIndirectCommand /
+	// D3D12_DRAW_INDEXED_ARGUMENTS, and DrawIndexedCommand in common/bindless.glsl for buffers written on the GPU
+	struct DrawIndexedIndirectCommand
+	{
+		uint32 IndexCount    = 0;
+		uint32 InstanceCount = 0;
+		uint32 FirstIndex    = 0;
+		int32  VertexOffset  = 0;
+		uint32 FirstInstance = 0;
+	};
+	static_assert(sizeof(DrawIndexedIndirectCommand) == 20, "DrawIndexedIndirectCommand must be tightly packed");
+
 	class CommandBuffer
 	{
 	public:
@@ -96,9 +121,10 @@ namespace Poly
 
 		/**
 		 * Init the Buffer object
-		 * @param desc	Buffer creation description
+		 * @param pCommandPool - Pool to allocate the buffer from
+		 * @param level - Primary buffers are submitted to a queue, secondary ones are executed from a primary
 		 */
-		virtual void Init(CommandPool* pCommandPool) = 0;
+		virtual void Init(CommandPool* pCommandPool, ECommandBufferLevel level) = 0;
 
 		/**
 		 * Begin the command buffer for recording of commands
@@ -106,6 +132,13 @@ namespace Poly
 		 */
 		virtual void Begin(FCommandBufferFlag bufferFlag) = 0;
 
+		/**
+		 * Begin a secondary command buffer that continues a dynamic rendering scope - only valid for SECONDARY buffers
+		 * @param pInheritance - Attachment formats of the BeginRendering() scope the buffer will be executed in
+		 * @param bufferFlag - Usage of buffer, single time or normal
+		 */
+		virtual void BeginSecondary(const RenderingInheritanceDesc* pInheritance, FCommandBufferFlag bufferFlag) = 0;
+
 		/**
 		 * Begin a render pass
 		 * @param pRenderPass - Render pass to begin
@@ -182,6 +215,20 @@ namespace Poly
 		 */
 		virtual void CopyTextureToBuffer(const Texture* pTexture, const Buffer* pBuffer, ETextureLayout layout, const CopyBufferDesc& copyBufferDesc) = 0;
 
+		/**
+		 * Scaled copy of one mip level of a texture into a mip level of another (or the same) texture, covering
+		 * both levels entirely - must be recorded on a queue with graphics support
+		 * @param pSrcTexture - Texture to copy from
+		 * @param srcLayout - Layout of the source level, TRANSFER_SRC_OPTIMAL or GENERAL
+		 * @param srcMipLevel - Mip level to copy from
+		 * @param pDstTexture - Texture to copy to
+		 * @param dstLayout - Layout of the destination level, TRANSFER_DST_OPTIMAL or GENERAL
+		 * @param dstMipLevel - Mip level to copy to
+		 * @param filter - Filter used when the levels differ in size
+		 */
+		virtual void BlitTexture(const Texture* pSrcTexture, ETextureLayout srcLayout, uint32 srcMipLevel, const Texture* pDstTexture, ETextureLayout dstLayout,
+		                         uint32 dstMipLevel, EFilter filter) = 0;
+
 		/**
 		 * Copy source buffer to destination buffer
 		 * @param pSrcBuffer - source buffer
@@ -248,6 +295,40 @@ namespace Poly
 		 */
 		virtual void DrawIndexedInstanced(uint32 indexCount, uint32 instanceCount, uint32 firstIndex, uint32 vertexOffset, uint32 firstInstance) = 0;
 
+		/**
+		 * Draw indexed with both the draw parameters and the amount of draws read from buffers on the GPU
+		 * @param pBuffer - Buffer of DrawIndexedIndirectCommand - must be created with the indirect buffer flag
+		 * @param offset - Offset in bytes of the first command - must be a multiple of 4
+		 * @param pCountBuffer - Buffer holding the uint32 draw count - must be created with the indirect buffer flag
+		 * @param countOffset - Offset in bytes of the draw count - must be a multiple of 4
+		 * @param maxDrawCount - Upper bound of the draw count, the read count is clamped to it
+		 * @param stride - Bytes between two commands, sizeof(DrawIndexedIndirectCommand) when tightly packed
+		 */
+		virtual void DrawIndexedIndirectCount(const Buffer* pBuffer, uint64 offset, const Buffer* pCountBuffer, uint64 countOffset, uint32 maxDrawCount,
+		                                      uint32 stride = sizeof(DrawIndexedIndirectCommand)) = 0;
+
+		/**
+		 * Dispatch the bound compute pipeline - must be called outside of a BeginRendering() scope
+		 * @param groupCountX - Amount of workgroups in X
+		 * @param groupCountY - Amount of workgroups in Y
+		 * @param groupCountZ - Amount of workgroups in Z
+		 */
+		virtual void Dispatch(uint32 groupCountX, uint32 groupCountY, uint32 groupCountZ) = 0;
+
+		/**
+		 * Dispatch the bound compute pipeline with the workgroup counts read from a buffer on the GPU
+		 * @param pBuffer - Buffer holding three uint32 workgroup counts - must be created with the indirect buffer flag
+		 * @param offset - Offset in bytes of the counts in the buffer - must be a multiple of 4
+		 */
+		virtual void DispatchIndirect(const Buffer* pBuffer, uint64 offset) = 0;
+
+		/**
+		 * Execute recorded secondary command buffers - inside a BeginRendering() scope this requires RenderingDesc::SecondaryContents
+		 * @param ppCommandBuffers - Secondary command buffers, already ended
+		 * @param count - Number of command buffers in ppCommandBuffers
+		 */
+		virtual void ExecuteCommands(CommandBuffer* const* ppCommandBuffers, uint32 count) = 0;
+
 		/**
 		 * Acquire buffer ownership - NOTE: Must match with a ReleaseBuffer with the necessary parameters
 		 * @param pBuffer - Buffer to acquire (must match ReleaseBuffer)
@@ -360,7 +441,13 @@ namespace Poly
 			return p_pCommandPool;
 		}
 
+		/**
+		 * @return Whether the buffer is submitted to a queue (primary) or executed from another buffer (secondary)
+		 */
+		inline ECommandBufferLevel GetLevel() const { return p_Level; }
+
 	protected:
-		CommandPool* p_pCommandPool;
+		CommandPool*        p_pCommandPool;
+		ECommandBufferLevel p_Level = ECommandBufferLevel::PRIMARY;
 	};
 } // namespace Poly
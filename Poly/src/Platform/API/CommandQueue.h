@@ -54,6 +54,14 @@ namespace Poly
 		 */
 		virtual void Submit(const SubmitDesc& submitDesc) = 0;
 
+		/**
+		 * Submit several batches in one go - a single driver submission instead of one per SubmitDesc.
+		 * Batches start executing in array order, each one still waiting on and signalling only its own sync points.
+		 * @param pSubmitDescs - Array of submit descriptions, in submission order
+		 * @param count - Number of submit descriptions in pSubmitDescs
+		 */
+		virtual void SubmitBatch(const SubmitDesc* pSubmitDescs, uint32 count) = 0;
+
 		/**
 		 * Waits for the queue to be idle
 		 */
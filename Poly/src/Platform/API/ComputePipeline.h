@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Platform/API/Pipeline.h"
+#include "Poly/Core/Core.h"
+#include "Poly/Rendering/Core/API/GraphicsTypes.h"
+
+namespace Poly
+{
+	class Shader;
+	class PipelineLayout;
+
+	struct ComputePipelineDesc : public PipelineDesc
+	{
+		PipelineLayout* pPipelineLayout = nullptr;
+		Shader*         pComputeShader  = nullptr;
+	};
+
+	class ComputePipeline : public Pipeline
+	{
+	public:
+		CLASS_ABSTRACT(ComputePipeline);
+
+		/**
+		 * Init the ComputePipeline object
+		 * @param pDesc - Pipeline creation description
+		 */
+		virtual void Init(const ComputePipelineDesc* pDesc) = 0;
+
+		/**
+		 * @return Pipeline layout for this pipeline
+		 */
+		virtual PipelineLayout* GetPipelineLayout() const = 0;
+
+		/**
+		 * @return Native handle to the API specific object
+		 */
+		virtual uint64 GetNative() const = 0;
+
+	protected:
+		ComputePipelineDesc p_PipelineDesc;
+	};
+} // namespace Poly
@@ -10,6 +10,8 @@ namespace Poly
 	struct BufferDesc;
 	struct SamplerDesc;
 	struct TextureDesc;
+	struct MemoryBlockDesc;
+	struct MemoryRequirements;
 	struct SwapChainDesc;
 	struct FramebufferDesc;
 	struct TextureViewDesc;
@@ -17,6 +19,7 @@ namespace Poly
 	struct DescriptorSetDesc;
 	struct PipelineLayoutDesc;
 	struct GraphicsPipelineDesc;
+	struct ComputePipelineDesc;
 	struct GraphicsRenderPassDesc;
 
 	// Classes
@@ -25,6 +28,7 @@ namespace Poly
 	class Window;
 	class Sampler;
 	class Texture;
+	class MemoryBlock;
 	class SwapChain;
 	class SyncPoint;
 	class Framebuffer;
@@ -35,6 +39,7 @@ namespace Poly
 	class PipelineLayout;
 	class BinarySemaphore;
 	class GraphicsPipeline;
+	class ComputePipeline;
 	class GraphicsRenderPass;
 
 	class GraphicsInstance
@@ -56,10 +61,14 @@ namespace Poly
 		virtual Ref<Shader>             CreateShader(const ShaderDesc* pDesc)                            = 0;
 		virtual Ref<GraphicsRenderPass> CreateGraphicsRenderPass(const GraphicsRenderPassDesc* pDesc)    = 0;
 		virtual Ref<GraphicsPipeline>   CreateGraphicsPipeline(const GraphicsPipelineDesc* pDesc)        = 0;
+		virtual Ref<ComputePipeline>    CreateComputePipeline(const ComputePipelineDesc* pDesc)          = 0;
 		virtual Ref<PipelineLayout>     CreatePipelineLayout(const PipelineLayoutDesc* pDesc)            = 0;
 		virtual Ref<Framebuffer>        CreateFramebuffer(const FramebufferDesc* pDesc)                  = 0;
 		virtual Ref<DescriptorSet>      CreateDescriptorSet(PipelineLayout* pLayout, uint32 setIndex)    = 0;
 
 		virtual Ref<DescriptorSet> CreateDescriptorSetCopy(const Ref<DescriptorSet>& pSrcDescriptorSet) = 0;
+
+		virtual Ref<MemoryBlock>   CreateMemoryBlock(const MemoryBlockDesc* pDesc)        = 0;
+		virtual MemoryRequirements GetTextureMemoryRequirements(const TextureDesc* pDesc) = 0;
 	};
 } // namespace Poly
\ No newline at end of file
@@ -6,10 +6,6 @@
 
 #include <vector>
 
-/**
- * This pipeline is only for Graphics until Compute is added later
- */
-
 namespace Poly
 {
 	class Shader;
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Poly/Core/Core.h"
+#include "Poly/Rendering/Core/API/GraphicsTypes.h"
+
+namespace Poly
+{
+	struct MemoryRequirements
+	{
+		uint64 Size           = 0;
+		uint64 Alignment      = 0;
+		uint32 MemoryTypeBits = 0; // memory types the resource can live in, 0 = none in common
+	};
+
+	struct MemoryBlockDesc
+	{
+		MemoryRequirements Requirements;
+		EMemoryUsage       MemoryUsage = EMemoryUsage::GPU_ONLY;
+		std::string        DebugName   = "";
+	};
+
+	/*
+	 * A raw device memory allocation that resources can be placed into (see TextureDesc::pMemoryBlock)
+	 * instead of each getting their own. Several resources placed at overlapping ranges alias each
+	 * other - only one of them may hold meaningful contents at a time, and switching between them needs
+	 * an aliasing barrier (see RenderProgramBuilder's transient lifetime analysis).
+	 */
+	class MemoryBlock
+	{
+	public:
+		CLASS_ABSTRACT(MemoryBlock);
+
+		/**
+		 * Allocates the memory block
+		 * @param pDesc - Size/alignment/type requirements the block must satisfy
+		 */
+		virtual void Init(const MemoryBlockDesc* pDesc) = 0;
+
+		/**
+		 * @return Native handle to the API specific object
+		 */
+		virtual uint64 GetNative() const = 0;
+
+		/**
+		 * @return const MemoryBlockDesc
+		 */
+		inline const MemoryBlockDesc& GetDesc() const
+		{
+			return p_MemoryBlockDesc;
+		}
+
+		uint64 GetSize() const { return p_MemoryBlockDesc.Requirements.Size; }
+
+	protected:
+		MemoryBlockDesc p_MemoryBlockDesc;
+	};
+} // namespace Poly
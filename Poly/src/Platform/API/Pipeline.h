@@ -3,10 +3,6 @@
 #include "Poly/Core/Core.h"
 #include "Poly/Rendering/Core/API/GraphicsTypes.h"
 
-/**
- * This pipeline is only for Graphics until Compute is added later
- */
-
 namespace Poly
 {
 	struct PipelineDesc
@@ -17,7 +17,7 @@ namespace Poly
 		samplerDesc.BorderColor     = EBorderColor::INT_OPAQUE_BLACK;
 		samplerDesc.MipLodBias      = 0.0f;
 		samplerDesc.MinLod          = 0.0f;
-		samplerDesc.MaxLod          = 0.0f;
+		samplerDesc.MaxLod          = SamplerDesc::LOD_CLAMP_NONE;
 		samplerDesc.AnistropyEnable = true;
 		samplerDesc.MaxAnisotropy   = 16.0f;
 
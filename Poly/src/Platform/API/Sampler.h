@@ -5,18 +5,22 @@
 
 namespace Poly
 {
+	// Defaults to trilinear filtering over the whole mip chain
 	struct SamplerDesc
 	{
-		EFilter             MinFilter       = EFilter::NONE;
-		EFilter             MagFilter       = EFilter::NONE;
-		ESamplerAddressMode AddressModeU    = ESamplerAddressMode::NONE;
-		ESamplerAddressMode AddressModeV    = ESamplerAddressMode::NONE;
-		ESamplerAddressMode AddressModeW    = ESamplerAddressMode::NONE;
-		ESamplerMipmapMode  MipMapMode      = ESamplerMipmapMode::NONE;
+		// MaxLod that never clamps - every mip level the view has is sampled
+		static constexpr float LOD_CLAMP_NONE = 1000.0f;
+
+		EFilter             MinFilter       = EFilter::LINEAR;
+		EFilter             MagFilter       = EFilter::LINEAR;
+		ESamplerAddressMode AddressModeU    = ESamplerAddressMode::REPEAT;
+		ESamplerAddressMode AddressModeV    = ESamplerAddressMode::REPEAT;
+		ESamplerAddressMode AddressModeW    = ESamplerAddressMode::REPEAT;
+		ESamplerMipmapMode  MipMapMode      = ESamplerMipmapMode::LINEAR;
 		EBorderColor        BorderColor     = EBorderColor::NONE;
 		float               MipLodBias      = 0.0f;
 		float               MinLod          = 0.0f;
-		float               MaxLod          = 0.0f;
+		float               MaxLod          = LOD_CLAMP_NONE;
 		bool                AnistropyEnable = false;
 		float               MaxAnisotropy   = 16.0f;
 	};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "MemoryBlock.h"
 #include "Poly/Core/Core.h"
 #include "Poly/Rendering/Core/API/GraphicsTypes.h"
 
@@ -18,6 +19,11 @@ namespace Poly
 		FTextureUsage TextureUsage = FTextureUsage::NONE;
 		ETextureDim   TextureDim   = ETextureDim::NONE;
 		std::string   DebugName    = "";
+
+		// Places the texture in an existing allocation instead of giving it its own - MemoryUsage is then
+		// ignored. The texture keeps the block alive.
+		Ref<MemoryBlock> pMemoryBlock = nullptr;
+		uint64           MemoryOffset = 0;
 	};
 
 	class Texture
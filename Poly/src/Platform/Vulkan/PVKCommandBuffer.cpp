@@ -6,6 +6,7 @@
 #include "polypch.h"
 #include "PVKBuffer.h"
 #include "PVKCommandPool.h"
+#include "PVKComputePipeline.h"
 #include "PVKDescriptorSet.h"
 #include "PVKFramebuffer.h"
 #include "PVKGraphicsPipeline.h"
@@ -34,6 +35,32 @@ namespace
 
 		return vkAttachment;
 	}
+
+	VkPipeline GetNativePipelineVK(const Poly::Pipeline* pPipeline)
+	{
+		switch (pPipeline->GetPipelineType())
+		{
+		case Poly::EPipelineType::GRAPHICS:
+			return static_cast<const Poly::PVKGraphicsPipeline*>(pPipeline)->GetNativeVK();
+		case Poly::EPipelineType::COMPUTE:
+			return static_cast<const Poly::PVKComputePipeline*>(pPipeline)->GetNativeVK();
+		default:
+			return VK_NULL_HANDLE;
+		}
+	}
+
+	const Poly::PVKPipelineLayout* GetPipelineLayoutVK(const Poly::Pipeline* pPipeline)
+	{
+		switch (pPipeline->GetPipelineType())
+		{
+		case Poly::EPipelineType::GRAPHICS:
+			return static_cast<const Poly::PVKPipelineLayout*>(static_cast<const Poly::PVKGraphicsPipeline*>(pPipeline)->GetPipelineLayout());
+		case Poly::EPipelineType::COMPUTE:
+			return static_cast<const Poly::PVKPipelineLayout*>(static_cast<const Poly::PVKComputePipeline*>(pPipeline)->GetPipelineLayout());
+		default:
+			return nullptr;
+		}
+	}
 } // namespace
 
 namespace Poly
@@ -44,14 +71,15 @@ namespace Poly
 		// Destruction of command buffers happens when command pool is destroyed
 	}
 
-	void PVKCommandBuffer::Init(CommandPool* pCommandPool)
+	void PVKCommandBuffer::Init(CommandPool* pCommandPool, ECommandBufferLevel level)
 	{
 		p_pCommandPool = pCommandPool;
+		p_Level        = level;
 
 		VkCommandBufferAllocateInfo allocInfo = {};
 		allocInfo.sType                       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 		allocInfo.commandPool                 = reinterpret_cast<PVKCommandPool*>(pCommandPool)->GetNativeVK();
-		allocInfo.level                       = VK_COMMAND_BUFFER_LEVEL_PRIMARY; // Current implementation only supports primary
+		allocInfo.level                       = ConvertCommandBufferType(level);
 		allocInfo.commandBufferCount          = 1;
 
 		PVK_CHECK(vkAllocateCommandBuffers(PVKInstance::GetDevice(), &allocInfo, &m_Buffer), "Failed to allocate command buffers!")
@@ -59,8 +87,6 @@ namespace Poly
 
 	void PVKCommandBuffer::Begin(FCommandBufferFlag bufferFlag)
 	{
-		// TODO: Add support for secondary buffers
-
 		VkCommandBufferBeginInfo beginInfo = {};
 		beginInfo.sType                    = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 		beginInfo.flags                    = ConvertCommandBufferUsage(bufferFlag);
@@ -69,6 +95,37 @@ namespace Poly
 		PVK_CHECK(vkBeginCommandBuffer(m_Buffer, &beginInfo), "Failed to begin recording of command buffer!");
 	}
 
+	void PVKCommandBuffer::BeginSecondary(const RenderingInheritanceDesc* pInheritance, FCommandBufferFlag bufferFlag)
+	{
+		POLY_VALIDATE(p_Level == ECommandBufferLevel::SECONDARY, "BeginSecondary called on a primary command buffer!");
+
+		std::vector<VkFormat> colorFormats;
+		colorFormats.reserve(pInheritance->ColorAttachmentFormats.size());
+		for (EFormat format : pInheritance->ColorAttachmentFormats)
+			colorFormats.push_back(ConvertFormatVK(format));
+
+		VkCommandBufferInheritanceRenderingInfo renderingInfo = {};
+		renderingInfo.sType                                   = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+		renderingInfo.flags                                   = 0;
+		renderingInfo.viewMask                                = pInheritance->ViewMask;
+		renderingInfo.colorAttachmentCount                    = static_cast<uint32>(colorFormats.size());
+		renderingInfo.pColorAttachmentFormats                 = colorFormats.data();
+		renderingInfo.depthAttachmentFormat                   = pInheritance->DepthAttachmentFormat != EFormat::UNDEFINED ? ConvertFormatVK(pInheritance->DepthAttachmentFormat) : VK_FORMAT_UNDEFINED;
+		renderingInfo.stencilAttachmentFormat                 = pInheritance->StencilAttachmentFormat != EFormat::UNDEFINED ? ConvertFormatVK(pInheritance->StencilAttachmentFormat) : VK_FORMAT_UNDEFINED;
+		renderingInfo.rasterizationSamples                    = VK_SAMPLE_COUNT_1_BIT;
+
+		VkCommandBufferInheritanceInfo inheritanceInfo = {};
+		inheritanceInfo.sType                          = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.pNext                          = &renderingInfo;
+
+		VkCommandBufferBeginInfo beginInfo = {};
+		beginInfo.sType                    = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags                    = ConvertCommandBufferUsage(bufferFlag) | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		beginInfo.pInheritanceInfo         = &inheritanceInfo;
+
+		PVK_CHECK(vkBeginCommandBuffer(m_Buffer, &beginInfo), "Failed to begin recording of secondary command buffer!");
+	}
+
 	void PVKCommandBuffer::BeginRenderPass(GraphicsRenderPass* pRenderPass, Framebuffer* pFramebuffer, uint32 width, uint32 height, std::vector<ClearValue> clearValues)
 	{
 		VkExtent2D            extent         = {width, height};
@@ -112,7 +169,7 @@ namespace Poly
 		VkRenderingInfo renderingInfo      = {};
 		renderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO;
 		renderingInfo.pNext                = nullptr;
-		renderingInfo.flags                = 0;
+		renderingInfo.flags                = pRenderingDesc->SecondaryContents ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0;
 		renderingInfo.renderArea           = renderArea;
 		renderingInfo.layerCount           = pRenderingDesc->LayerCount;
 		renderingInfo.viewMask             = pRenderingDesc->ViewMask;
@@ -126,34 +183,28 @@ namespace Poly
 
 	void PVKCommandBuffer::BindPipeline(Pipeline* pPipeline)
 	{
-		if (pPipeline->GetPipelineType() == EPipelineType::GRAPHICS)
-		{
-			vkCmdBindPipeline(
-			    m_Buffer,
-			    ConvertPipelineTypeVK(pPipeline->GetPipelineType()),
-			    reinterpret_cast<PVKGraphicsPipeline*>(pPipeline)->GetNativeVK());
-		}
-		else
-		{
-			POLY_VALIDATE(false, "BindPipeline failed: Given pipeline did not have any type associated with it!");
-		}
+		VkPipeline pipeline = GetNativePipelineVK(pPipeline);
+		POLY_VALIDATE(pipeline != VK_NULL_HANDLE, "BindPipeline failed: Given pipeline did not have any type associated with it!");
+
+		vkCmdBindPipeline(m_Buffer, ConvertPipelineTypeVK(pPipeline->GetPipelineType()), pipeline);
 	}
 
 	void PVKCommandBuffer::BindDescriptor(const Pipeline* pPipeline, const DescriptorSet* pDescriptor, uint32 dynamicOffsetCount, const uint32* pDynamicOffsets)
 	{
-		if (pPipeline->GetPipelineType() == EPipelineType::GRAPHICS)
-		{
-			VkDescriptorSet descSet = reinterpret_cast<const PVKDescriptorSet*>(pDescriptor)->GetNativeVK();
-			vkCmdBindDescriptorSets(
-			    m_Buffer,
-			    ConvertPipelineTypeVK(pPipeline->GetPipelineType()),
-			    reinterpret_cast<PVKPipelineLayout*>(reinterpret_cast<const PVKGraphicsPipeline*>(pPipeline)->GetPipelineLayout())->GetNativeVK(),
-			    pDescriptor->GetSetIndex(),
-			    1,
-			    &descSet,
-			    dynamicOffsetCount,
-			    pDynamicOffsets);
-		}
+		const PVKPipelineLayout* pLayout = GetPipelineLayoutVK(pPipeline);
+		if (!pLayout)
+			return;
+
+		VkDescriptorSet descSet = reinterpret_cast<const PVKDescriptorSet*>(pDescriptor)->GetNativeVK();
+		vkCmdBindDescriptorSets(
+		    m_Buffer,
+		    ConvertPipelineTypeVK(pPipeline->GetPipelineType()),
+		    pLayout->GetNativeVK(),
+		    pDescriptor->GetSetIndex(),
+		    1,
+		    &descSet,
+		    dynamicOffsetCount,
+		    pDynamicOffsets);
 	}
 
 	void PVKCommandBuffer::BindVertexBuffer(const Buffer* pBuffer, uint32 firstBinding, uint32 bindingCount, uint64 offset)
@@ -319,6 +370,37 @@ namespace Poly
 		vkCmdDrawIndexed(m_Buffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 	}
 
+	void PVKCommandBuffer::DrawIndexedIndirectCount(const Buffer* pBuffer, uint64 offset, const Buffer* pCountBuffer, uint64 countOffset, uint32 maxDrawCount, uint32 stride)
+	{
+		vkCmdDrawIndexedIndirectCount(
+		    m_Buffer,
+		    static_cast<const PVKBuffer*>(pBuffer)->GetNativeVK(),
+		    offset,
+		    static_cast<const PVKBuffer*>(pCountBuffer)->GetNativeVK(),
+		    countOffset,
+		    maxDrawCount,
+		    stride);
+	}
+
+	void PVKCommandBuffer::Dispatch(uint32 groupCountX, uint32 groupCountY, uint32 groupCountZ)
+	{
+		vkCmdDispatch(m_Buffer, groupCountX, groupCountY, groupCountZ);
+	}
+
+	void PVKCommandBuffer::DispatchIndirect(const Buffer* pBuffer, uint64 offset)
+	{
+		vkCmdDispatchIndirect(m_Buffer, static_cast<const PVKBuffer*>(pBuffer)->GetNativeVK(), offset);
+	}
+
+	void PVKCommandBuffer::ExecuteCommands(CommandBuffer* const* ppCommandBuffers, uint32 count)
+	{
+		std::vector<VkCommandBuffer> commandBuffers(count);
+		for (uint32 i = 0; i < count; i++)
+			commandBuffers[i] = static_cast<PVKCommandBuffer*>(ppCommandBuffers[i])->GetNativeVK();
+
+		vkCmdExecuteCommands(m_Buffer, count, commandBuffers.data());
+	}
+
 	void PVKCommandBuffer::AcquireBuffer(
 	    const Buffer*  pBuffer,
 	    FPipelineStage srcStage,
@@ -383,6 +465,34 @@ namespace Poly
 		    nullptr);
 	}
 
+	void PVKCommandBuffer::BlitTexture(const Texture* pSrcTexture, ETextureLayout srcLayout, uint32 srcMipLevel, const Texture* pDstTexture, ETextureLayout dstLayout,
+	                                   uint32 dstMipLevel, EFilter filter)
+	{
+		VkImageBlit blit                   = {};
+		blit.srcSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+		blit.srcSubresource.mipLevel       = srcMipLevel;
+		blit.srcSubresource.baseArrayLayer = 0;
+		blit.srcSubresource.layerCount     = 1;
+		blit.srcOffsets[1]                 = {static_cast<int32>(std::max(pSrcTexture->GetWidth() >> srcMipLevel, 1u)),
+		                                      static_cast<int32>(std::max(pSrcTexture->GetHeight() >> srcMipLevel, 1u)), 1};
+		blit.dstSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+		blit.dstSubresource.mipLevel       = dstMipLevel;
+		blit.dstSubresource.baseArrayLayer = 0;
+		blit.dstSubresource.layerCount     = 1;
+		blit.dstOffsets[1]                 = {static_cast<int32>(std::max(pDstTexture->GetWidth() >> dstMipLevel, 1u)),
+		                                      static_cast<int32>(std::max(pDstTexture->GetHeight() >> dstMipLevel, 1u)), 1};
+
+		vkCmdBlitImage(
+		    m_Buffer,
+		    reinterpret_cast<const PVKTexture*>(pSrcTexture)->GetNativeVK(),
+		    ConvertTextureLayoutVK(srcLayout),
+		    reinterpret_cast<const PVKTexture*>(pDstTexture)->GetNativeVK(),
+		    ConvertTextureLayoutVK(dstLayout),
+		    1,
+		    &blit,
+		    ConvertFilterVK(filter));
+	}
+
 	void PVKCommandBuffer::AcquireTexture(
 	    const Texture* pTexture,
 	    FPipelineStage srcStage,
@@ -396,7 +506,7 @@ namespace Poly
 		VkImageSubresourceRange range = {};
 		range.aspectMask              = VkImageAspectFlagBits::VK_IMAGE_ASPECT_COLOR_BIT;
 		range.baseMipLevel            = 0;
-		range.levelCount              = 1;
+		range.levelCount              = VK_REMAINING_MIP_LEVELS;
 		range.baseArrayLayer          = 0;
 		range.layerCount              = 1;
 
@@ -438,7 +548,7 @@ namespace Poly
 		VkImageSubresourceRange range = {};
 		range.aspectMask              = VkImageAspectFlagBits::VK_IMAGE_ASPECT_COLOR_BIT;
 		range.baseMipLevel            = 0;
-		range.levelCount              = 1;
+		range.levelCount              = VK_REMAINING_MIP_LEVELS;
 		range.baseArrayLayer          = 0;
 		range.layerCount              = 1;
 
@@ -476,11 +586,10 @@ namespace Poly
 	    ETextureLayout oldLayout,
 	    ETextureLayout newLayout)
 	{
-		// TODO: Allow for a dynamic range
 		VkImageSubresourceRange range = {};
 		range.aspectMask              = VkImageAspectFlagBits::VK_IMAGE_ASPECT_COLOR_BIT;
 		range.baseMipLevel            = 0;
-		range.levelCount              = 1;
+		range.levelCount              = VK_REMAINING_MIP_LEVELS;
 		range.baseArrayLayer          = 0;
 		range.layerCount              = 1;
 
@@ -603,8 +712,8 @@ namespace Poly
 
 			VkImageSubresourceRange range = {};
 			range.aspectMask              = ConvertImageViewFlagsVK(b.AspectMask);
-			range.baseMipLevel            = 0;
-			range.levelCount              = 1;
+			range.baseMipLevel            = b.MipLevel;
+			range.levelCount              = b.MipLevelCount == 0 ? VK_REMAINING_MIP_LEVELS : b.MipLevelCount;
 			range.baseArrayLayer          = 0;
 			range.layerCount              = 1;
 
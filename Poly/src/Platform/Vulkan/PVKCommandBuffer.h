@@ -11,12 +11,14 @@ namespace Poly
 		PVKCommandBuffer() = default;
 		~PVKCommandBuffer();
 
-		virtual void Init(CommandPool* pCommandPool) override final;
+		virtual void Init(CommandPool* pCommandPool, ECommandBufferLevel level) override final;
 
 		/* Commands */
 
 		virtual void Begin(FCommandBufferFlag bufferFlag) override final;
 
+		virtual void BeginSecondary(const RenderingInheritanceDesc* pInheritance, FCommandBufferFlag bufferFlag) override final;
+
 		virtual void BeginRenderPass(GraphicsRenderPass* pRenderPass, Framebuffer* pFramebuffer, uint32 width, uint32 height, std::vector<ClearValue> clearValues) override final;
 
 		virtual void BeginRendering(const RenderingDesc* pRenderingDesc) override final;
@@ -34,6 +36,8 @@ namespace Poly
 		virtual void CopyBufferToTexture(const Buffer* pBuffer, const Texture* pTexture, ETextureLayout layout, const CopyBufferDesc& copyBufferDesc) override final;
 
 		virtual void CopyTextureToBuffer(const Texture* pTexture, const Buffer* pBuffer, ETextureLayout layout, const CopyBufferDesc& copyBufferDesc) override final;
+		virtual void BlitTexture(const Texture* pSrcTexture, ETextureLayout srcLayout, uint32 srcMipLevel, const Texture* pDstTexture, ETextureLayout dstLayout,
+		                         uint32 dstMipLevel, EFilter filter) override final;
 
 		virtual void CopyBuffer(const Buffer* pSrcBuffer, const Buffer* pDstBuffer, uint64 size, uint64 srcOffset, uint64 dstOffset) override final;
 
@@ -51,6 +55,15 @@ namespace Poly
 
 		virtual void DrawIndexedInstanced(uint32 indexCount, uint32 instanceCount, uint32 firstIndex, uint32 vertexOffset, uint32 firstInstance) override final;
 
+		virtual void DrawIndexedIndirectCount(const Buffer* pBuffer, uint64 offset, const Buffer* pCountBuffer, uint64 countOffset, uint32 maxDrawCount,
+		                                      uint32 stride = sizeof(DrawIndexedIndirectCommand)) override final;
+
+		virtual void Dispatch(uint32 groupCountX, uint32 groupCountY, uint32 groupCountZ) override final;
+
+		virtual void DispatchIndirect(const Buffer* pBuffer, uint64 offset) override final;
+
+		virtual void ExecuteCommands(CommandBuffer* const* ppCommandBuffers, uint32 count) override final;
+
 		virtual void AcquireBuffer(const Buffer* pBuffer, FPipelineStage srcStage, FPipelineStage dstStage, FAccessFlag dstAccessMask, uint32 srcQueueIndex, uint32 dstQueueIndex) override final;
 
 		virtual void ReleaseBuffer(const Buffer* pBuffer, FPipelineStage srcStage, FPipelineStage dstStage, FAccessFlag srcAccessMask, uint32 srcQueueIndex, uint32 dstQueueIndex) override final;
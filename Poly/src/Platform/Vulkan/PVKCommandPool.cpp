@@ -29,7 +29,7 @@ namespace Poly
 	CommandBuffer* PVKCommandPool::AllocateCommandBuffer(ECommandBufferLevel commandBufferLevel)
 	{
 		PVKCommandBuffer* pBuffer = new PVKCommandBuffer();
-		pBuffer->Init(this);
+		pBuffer->Init(this, commandBufferLevel);
 		m_Buffers.push_back(pBuffer);
 		return pBuffer;
 	}
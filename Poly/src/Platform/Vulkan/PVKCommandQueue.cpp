@@ -23,87 +23,99 @@ namespace Poly
 
 	void PVKCommandQueue::Submit(const SubmitDesc& submitDesc)
 	{
-		// Command Buffers
-		std::vector<VkCommandBufferSubmitInfo> commandBufferInfos;
-		commandBufferInfos.reserve(submitDesc.CommandBuffers.size());
-		for (const auto& pCommandBuffer : submitDesc.CommandBuffers)
-		{
-			VkCommandBufferSubmitInfo commandBufferInfo = {};
-			commandBufferInfo.sType                     = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
-			commandBufferInfo.commandBuffer             = reinterpret_cast<PVKCommandBuffer*>(pCommandBuffer)->GetNativeVK();
-			commandBufferInfo.pNext                     = nullptr;
-			commandBufferInfo.deviceMask                = 0;
-			commandBufferInfos.push_back(commandBufferInfo);
-		}
+		SubmitBatch(&submitDesc, 1);
+	}
 
-		// Wait binary/timeline semaphores
-		std::vector<VkSemaphoreSubmitInfo> waitSemaphoreInfos;
-		waitSemaphoreInfos.reserve(submitDesc.WaitSemaphores.size() + submitDesc.WaitSyncPoints.size());
-		for (const auto& pWaitSemaphore : submitDesc.WaitSemaphores)
-		{
-			VkSemaphoreSubmitInfo semaphoreInfo = {};
-			semaphoreInfo.sType                 = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-			semaphoreInfo.semaphore             = reinterpret_cast<PVKBinarySemaphore*>(pWaitSemaphore)->GetNativeVK();
-			semaphoreInfo.stageMask             = reinterpret_cast<PVKBinarySemaphore*>(pWaitSemaphore)->GetWaitStageMaskVK();
-			semaphoreInfo.pNext                 = nullptr;
-			semaphoreInfo.deviceIndex           = 0;
-			waitSemaphoreInfos.push_back(semaphoreInfo);
-		}
+	void PVKCommandQueue::SubmitBatch(const SubmitDesc* pSubmitDescs, uint32 count)
+	{
+		std::lock_guard<std::mutex> lock(*m_Queue.pMutex);
 
-		for (const auto& waitSemaphore : submitDesc.WaitSyncPoints)
-		{
+		m_CommandBufferInfos.clear();
+		m_SemaphoreInfos.clear();
+		m_SubmitInfos.clear();
+
+		auto addSemaphoreInfo = [this](VkSemaphore semaphore, VkPipelineStageFlags2 stageMask, uint64 value) {
 			VkSemaphoreSubmitInfo semaphoreInfo = {};
 			semaphoreInfo.sType                 = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-			semaphoreInfo.semaphore             = reinterpret_cast<PVKSyncPoint*>(waitSemaphore.pSyncPoint)->GetNativeVK();
-			semaphoreInfo.stageMask             = reinterpret_cast<PVKSyncPoint*>(waitSemaphore.pSyncPoint)->GetWaitStageMaskVK();
+			semaphoreInfo.semaphore             = semaphore;
+			semaphoreInfo.stageMask             = stageMask;
 			semaphoreInfo.pNext                 = nullptr;
 			semaphoreInfo.deviceIndex           = 0;
-			semaphoreInfo.value                 = waitSemaphore.Value;
-			waitSemaphoreInfos.push_back(semaphoreInfo);
-		}
+			semaphoreInfo.value                 = value;
+			m_SemaphoreInfos.push_back(semaphoreInfo);
+		};
 
-		// Signal binary/timeline semaphores
-		std::vector<VkSemaphoreSubmitInfo> signalSemaphoreInfos;
-		signalSemaphoreInfos.reserve(submitDesc.SignalSemaphores.size() + submitDesc.SignalSyncPoints.size());
-		for (const auto& pSignalSemaphore : submitDesc.SignalSemaphores)
+		// Flatten every batch's command buffers and semaphores first, recording only counts in the submit infos -
+		// the scratch arrays may still reallocate, so the pointers are patched in once they're complete.
+		for (uint32 i = 0; i < count; i++)
 		{
-			VkSemaphoreSubmitInfo semaphoreInfo = {};
-			semaphoreInfo.sType                 = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-			semaphoreInfo.semaphore             = reinterpret_cast<PVKBinarySemaphore*>(pSignalSemaphore)->GetNativeVK();
-			semaphoreInfo.stageMask             = reinterpret_cast<PVKBinarySemaphore*>(pSignalSemaphore)->GetWaitStageMaskVK();
-			semaphoreInfo.pNext                 = nullptr;
-			semaphoreInfo.deviceIndex           = 0;
-			signalSemaphoreInfos.push_back(semaphoreInfo);
+			const SubmitDesc& submitDesc = pSubmitDescs[i];
+
+			VkSubmitInfo2 submitInfo            = {};
+			submitInfo.sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+			submitInfo.pNext                    = nullptr;
+			submitInfo.commandBufferInfoCount   = static_cast<uint32>(submitDesc.CommandBuffers.size());
+			submitInfo.waitSemaphoreInfoCount   = static_cast<uint32>(submitDesc.WaitSemaphores.size() + submitDesc.WaitSyncPoints.size());
+			submitInfo.signalSemaphoreInfoCount = static_cast<uint32>(submitDesc.SignalSemaphores.size() + submitDesc.SignalSyncPoints.size());
+			m_SubmitInfos.push_back(submitInfo);
+
+			for (const auto& pCommandBuffer : submitDesc.CommandBuffers)
+			{
+				VkCommandBufferSubmitInfo commandBufferInfo = {};
+				commandBufferInfo.sType                     = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+				commandBufferInfo.commandBuffer             = reinterpret_cast<PVKCommandBuffer*>(pCommandBuffer)->GetNativeVK();
+				commandBufferInfo.pNext                     = nullptr;
+				commandBufferInfo.deviceMask                = 0;
+				m_CommandBufferInfos.push_back(commandBufferInfo);
+			}
+
+			// Wait binary/timeline semaphores
+			for (const auto& pWaitSemaphore : submitDesc.WaitSemaphores)
+			{
+				const PVKBinarySemaphore* pSemaphore = reinterpret_cast<PVKBinarySemaphore*>(pWaitSemaphore);
+				addSemaphoreInfo(pSemaphore->GetNativeVK(), pSemaphore->GetWaitStageMaskVK(), 0);
+			}
+
+			for (const auto& waitSemaphore : submitDesc.WaitSyncPoints)
+			{
+				const PVKSyncPoint* pSyncPoint = reinterpret_cast<PVKSyncPoint*>(waitSemaphore.pSyncPoint);
+				addSemaphoreInfo(pSyncPoint->GetNativeVK(), pSyncPoint->GetWaitStageMaskVK(), waitSemaphore.Value);
+			}
+
+			// Signal binary/timeline semaphores
+			for (const auto& pSignalSemaphore : submitDesc.SignalSemaphores)
+			{
+				const PVKBinarySemaphore* pSemaphore = reinterpret_cast<PVKBinarySemaphore*>(pSignalSemaphore);
+				addSemaphoreInfo(pSemaphore->GetNativeVK(), pSemaphore->GetWaitStageMaskVK(), 0);
+			}
+
+			for (const auto& signalSemaphore : submitDesc.SignalSyncPoints)
+			{
+				const PVKSyncPoint* pSyncPoint = reinterpret_cast<PVKSyncPoint*>(signalSemaphore.pSyncPoint);
+				addSemaphoreInfo(pSyncPoint->GetNativeVK(), pSyncPoint->GetWaitStageMaskVK(), signalSemaphore.Value);
+			}
 		}
 
-		for (const auto& signalSemaphore : submitDesc.SignalSyncPoints)
+		const VkCommandBufferSubmitInfo* pNextCommandBufferInfo = m_CommandBufferInfos.data();
+		const VkSemaphoreSubmitInfo*     pNextSemaphoreInfo     = m_SemaphoreInfos.data();
+		for (VkSubmitInfo2& submitInfo : m_SubmitInfos)
 		{
-			VkSemaphoreSubmitInfo semaphoreInfo = {};
-			semaphoreInfo.sType                 = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-			semaphoreInfo.semaphore             = reinterpret_cast<PVKSyncPoint*>(signalSemaphore.pSyncPoint)->GetNativeVK();
-			semaphoreInfo.stageMask             = reinterpret_cast<PVKSyncPoint*>(signalSemaphore.pSyncPoint)->GetWaitStageMaskVK();
-			semaphoreInfo.pNext                 = nullptr;
-			semaphoreInfo.deviceIndex           = 0;
-			semaphoreInfo.value                 = signalSemaphore.Value;
-			signalSemaphoreInfos.push_back(semaphoreInfo);
+			submitInfo.pCommandBufferInfos = pNextCommandBufferInfo;
+			pNextCommandBufferInfo += submitInfo.commandBufferInfoCount;
+
+			submitInfo.pWaitSemaphoreInfos = pNextSemaphoreInfo;
+			pNextSemaphoreInfo += submitInfo.waitSemaphoreInfoCount;
+
+			submitInfo.pSignalSemaphoreInfos = pNextSemaphoreInfo;
+			pNextSemaphoreInfo += submitInfo.signalSemaphoreInfoCount;
 		}
 
-		// Submit
-		VkSubmitInfo2 submitInfo            = {};
-		submitInfo.sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
-		submitInfo.pCommandBufferInfos      = commandBufferInfos.data();
-		submitInfo.commandBufferInfoCount   = commandBufferInfos.size();
-		submitInfo.pSignalSemaphoreInfos    = signalSemaphoreInfos.data();
-		submitInfo.signalSemaphoreInfoCount = signalSemaphoreInfos.size();
-		submitInfo.pWaitSemaphoreInfos      = waitSemaphoreInfos.data();
-		submitInfo.waitSemaphoreInfoCount   = waitSemaphoreInfos.size();
-		submitInfo.pNext                    = nullptr;
-
-		PVK_CHECK(vkQueueSubmit2(m_Queue.queue, 1, &submitInfo, VK_NULL_HANDLE), "Failed to submit to {} queue with index {}", GetQueueName(), m_Queue.queueIndex);
+		PVK_CHECK(vkQueueSubmit2(m_Queue.queue, count, m_SubmitInfos.data(), VK_NULL_HANDLE), "Failed to submit to {} queue with index {}", GetQueueName(), m_Queue.queueIndex);
 	}
 
 	void PVKCommandQueue::Wait()
 	{
+		std::lock_guard<std::mutex> lock(*m_Queue.pMutex);
 		PVK_CHECK(vkQueueWaitIdle(m_Queue.queue), "Failed to wait for {} queue with index {}", GetQueueName(), m_Queue.queueIndex);
 	}
 
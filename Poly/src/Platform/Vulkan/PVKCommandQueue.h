@@ -5,6 +5,9 @@
 #include "Poly/Rendering/Core/API/GraphicsTypes.h"
 #include "PVKTypes.h"
 
+#include <mutex>
+#include <vector>
+
 namespace Poly
 {
 	class BinarySemaphore;
@@ -23,6 +26,8 @@ namespace Poly
 
 		virtual void Submit(const SubmitDesc& submitDesc) override final;
 
+		virtual void SubmitBatch(const SubmitDesc* pSubmitDescs, uint32 count) override final;
+
 		virtual void Wait() override final;
 
 		virtual uint64 GetNative() const override final { return reinterpret_cast<uint64>(m_Queue.queue); }
@@ -35,5 +40,11 @@ namespace Poly
 
 		PVKQueue   m_Queue;
 		FQueueType m_QueueType = FQueueType::NONE;
+
+		// Scratch arrays reused by every SubmitBatch() so steady-state submits don't allocate - guarded by the
+		// queue's mutex (m_Queue.pMutex), which also synchronizes the VkQueue with other users of it
+		std::vector<VkCommandBufferSubmitInfo> m_CommandBufferInfos;
+		std::vector<VkSemaphoreSubmitInfo>     m_SemaphoreInfos;
+		std::vector<VkSubmitInfo2>             m_SubmitInfos;
 	};
 } // namespace Poly
\ No newline at end of file
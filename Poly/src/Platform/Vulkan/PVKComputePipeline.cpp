@@ -0,0 +1,36 @@
+#include "PVKComputePipeline.h"
+
+#include "polypch.h"
+#include "PVKInstance.h"
+#include "PVKPipelineLayout.h"
+#include "PVKShader.h"
+#include "VulkanCommon.h"
+
+namespace Poly
+{
+	PVKComputePipeline::~PVKComputePipeline()
+	{
+		vkDestroyPipeline(PVKInstance::GetDevice(), m_Pipeline, nullptr);
+	}
+
+	void PVKComputePipeline::Init(const ComputePipelineDesc* pDesc)
+	{
+		POLY_VALIDATE(pDesc->pComputeShader, "A compute shader must be bound to a compute pipeline!");
+
+		p_PipelineDesc    = *pDesc;
+		p_PipelineType    = EPipelineType::COMPUTE;
+		m_pPipelineLayout = reinterpret_cast<PVKPipelineLayout*>(pDesc->pPipelineLayout);
+
+		PVKShader* pComputeShader = reinterpret_cast<PVKShader*>(pDesc->pComputeShader);
+		POLY_VALIDATE(pComputeShader->GetShaderStage() == FShaderStage::COMPUTE, "Shader type of Compute does not match!");
+
+		VkComputePipelineCreateInfo pipelineInfo = {};
+		pipelineInfo.sType                       = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		pipelineInfo.stage                       = pComputeShader->GetPipelineInfo();
+		pipelineInfo.layout                      = m_pPipelineLayout->GetNativeVK();
+		pipelineInfo.basePipelineHandle          = VK_NULL_HANDLE;
+		pipelineInfo.basePipelineIndex           = -1;
+
+		PVK_CHECK(vkCreateComputePipelines(PVKInstance::GetDevice(), PVKInstance::GetPipelineCache(), 1, &pipelineInfo, nullptr, &m_Pipeline), "Failed to create compute pipeline!");
+	}
+} // namespace Poly
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Platform/API/ComputePipeline.h"
+#include "PVKTypes.h"
+
+namespace Poly
+{
+	class PVKPipelineLayout;
+
+	class PVKComputePipeline : public ComputePipeline
+	{
+	public:
+		PVKComputePipeline() = default;
+		~PVKComputePipeline();
+
+		virtual void Init(const ComputePipelineDesc* pDesc) override final;
+
+		VkPipeline              GetNativeVK() const { return m_Pipeline; }
+		virtual uint64          GetNative() const override final { return reinterpret_cast<uint64>(m_Pipeline); }
+		virtual PipelineLayout* GetPipelineLayout() const override final { return reinterpret_cast<PipelineLayout*>(m_pPipelineLayout); }
+
+	private:
+		VkPipeline         m_Pipeline        = VK_NULL_HANDLE;
+		PVKPipelineLayout* m_pPipelineLayout = nullptr;
+	};
+
+} // namespace Poly
@@ -7,8 +7,6 @@
 #include "PVKShader.h"
 #include "VulkanCommon.h"
 
-// TODO: Make the pipeline support both compute and graphcis pipelines
-
 namespace Poly
 {
 
@@ -236,6 +234,6 @@ namespace Poly
 		pipelineInfo.basePipelineHandle           = VK_NULL_HANDLE; // Optional
 		pipelineInfo.basePipelineIndex            = -1;             // Optional
 
-		PVK_CHECK(vkCreateGraphicsPipelines(PVKInstance::GetDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_Pipeline), "Failed to create graphics pipeline!");
+		PVK_CHECK(vkCreateGraphicsPipelines(PVKInstance::GetDevice(), PVKInstance::GetPipelineCache(), 1, &pipelineInfo, nullptr, &m_Pipeline), "Failed to create graphics pipeline!");
 	}
 } // namespace Poly
\ No newline at end of file
@@ -9,9 +9,11 @@
 #include "PVKBuffer.h"
 #include "PVKCommandPool.h"
 #include "PVKCommandQueue.h"
+#include "PVKComputePipeline.h"
 #include "PVKDescriptorSet.h"
 #include "PVKFramebuffer.h"
 #include "PVKGraphicsPipeline.h"
+#include "PVKMemoryBlock.h"
 #include "PVKPipelineLayout.h"
 #include "PVKRenderPass.h"
 #include "PVKSampler.h"
@@ -20,6 +22,7 @@
 #include "PVKSyncPoint.h"
 #include "PVKTexture.h"
 #include "PVKTextureView.h"
+#include "Poly/Resources/VFS/VirtualFileSystem.h"
 
 #include <vulkan/vulkan_beta.h>
 
@@ -52,6 +55,60 @@ namespace
 		}
 		return VK_FORMAT_UNDEFINED;
 	}
+
+	constexpr const char* PIPELINE_CACHE_PATH = "cache/pipeline_cache.bin";
+
+	// Prefixed to the driver's blob on disk. The driver's own header only covers vendor/device ID and the
+	// pipelineCacheUUID, and not every driver rejects a stale blob gracefully - so the device UUID, driver
+	// version and a checksum are checked here before anything is handed to vkCreatePipelineCache.
+	struct PipelineCacheFileHeader
+	{
+		static constexpr uint32 MAGIC   = 0x43504C50; // "PLPC"
+		static constexpr uint32 VERSION = 1;
+
+		uint32  Magic;
+		uint32  Version;
+		uint32  VendorID;
+		uint32  DeviceID;
+		uint32  DriverVersion;
+		uint8_t DeviceUUID[VK_UUID_SIZE];
+		uint8_t PipelineCacheUUID[VK_UUID_SIZE];
+		uint64  DataSize;
+		uint64  DataHash;
+	};
+
+	uint64 HashPipelineCacheData(const byte* pData, size_t size)
+	{
+		// FNV-1a, only used to catch truncated or corrupted files
+		uint64 hash = 14695981039346656037ull;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= static_cast<uint64>(pData[i]);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	PipelineCacheFileHeader GetPipelineCacheFileHeader(VkPhysicalDevice physicalDevice)
+	{
+		VkPhysicalDeviceIDProperties idProperties = {};
+		idProperties.sType                        = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+
+		VkPhysicalDeviceProperties2 properties = {};
+		properties.sType                       = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		properties.pNext                       = &idProperties;
+		vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+
+		PipelineCacheFileHeader header = {};
+		header.Magic                   = PipelineCacheFileHeader::MAGIC;
+		header.Version                 = PipelineCacheFileHeader::VERSION;
+		header.VendorID                = properties.properties.vendorID;
+		header.DeviceID                = properties.properties.deviceID;
+		header.DriverVersion           = properties.properties.driverVersion;
+		std::memcpy(header.DeviceUUID, idProperties.deviceUUID, VK_UUID_SIZE);
+		std::memcpy(header.PipelineCacheUUID, properties.properties.pipelineCacheUUID, VK_UUID_SIZE);
+		return header;
+	}
 } // namespace
 
 namespace Poly
@@ -64,6 +121,10 @@ namespace Poly
 	{
 		vkDeviceWaitIdle(s_Device);
 
+		SavePipelineCache();
+		vkDestroyPipelineCache(s_Device, s_PipelineCache, nullptr);
+		s_PipelineCache = VK_NULL_HANDLE;
+
 		if (m_EnableValidationLayers)
 			DestroyDebugUtilsMessengerEXT(s_Instance, m_DebugMessenger, nullptr);
 
@@ -88,10 +149,38 @@ namespace Poly
 		CreateLogicalDevice();
 
 		CreateVmaAllocator();
+		CreatePipelineCache();
 
 		s_PVKInstance = this;
 	}
 
+	void PVKInstance::SavePipelineCache()
+	{
+		if (s_PipelineCache == VK_NULL_HANDLE)
+			return;
+
+		size_t dataSize = 0;
+		if (vkGetPipelineCacheData(s_Device, s_PipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0)
+			return;
+
+		std::vector<byte> file(sizeof(PipelineCacheFileHeader) + dataSize);
+		byte*             pData = file.data() + sizeof(PipelineCacheFileHeader);
+		if (vkGetPipelineCacheData(s_Device, s_PipelineCache, &dataSize, pData) != VK_SUCCESS)
+		{
+			POLY_CORE_WARN("Failed to read back pipeline cache data, it will not be saved");
+			return;
+		}
+		file.resize(sizeof(PipelineCacheFileHeader) + dataSize);
+
+		PipelineCacheFileHeader header = GetPipelineCacheFileHeader(s_PhysicalDevice);
+		header.DataSize                = dataSize;
+		header.DataHash                = HashPipelineCacheData(pData, dataSize);
+		std::memcpy(file.data(), &header, sizeof(header));
+
+		if (!VirtualFileSystem::Write(PIPELINE_CACHE_PATH, file))
+			POLY_CORE_WARN("Failed to write pipeline cache to {}", PIPELINE_CACHE_PATH);
+	}
+
 	/*
 	 * GraphicsInstance functions
 	 */
@@ -199,6 +288,15 @@ namespace Poly
 		return pShader;
 	}
 
+	Ref<ComputePipeline> PVKInstance::CreateComputePipeline(const ComputePipelineDesc* pDesc)
+	{
+		POLY_VALIDATE(pDesc, "ComputePipelineDesc cannot be nullptr!");
+
+		Ref<PVKComputePipeline> pPipeline = CreateRef<PVKComputePipeline>();
+		pPipeline->Init(pDesc);
+		return pPipeline;
+	}
+
 	Ref<PipelineLayout> PVKInstance::CreatePipelineLayout(const PipelineLayoutDesc* pDesc)
 	{
 		POLY_VALIDATE(pDesc, "PipelineLayoutDesc cannot be nullptr!");
@@ -257,6 +355,36 @@ namespace Poly
 		return pNewSet;
 	}
 
+	Ref<MemoryBlock> PVKInstance::CreateMemoryBlock(const MemoryBlockDesc* pDesc)
+	{
+		POLY_VALIDATE(pDesc, "MemoryBlockDesc cannot be nullptr!");
+
+		Ref<PVKMemoryBlock> pMemoryBlock = CreateRef<PVKMemoryBlock>();
+		pMemoryBlock->Init(pDesc);
+		return pMemoryBlock;
+	}
+
+	MemoryRequirements PVKInstance::GetTextureMemoryRequirements(const TextureDesc* pDesc)
+	{
+		POLY_VALIDATE(pDesc, "TextureDesc cannot be nullptr!");
+
+		const VkImageCreateInfo imageInfo = PVKTexture::GetImageCreateInfo(*pDesc);
+
+		VkDeviceImageMemoryRequirements info = {};
+		info.sType                           = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS;
+		info.pCreateInfo                     = &imageInfo;
+
+		VkMemoryRequirements2 requirements = {};
+		requirements.sType                 = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+		vkGetDeviceImageMemoryRequirements(s_Device, &info, &requirements);
+
+		MemoryRequirements result = {};
+		result.Size               = requirements.memoryRequirements.size;
+		result.Alignment          = requirements.memoryRequirements.alignment;
+		result.MemoryTypeBits     = requirements.memoryRequirements.memoryTypeBits;
+		return result;
+	}
+
 	VkFormat PVKInstance::FindDepthFormat()
 	{
 		std::vector<VkFormat> formats;
@@ -516,9 +644,15 @@ namespace Poly
 			unsigned score = 0;
 			// Query the device
 			VkPhysicalDeviceProperties deviceProperties;
-			VkPhysicalDeviceFeatures   deviceFeatures;
 			vkGetPhysicalDeviceProperties(d, &deviceProperties);
-			vkGetPhysicalDeviceFeatures(d, &deviceFeatures);
+
+			VkPhysicalDeviceVulkan12Features vulkan12Features = {};
+			vulkan12Features.sType                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+			VkPhysicalDeviceFeatures2 deviceFeatures2         = {};
+			deviceFeatures2.sType                             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			deviceFeatures2.pNext                             = &vulkan12Features;
+			vkGetPhysicalDeviceFeatures2(d, &deviceFeatures2);
+			const VkPhysicalDeviceFeatures& deviceFeatures = deviceFeatures2.features;
 
 			// Favor dGPUs
 			if (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
@@ -536,8 +670,13 @@ namespace Poly
 			const bool extensionsSupported = CheckDeviceExtensionSupport(d);
 			// POLY_VALIDATE(extensionsSupported, "Required extensions are not supported!");
 
+			// Every feature CreateLogicalDevice() enables has to be there, or device creation fails
+			const bool featuresSupported = deviceFeatures.samplerAnisotropy && deviceFeatures.shaderInt64 && deviceFeatures.multiDrawIndirect
+			                               && deviceFeatures.drawIndirectFirstInstance && deviceFeatures.textureCompressionBC
+			                               && vulkan12Features.drawIndirectCount;
+
 			// Save the device with the best score and is complete with its queues
-			if (extensionsSupported && score > bestScore && deviceFeatures.samplerAnisotropy)
+			if (extensionsSupported && featuresSupported && score > bestScore)
 			{
 				bestScore        = score;
 				s_PhysicalDevice = d;
@@ -589,9 +728,12 @@ namespace Poly
 
 		// Enable or disable features for the device
 		// TODO: Move this to an easier place for editing
-		VkPhysicalDeviceFeatures deviceFeatures = {};
-		deviceFeatures.samplerAnisotropy        = VK_TRUE;
-		deviceFeatures.shaderInt64              = VK_TRUE;
+		VkPhysicalDeviceFeatures deviceFeatures  = {};
+		deviceFeatures.samplerAnisotropy         = VK_TRUE;
+		deviceFeatures.shaderInt64               = VK_TRUE;
+		deviceFeatures.multiDrawIndirect         = VK_TRUE; // drawCount > 1 in DrawIndexedIndirectCount()
+		deviceFeatures.drawIndirectFirstInstance = VK_TRUE; // indirect commands address their own instance range
+		deviceFeatures.textureCompressionBC      = VK_TRUE; // cooked textures (see TextureCompressor)
 
 		VkPhysicalDeviceVulkan13Features vulkan13Features = {};
 		vulkan13Features.sType                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
@@ -603,6 +745,7 @@ namespace Poly
 		VkPhysicalDeviceVulkan12Features vulkan12Features             = {};
 		vulkan12Features.sType                                        = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
 		vulkan12Features.timelineSemaphore                            = VK_TRUE;
+		vulkan12Features.drawIndirectCount                            = VK_TRUE;
 		vulkan12Features.bufferDeviceAddress                          = VK_TRUE;
 		vulkan12Features.shaderSampledImageArrayNonUniformIndexing    = VK_TRUE;
 		vulkan12Features.descriptorBindingPartiallyBound              = VK_TRUE;
@@ -686,6 +829,56 @@ namespace Poly
 		vmaCreateAllocator(&createInfo, &s_VmaAllocator);
 	}
 
+	void PVKInstance::CreatePipelineCache()
+	{
+		const PipelineCacheFileHeader expected = GetPipelineCacheFileHeader(s_PhysicalDevice);
+
+		std::vector<byte> file = VirtualFileSystem::Exists(PIPELINE_CACHE_PATH) ? VirtualFileSystem::Read(PIPELINE_CACHE_PATH) : std::vector<byte>();
+		const byte*       pInitialData    = nullptr;
+		size_t            initialDataSize = 0;
+
+		if (file.size() >= sizeof(PipelineCacheFileHeader))
+		{
+			PipelineCacheFileHeader header;
+			std::memcpy(&header, file.data(), sizeof(header));
+
+			const byte*  pData    = file.data() + sizeof(PipelineCacheFileHeader);
+			const size_t dataSize = file.size() - sizeof(PipelineCacheFileHeader);
+
+			if (header.Magic != expected.Magic || header.Version != expected.Version)
+				POLY_CORE_WARN("Pipeline cache {} has an unknown format, discarding it", PIPELINE_CACHE_PATH);
+			else if (header.VendorID != expected.VendorID || header.DeviceID != expected.DeviceID
+			         || std::memcmp(header.DeviceUUID, expected.DeviceUUID, VK_UUID_SIZE) != 0)
+				POLY_CORE_INFO("Pipeline cache {} was built for a different device, discarding it", PIPELINE_CACHE_PATH);
+			else if (header.DriverVersion != expected.DriverVersion
+			         || std::memcmp(header.PipelineCacheUUID, expected.PipelineCacheUUID, VK_UUID_SIZE) != 0)
+				POLY_CORE_INFO("Pipeline cache {} was built by a different driver version, discarding it", PIPELINE_CACHE_PATH);
+			else if (header.DataSize != dataSize || header.DataHash != HashPipelineCacheData(pData, dataSize))
+				POLY_CORE_WARN("Pipeline cache {} is corrupt, discarding it", PIPELINE_CACHE_PATH);
+			else
+			{
+				pInitialData    = pData;
+				initialDataSize = dataSize;
+			}
+		}
+		else if (!file.empty())
+			POLY_CORE_WARN("Pipeline cache {} is truncated, discarding it", PIPELINE_CACHE_PATH);
+
+		VkPipelineCacheCreateInfo createInfo = {};
+		createInfo.sType                     = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		createInfo.initialDataSize           = initialDataSize;
+		createInfo.pInitialData              = pInitialData;
+
+		if (vkCreatePipelineCache(s_Device, &createInfo, nullptr, &s_PipelineCache) == VK_SUCCESS)
+			return;
+
+		// A blob that passed the checks above can still be rejected by the driver - fall back to an empty cache
+		POLY_CORE_WARN("Driver rejected pipeline cache {}, starting with an empty one", PIPELINE_CACHE_PATH);
+		createInfo.initialDataSize = 0;
+		createInfo.pInitialData    = nullptr;
+		PVK_CHECK(vkCreatePipelineCache(s_Device, &createInfo, nullptr, &s_PipelineCache), "Failed to create pipeline cache!");
+	}
+
 	std::vector<const char*> PVKInstance::GetRequiredExtensions()
 	{
 		unsigned     glfwExtensionCount = 0;
@@ -42,12 +42,16 @@ namespace Poly
 		virtual Ref<Shader>             CreateShader(const ShaderDesc* pDesc) override final;
 		virtual Ref<GraphicsRenderPass> CreateGraphicsRenderPass(const GraphicsRenderPassDesc* pDesc) override final;
 		virtual Ref<GraphicsPipeline>   CreateGraphicsPipeline(const GraphicsPipelineDesc* pDesc) override final;
+		virtual Ref<ComputePipeline>    CreateComputePipeline(const ComputePipelineDesc* pDesc) override final;
 		virtual Ref<PipelineLayout>     CreatePipelineLayout(const PipelineLayoutDesc* pDesc) override final;
 		virtual Ref<Framebuffer>        CreateFramebuffer(const FramebufferDesc* pDesc) override final;
 		virtual Ref<DescriptorSet>      CreateDescriptorSet(PipelineLayout* pLayout, uint32 setIndex) override final;
 
 		virtual Ref<DescriptorSet> CreateDescriptorSetCopy(const Ref<DescriptorSet>& pSrcDescriptorSet) override final;
 
+		virtual Ref<MemoryBlock>   CreateMemoryBlock(const MemoryBlockDesc* pDesc) override final;
+		virtual MemoryRequirements GetTextureMemoryRequirements(const TextureDesc* pDesc) override final;
+
 		static VkFormat FindDepthFormat();
 		static void     SetDebugName(VkObjectType objectType, uint64_t handle, const std::string& name);
 
@@ -57,6 +61,13 @@ namespace Poly
 		static PVKQueue&                    GetQueue(FQueueType queueType, uint32_t index = 0);
 		static const std::vector<PVKQueue>& GetAllQueues();
 		static VmaAllocator                 GetAllocator() { return s_VmaAllocator; }
+		static VkPipelineCache              GetPipelineCache() { return s_PipelineCache; }
+
+		/**
+		 * Writes the pipeline cache to disk (cache/pipeline_cache.bin). Called on shutdown, can also be
+		 * called after a batch of pipelines has been compiled so a crash doesn't lose them.
+		 */
+		static void SavePipelineCache();
 
 	private:
 		inline static PVKInstance* s_PVKInstance = nullptr;
@@ -94,6 +105,7 @@ namespace Poly
 		void                     AddRequiredDeviceExtensions();
 		void                     CreateLogicalDevice();
 		void                     CreateVmaAllocator();
+		void                     CreatePipelineCache();
 		std::vector<const char*> GetRequiredExtensions();
 		void                     PopulateQueues(const std::vector<QueueSpec>& queueSpecs);
 
@@ -105,6 +117,7 @@ namespace Poly
 		inline static std::unordered_map<FQueueType, std::vector<uint32_t>> s_QueueMappings;
 
 		inline static VmaAllocator                        s_VmaAllocator                  = VK_NULL_HANDLE;
+		inline static VkPipelineCache                     s_PipelineCache                 = VK_NULL_HANDLE; // shared by every pipeline created on s_Device
 		inline static PFN_vkSetDebugUtilsObjectNameEXT     s_SetDebugUtilsObjectNameEXT    = nullptr;
 
 #ifdef POLY_DEBUG
@@ -0,0 +1,29 @@
+#include "PVKMemoryBlock.h"
+
+#include "polypch.h"
+#include "PVKInstance.h"
+
+namespace Poly
+{
+	PVKMemoryBlock::~PVKMemoryBlock()
+	{
+		PVK_CLEANUP(m_Allocation, vmaFreeMemory(PVKInstance::GetAllocator(), m_Allocation));
+	}
+
+	void PVKMemoryBlock::Init(const MemoryBlockDesc* pDesc)
+	{
+		p_MemoryBlockDesc = *pDesc;
+
+		VkMemoryRequirements memoryRequirements = {};
+		memoryRequirements.size                 = pDesc->Requirements.Size;
+		memoryRequirements.alignment            = pDesc->Requirements.Alignment;
+		memoryRequirements.memoryTypeBits       = pDesc->Requirements.MemoryTypeBits;
+
+		VmaAllocationCreateInfo allocInfo = {};
+		allocInfo.usage                   = ConvertMemoryUsageVMA(pDesc->MemoryUsage);
+
+		PVK_CHECK(vmaAllocateMemory(PVKInstance::GetAllocator(), &memoryRequirements, &allocInfo, &m_Allocation, nullptr), "Failed to allocate memory block using VMA!");
+		if (!pDesc->DebugName.empty())
+			vmaSetAllocationName(PVKInstance::GetAllocator(), m_Allocation, pDesc->DebugName.c_str());
+	}
+} // namespace Poly
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Platform/API/MemoryBlock.h"
+#include "PVKTypes.h"
+#include "VmaInclude.h"
+
+namespace Poly
+{
+	class PVKMemoryBlock : public MemoryBlock
+	{
+	public:
+		PVKMemoryBlock() = default;
+		~PVKMemoryBlock();
+
+		virtual void Init(const MemoryBlockDesc* pDesc) override final;
+
+		virtual uint64 GetNative() const override final { return reinterpret_cast<uint64>(m_Allocation); }
+		VmaAllocation  GetAllocationVK() const { return m_Allocation; }
+
+	private:
+		VmaAllocation m_Allocation = VK_NULL_HANDLE;
+	};
+} // namespace Poly
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "Poly/Core/Core.h"
+
+#include <mutex>
 #include <vulkan/vulkan.h>
 
 namespace Poly
@@ -9,6 +12,10 @@ namespace Poly
 		VkQueue  queue            = VK_NULL_HANDLE;
 		uint32_t queueIndex       = 0;
 		uint32_t queueFamilyIndex = 0;
+
+		// Shared by everything submitting to or presenting on the VkQueue - vkQueueSubmit2, vkQueueWaitIdle and
+		// vkQueuePresentKHR all require the queue to be externally synchronized
+		Ref<std::mutex> pMutex = CreateRef<std::mutex>();
 	};
 
 } // namespace Poly
\ No newline at end of file
@@ -52,7 +52,12 @@ namespace Poly
 		presentInfo.pSwapchains        = swapChains;
 		presentInfo.pImageIndices      = &m_ImageIndex;
 		presentInfo.pResults           = nullptr; // Optional
-		const VkResult presentResult   = vkQueuePresentKHR(m_PresentQueue, &presentInfo);
+		VkResult presentResult;
+		{
+			// The present queue may be one the render graph is submitting to from other threads
+			std::lock_guard<std::mutex> lock(*m_PresentQueue.pMutex);
+			presentResult = vkQueuePresentKHR(m_PresentQueue.queue, &presentInfo);
+		}
 		if (presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR)
 			m_ResizeRequired = true; // defer the actual recreate to the next AcquireNextImage() call
 		else
@@ -72,7 +77,7 @@ namespace Poly
 		uint32_t                     presentFamily = FindQueueFamilies(PVKInstance::GetPhysicalDevice(), m_Surface).PresentFamily.value();
 
 		const auto it  = std::find_if(queues.begin(), queues.end(), [&presentFamily](const PVKQueue& queue) { return queue.queueFamilyIndex == presentFamily; });
-		m_PresentQueue = it->queue;
+		m_PresentQueue = *it;
 	}
 
 	void PVKSwapChain::CreateSurface()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Platform/API/SwapChain.h"
+#include "Platform/Vulkan/PVKQueue.h"
 #include "Platform/Vulkan/PVKTexture.h"
 #include "Platform/Vulkan/PVKTextureView.h"
 
@@ -65,7 +66,7 @@ namespace Poly
 		std::vector<Ref<PVKTexture>>     m_Textures;
 		std::vector<Ref<PVKTextureView>> m_TextureViews;
 		bool                             m_ResizeRequired = false;
-		VkQueue                          m_PresentQueue   = VK_NULL_HANDLE;
+		PVKQueue                         m_PresentQueue   = {};
 
 		// Sync
 		std::vector<Unique<PVKBinarySemaphore>> m_RenderSemaphores;
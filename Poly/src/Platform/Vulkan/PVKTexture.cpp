@@ -2,13 +2,22 @@
 
 #include "polypch.h"
 #include "PVKInstance.h"
+#include "PVKMemoryBlock.h"
 
 namespace Poly
 {
 	PVKTexture::~PVKTexture()
 	{
-		if (m_HandleImage)
-			PVK_CLEANUP(m_Image, vmaDestroyImage(PVKInstance::GetAllocator(), m_Image, m_Allocation));
+		if (!m_HandleImage)
+			return;
+
+		if (p_TextureDesc.pMemoryBlock)
+		{
+			PVK_CLEANUP(m_Image, vkDestroyImage(PVKInstance::GetDevice(), m_Image, nullptr));
+			return;
+		}
+
+		PVK_CLEANUP(m_Image, vmaDestroyImage(PVKInstance::GetAllocator(), m_Image, m_Allocation));
 	}
 
 	void PVKTexture::Init(const TextureDesc* pDesc)
@@ -27,34 +36,48 @@ namespace Poly
 		m_Image       = image;
 	}
 
-	void PVKTexture::CreateImage()
+	VkImageCreateInfo PVKTexture::GetImageCreateInfo(const TextureDesc& desc)
 	{
-		VkSampleCountFlagBits sampleCount = ConvertSampleCountVK(p_TextureDesc.SampleCount);
-
-		VkFormat vkFormat = ConvertFormatVK(p_TextureDesc.Format);
-		if (p_TextureDesc.Format == EFormat::DEPTH_STENCIL)
+		VkFormat vkFormat = ConvertFormatVK(desc.Format);
+		if (desc.Format == EFormat::DEPTH_STENCIL)
 		{
 			vkFormat = PVKInstance::FindDepthFormat();
 		}
 
 		VkImageCreateInfo imageInfo = {};
 		imageInfo.sType             = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-		imageInfo.imageType         = ConvertTextureDimVK(p_TextureDesc.TextureDim);
-		imageInfo.extent.width      = p_TextureDesc.Width;
-		imageInfo.extent.height     = p_TextureDesc.Height;
-		imageInfo.extent.depth      = p_TextureDesc.Depth;
-		imageInfo.mipLevels         = p_TextureDesc.MipLevels;
-		imageInfo.arrayLayers       = p_TextureDesc.ArrayLayers;
+		imageInfo.imageType         = ConvertTextureDimVK(desc.TextureDim);
+		imageInfo.extent.width      = desc.Width;
+		imageInfo.extent.height     = desc.Height;
+		imageInfo.extent.depth      = desc.Depth;
+		imageInfo.mipLevels         = desc.MipLevels;
+		imageInfo.arrayLayers       = desc.ArrayLayers;
 		imageInfo.format            = vkFormat;
 		// If you want to be able to directly access texels in the memory of the image, then you must use VK_IMAGE_TILING_LINEAR
 		imageInfo.tiling                = VK_IMAGE_TILING_OPTIMAL;
 		imageInfo.initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED;
-		imageInfo.usage                 = ConvertTextureUsageVK(p_TextureDesc.TextureUsage);
-		imageInfo.samples               = sampleCount;
+		imageInfo.usage                 = ConvertTextureUsageVK(desc.TextureUsage);
+		imageInfo.samples               = ConvertSampleCountVK(desc.SampleCount);
 		imageInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE; // At the moment only one queue ownership is allowed
 		imageInfo.queueFamilyIndexCount = 1;
 		imageInfo.pQueueFamilyIndices   = nullptr;
 		imageInfo.flags                 = 0;
+		return imageInfo;
+	}
+
+	void PVKTexture::CreateImage()
+	{
+		const VkImageCreateInfo imageInfo = GetImageCreateInfo(p_TextureDesc);
+
+		if (p_TextureDesc.pMemoryBlock)
+		{
+			// Placed - the image only binds to (part of) a block someone else allocated, possibly aliasing other images
+			PVK_CHECK(vkCreateImage(PVKInstance::GetDevice(), &imageInfo, nullptr, &m_Image), "Failed to create placed image!");
+
+			const VmaAllocation allocation = static_cast<PVKMemoryBlock*>(p_TextureDesc.pMemoryBlock.get())->GetAllocationVK();
+			PVK_CHECK(vmaBindImageMemory2(PVKInstance::GetAllocator(), allocation, p_TextureDesc.MemoryOffset, m_Image, nullptr), "Failed to bind image to memory block!");
+			return;
+		}
 
 		VmaAllocationCreateInfo allocInfo = {};
 		allocInfo.usage                   = ConvertMemoryUsageVMA(p_TextureDesc.MemoryUsage);
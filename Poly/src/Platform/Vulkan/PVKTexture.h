@@ -29,11 +29,16 @@ namespace Poly
 		VkImage        GetNativeVK() const { return m_Image; }
 		virtual uint64 GetNative() const override final { return reinterpret_cast<uint64>(m_Image); }
 
+		/**
+		 * @return The VkImageCreateInfo Init() creates the image with - also used to query memory requirements up front
+		 */
+		static VkImageCreateInfo GetImageCreateInfo(const TextureDesc& desc);
+
 	private:
 		void CreateImage();
 
 		VkImage       m_Image       = VK_NULL_HANDLE;
-		VmaAllocation m_Allocation  = VK_NULL_HANDLE;
+		VmaAllocation m_Allocation  = VK_NULL_HANDLE; // null when placed in TextureDesc::pMemoryBlock
 		bool          m_HandleImage = false;
 	};
 } // namespace Poly
\ No newline at end of file
@@ -131,6 +131,12 @@ namespace Poly
 			return VK_FORMAT_R32G32B32_SFLOAT;
 		case EFormat::R32G32B32A32_SFLOAT:
 			return VK_FORMAT_R32G32B32A32_SFLOAT;
+		case EFormat::BC4_UNORM:
+			return VK_FORMAT_BC4_UNORM_BLOCK;
+		case EFormat::BC5_UNORM:
+			return VK_FORMAT_BC5_UNORM_BLOCK;
+		case EFormat::BC7_UNORM:
+			return VK_FORMAT_BC7_UNORM_BLOCK;
 		default:
 			return VK_FORMAT_UNDEFINED;
 		}
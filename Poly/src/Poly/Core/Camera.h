@@ -41,6 +41,7 @@ namespace Poly
 
 		glm::mat4 GetMatrix();
 		glm::vec4 GetPosition() { return glm::vec4(m_Pos, 1.0); }
+		const glm::mat4& GetProjection() const { return m_Proj; }
 
 	private:
 		void UpdateView();
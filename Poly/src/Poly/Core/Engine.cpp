@@ -32,6 +32,7 @@ namespace Poly
 
 		ThreadPool::Init();
 		VirtualFileSystem::Mount("assets/", CreateUnique<FileDirectoryBackend>(POLY_ROOT_DIR "/assets"), EMountMode::ReadWrite, 0);
+		VirtualFileSystem::Mount("cache/", CreateUnique<FileDirectoryBackend>(POLY_ROOT_DIR "/cache"), EMountMode::ReadWrite, 0);
 		VirtualFileSystem::Mount("compat/", CreateUnique<FileDirectoryBackend>(POLY_ROOT_DIR), EMountMode::ReadWrite, 0); // TODO: Remove when the project.polyres file is gone from the asset importer
 
 		RenderAPI::Init(RenderAPI::BackendAPI::VULKAN);
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Core.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Poly
+{
+	class JobCounter;
+
+	/*
+	 * A single unit of work for the ThreadPool. The callable is stored inline (small-buffer storage)
+	 * so queueing a job never allocates - Jobs themselves live in fixed per-thread rings owned by the
+	 * ThreadPool and are recycled once executed. A callable bigger than STORAGE_SIZE fails to compile;
+	 * capture by pointer/reference instead, or move the data somewhere with a stable address first.
+	 */
+	struct alignas(64) Job
+	{
+		static constexpr size_t STORAGE_SIZE = 64;
+
+		template<typename Fn>
+		void Set(Fn&& fn)
+		{
+			using Functor = std::decay_t<Fn>;
+			static_assert(sizeof(Functor) <= STORAGE_SIZE, "Job callable is too large for the inline storage - capture less (or by pointer)");
+			static_assert(alignof(Functor) <= alignof(std::max_align_t), "Job callable is over-aligned for the inline storage");
+
+			new (Storage) Functor(std::forward<Fn>(fn));
+			pInvoke  = [](void* pStorage) { (*static_cast<Functor*>(pStorage))(); };
+			pDestroy = [](void* pStorage) { static_cast<Functor*>(pStorage)->~Functor(); };
+		}
+
+		// Runs the stored callable, destroys it, and hands the Job back to its owning ring
+		void Execute()
+		{
+			pInvoke(Storage);
+			pDestroy(Storage);
+			pInvoke  = nullptr;
+			pDestroy = nullptr;
+			pCounter = nullptr;
+			InUse.store(false, std::memory_order_release);
+		}
+
+		alignas(std::max_align_t) std::byte Storage[STORAGE_SIZE];
+		void (*pInvoke)(void*)  = nullptr;
+		void (*pDestroy)(void*) = nullptr;
+		JobCounter*       pCounter     = nullptr; // signalled once the job has run
+		Job*              pNextWaiting = nullptr; // next continuation held back by the same JobCounter
+		std::atomic<bool> InUse        = false;
+	};
+
+	/*
+	 * Tracks a group of in-flight jobs. Every job submitted against a counter bumps it, and it drops back
+	 * to zero once all of them have run - ThreadPool::Wait() blocks on that, and jobs queued with
+	 * ThreadPool::SubmitAfter() are held back until then. To run B after both A and C, submit A and C
+	 * against the same counter and B after it.
+	 *
+	 * A counter must outlive every job submitted against (or after) it - Wait() on it before destroying it.
+	 * It can be reused once it's done; attach continuations only after the jobs they depend on are submitted.
+	 */
+	class JobCounter
+	{
+	public:
+		JobCounter()  = default;
+		~JobCounter() = default;
+		CLASS_REMOVE_COPY(JobCounter);
+
+		/**
+		 * @return true once every job submitted against the counter has run and it's safe to reuse or destroy
+		 */
+		bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0 && m_Signalling.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class ThreadPool;
+
+		std::atomic<uint32> m_Pending    = 0;
+		std::atomic<uint32> m_Signalling = 0; // threads still releasing continuations - IsDone() holds off until they're out
+		std::mutex          m_WaitingMutex;
+		Job*                m_pWaiting = nullptr; // continuations, linked through Job::pNextWaiting
+	};
+} // namespace Poly
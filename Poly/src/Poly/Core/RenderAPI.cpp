@@ -1,6 +1,7 @@
 #include "RenderAPI.h"
 
 #include "Platform/API/CommandQueue.h"
+#include "Platform/API/MemoryBlock.h"
 #include "Platform/API/Sampler.h"
 #include "Platform/Vulkan/PVKInstance.h"
 #include "Poly/RenderGraph/ResourceManager.h"
@@ -131,6 +132,11 @@ namespace Poly
 		return m_pGraphicsInstance->CreateGraphicsPipeline(pDesc);
 	}
 
+	Ref<ComputePipeline> RenderAPI::CreateComputePipeline(const ComputePipelineDesc* pDesc)
+	{
+		return m_pGraphicsInstance->CreateComputePipeline(pDesc);
+	}
+
 	Ref<PipelineLayout> RenderAPI::CreatePipelineLayout(const PipelineLayoutDesc* pDesc)
 	{
 		return m_pGraphicsInstance->CreatePipelineLayout(pDesc);
@@ -151,6 +157,16 @@ namespace Poly
 		return m_pGraphicsInstance->CreateDescriptorSetCopy(pSrcDescriptorSet);
 	}
 
+	Ref<MemoryBlock> RenderAPI::CreateMemoryBlock(const MemoryBlockDesc* pDesc)
+	{
+		return m_pGraphicsInstance->CreateMemoryBlock(pDesc);
+	}
+
+	MemoryRequirements RenderAPI::GetTextureMemoryRequirements(const TextureDesc* pDesc)
+	{
+		return m_pGraphicsInstance->GetTextureMemoryRequirements(pDesc);
+	}
+
 	Ref<Framebuffer> RenderAPI::GetFramebuffer(const std::vector<TextureView*>& attachments, TextureView* pDepthAttachment, GraphicsRenderPass* pPass, uint32 width, uint32 height)
 	{
 		return m_FramebufferCache.GetFramebuffer(attachments, pDepthAttachment, pPass, width, height);
@@ -22,6 +22,8 @@ namespace Poly
 	struct BufferDesc;
 	struct SamplerDesc;
 	struct TextureDesc;
+	struct MemoryBlockDesc;
+	struct MemoryRequirements;
 	struct SwapChainDesc;
 	struct FramebufferDesc;
 	struct TextureViewDesc;
@@ -29,6 +31,7 @@ namespace Poly
 	struct DescriptorSetDesc;
 	struct PipelineLayoutDesc;
 	struct GraphicsPipelineDesc;
+	struct ComputePipelineDesc;
 	struct GraphicsRenderPassDesc;
 
 	class Shader;
@@ -36,6 +39,7 @@ namespace Poly
 	class Window;
 	class Sampler;
 	class Texture;
+	class MemoryBlock;
 	class SwapChain;
 	class SyncPoint;
 	class Framebuffer;
@@ -46,6 +50,7 @@ namespace Poly
 	class PipelineLayout;
 	class BinarySemaphore;
 	class GraphicsPipeline;
+	class ComputePipeline;
 	class GraphicsRenderPass;
 
 	class RenderAPI
@@ -78,12 +83,16 @@ namespace Poly
 		static Ref<Shader>             CreateShader(const ShaderDesc* pDesc);
 		static Ref<GraphicsRenderPass> CreateGraphicsRenderPass(const GraphicsRenderPassDesc* pDesc);
 		static Ref<GraphicsPipeline>   CreateGraphicsPipeline(const GraphicsPipelineDesc* pDesc);
+		static Ref<ComputePipeline>    CreateComputePipeline(const ComputePipelineDesc* pDesc);
 		static Ref<PipelineLayout>     CreatePipelineLayout(const PipelineLayoutDesc* pDesc);
 		static Ref<Framebuffer>        CreateFramebuffer(const FramebufferDesc* pDesc);
 		static Ref<DescriptorSet>      CreateDescriptorSet(PipelineLayout* pLayout, uint32 setIndex);
 
 		static Ref<DescriptorSet> CreateDescriptorSetCopy(const Ref<DescriptorSet>& pSrcDescriptorSet);
 
+		static Ref<MemoryBlock>   CreateMemoryBlock(const MemoryBlockDesc* pDesc);
+		static MemoryRequirements GetTextureMemoryRequirements(const TextureDesc* pDesc);
+
 		/**
 		 * Gets or creates a framebuffer and returns it
 		 * @param attachments - Texture view attachments to be used for the framebuffer
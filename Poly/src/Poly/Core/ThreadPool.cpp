@@ -1,6 +1,161 @@
 #include "ThreadPool.h"
 
-#include <latch>
+#include <array>
+
+namespace
+{
+	using Poly::Job;
+	using Poly::ThreadPool;
+
+	// Chase-Lev work-stealing deque ("Dynamic Circular Work-Stealing Deque", Chase & Lev 2005, using the
+	// C11 orderings from "Correct and Efficient Work-Stealing for Weak Memory Models", Le et al. 2013)
+	// over a fixed ring. Push/Pop are owner-thread only and work LIFO at the bottom (hot caches for
+	// nested submits); Steal may be called from any thread and takes the oldest job from the top.
+	class WorkStealingDeque
+	{
+	public:
+		bool Push(Job* pJob)
+		{
+			const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+			const int64_t top    = m_Top.load(std::memory_order_acquire);
+			if (bottom - top >= CAPACITY)
+				return false;
+
+			m_Jobs[bottom & MASK].store(pJob, std::memory_order_relaxed);
+			m_Bottom.store(bottom + 1, std::memory_order_release);
+			return true;
+		}
+
+		Job* Pop()
+		{
+			const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+			m_Bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = m_Top.load(std::memory_order_relaxed);
+
+			if (top > bottom) // empty
+			{
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			Job* pJob = m_Jobs[bottom & MASK].load(std::memory_order_relaxed);
+			if (top == bottom) // last job - race any thieves for it
+			{
+				if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					pJob = nullptr;
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+			return pJob;
+		}
+
+		Job* Steal()
+		{
+			while (true)
+			{
+				int64_t top = m_Top.load(std::memory_order_acquire);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				const int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+				if (top >= bottom)
+					return nullptr;
+
+				Job* pJob = m_Jobs[top & MASK].load(std::memory_order_relaxed);
+				if (m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					return pJob;
+				// Lost the race to another thief (or the owner) - the deque may still have more, retry
+			}
+		}
+
+	private:
+		static constexpr int64_t CAPACITY = ThreadPool::JOBS_PER_THREAD;
+		static constexpr int64_t MASK     = CAPACITY - 1;
+		static_assert((CAPACITY & MASK) == 0, "ThreadPool::JOBS_PER_THREAD must be a power of two");
+
+		alignas(64) std::atomic<int64_t> m_Top    = 0;
+		alignas(64) std::atomic<int64_t> m_Bottom = 0;
+		std::array<std::atomic<Job*>, CAPACITY> m_Jobs = {};
+	};
+
+	// Per-thread state - the deque other threads steal from, and the ring that thread's jobs are allocated from
+	struct ThreadContext
+	{
+		WorkStealingDeque                            Deque;
+		std::array<Job, ThreadPool::JOBS_PER_THREAD> Jobs;
+		uint32                                       NextJob    = 0;
+		uint32                                       RandomSeed = 0;
+	};
+
+	std::array<std::atomic<ThreadContext*>, ThreadPool::MAX_THREADS> s_Contexts = {};
+	std::atomic<uint32>                                               s_ContextCount = 0;
+	std::atomic<uint32>                                               s_Generation   = 0; // bumped on Release so stale thread_locals re-register
+	std::atomic<bool>                                                 s_Running      = false;
+	std::atomic<uint32>                                               s_WorkSignal   = 0; // bumped on every push, sleeping workers wait on it
+
+	thread_local ThreadContext* s_pThreadContext   = nullptr;
+	thread_local uint32         s_ThreadGeneration = 0;
+
+	ThreadContext* RegisterThread()
+	{
+		const uint32 index = s_ContextCount.fetch_add(1, std::memory_order_acq_rel);
+		if (index >= ThreadPool::MAX_THREADS)
+		{
+			POLY_CORE_WARN("ThreadPool: more than {} threads have submitted work, running this thread's jobs inline", ThreadPool::MAX_THREADS);
+			return nullptr;
+		}
+
+		ThreadContext* pContext = new ThreadContext();
+		pContext->RandomSeed    = index * 2654435761u + 1;
+		s_Contexts[index].store(pContext, std::memory_order_release);
+
+		s_pThreadContext   = pContext;
+		s_ThreadGeneration = s_Generation.load(std::memory_order_relaxed);
+		return pContext;
+	}
+
+	ThreadContext* GetThreadContext()
+	{
+		if (!s_Running.load(std::memory_order_acquire))
+			return nullptr;
+
+		if (s_pThreadContext && s_ThreadGeneration == s_Generation.load(std::memory_order_relaxed))
+			return s_pThreadContext;
+
+		return RegisterThread();
+	}
+
+	uint32 NextRandom(uint32& seed)
+	{
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		return seed;
+	}
+
+	// Own deque first (newest job, still warm in cache), then steal from everyone else starting at a
+	// random victim so idle threads don't all hammer the same deque.
+	Job* FindJob(ThreadContext* pContext)
+	{
+		if (Job* pJob = pContext->Deque.Pop())
+			return pJob;
+
+		const uint32 count = std::min(s_ContextCount.load(std::memory_order_acquire), ThreadPool::MAX_THREADS);
+		if (count == 0)
+			return nullptr;
+
+		const uint32 start = NextRandom(pContext->RandomSeed) % count;
+		for (uint32 i = 0; i < count; i++)
+		{
+			ThreadContext* pVictim = s_Contexts[(start + i) % count].load(std::memory_order_acquire);
+			if (!pVictim || pVictim == pContext)
+				continue;
+
+			if (Job* pJob = pVictim->Deque.Steal())
+				return pJob;
+		}
+
+		return nullptr;
+	}
+} // namespace
 
 namespace Poly
 {
@@ -11,6 +166,10 @@ namespace Poly
 			uint32 hardwareCount = std::thread::hardware_concurrency();
 			workerCount          = hardwareCount > 1 ? hardwareCount - 1 : 1;
 		}
+		workerCount = std::min(workerCount, MAX_THREADS - 1); // leave room for at least the calling thread
+
+		s_Running.store(true, std::memory_order_release);
+		GetThreadContext(); // calling (main) thread gets the first slot
 
 		m_Workers.reserve(workerCount);
 		for (uint32 i = 0; i < workerCount; i++)
@@ -22,56 +181,156 @@ namespace Poly
 		for (auto& worker : m_Workers)
 			worker.request_stop();
 
-		m_Workers.clear(); // jthread destructor joins automatically
+		s_WorkSignal.fetch_add(1, std::memory_order_release);
+		s_WorkSignal.notify_all();
+
+		m_Workers.clear(); // jthread destructor joins automatically - workers only exit once every deque is empty
+
+		s_Running.store(false, std::memory_order_release);
+		s_Generation.fetch_add(1, std::memory_order_relaxed);
+
+		const uint32 count = std::min(s_ContextCount.exchange(0, std::memory_order_acq_rel), MAX_THREADS);
+		for (uint32 i = 0; i < count; i++)
+			delete s_Contexts[i].exchange(nullptr, std::memory_order_acq_rel);
 	}
 
-	void ThreadPool::Submit(std::function<void()> task)
+	void ThreadPool::Wait(const JobCounter& counter)
 	{
+		ThreadContext* pContext = GetThreadContext();
+		while (!counter.IsDone())
 		{
-			std::lock_guard<std::mutex> lock(m_QueueMutex);
-			m_TaskQueue.push_back(std::move(task));
+			if (pContext)
+			{
+				if (Job* pJob = FindJob(pContext))
+				{
+					RunJob(pJob);
+					continue;
+				}
+			}
+
+			std::this_thread::yield();
 		}
-		m_QueueCV.notify_one();
 	}
 
-	void ThreadPool::SubmitAndWait(std::vector<std::function<void()>> tasks)
+	void ThreadPool::SubmitAndWait(const std::vector<std::function<void()>>& tasks)
 	{
-		if (tasks.empty())
+		JobCounter counter;
+		for (const auto& task : tasks)
+			Submit([pTask = &task]() { (*pTask)(); }, &counter);
+
+		Wait(counter);
+	}
+
+	Job* ThreadPool::AllocateJob()
+	{
+		ThreadContext* pContext = GetThreadContext();
+		if (!pContext)
+			return nullptr;
+
+		while (true)
+		{
+			Job& job = pContext->Jobs[pContext->NextJob++ & (JOBS_PER_THREAD - 1)];
+			if (!job.InUse.load(std::memory_order_acquire))
+			{
+				job.InUse.store(true, std::memory_order_relaxed);
+				return &job;
+			}
+
+			// The ring wrapped around onto jobs that are still queued or running - help drain them
+			// instead of growing anything.
+			if (Job* pOther = FindJob(pContext))
+				RunJob(pOther);
+			else
+				std::this_thread::yield();
+		}
+	}
+
+	void ThreadPool::PushJob(Job* pJob)
+	{
+		ThreadContext* pContext = GetThreadContext();
+		if (!pContext || !pContext->Deque.Push(pJob))
+		{
+			RunJob(pJob);
 			return;
+		}
+
+		s_WorkSignal.fetch_add(1, std::memory_order_release);
+		s_WorkSignal.notify_one();
+	}
+
+	void ThreadPool::RunJob(Job* pJob)
+	{
+		JobCounter* pCounter = pJob->pCounter; // read before Execute() hands the Job back to its ring
+		pJob->Execute();
+
+		if (pCounter)
+			SignalCounter(*pCounter);
+	}
+
+	void ThreadPool::SignalCounter(JobCounter& counter)
+	{
+		counter.m_Signalling.fetch_add(1, std::memory_order_acq_rel);
+		if (counter.m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			Job* pWaiting = nullptr;
+			{
+				std::lock_guard<std::mutex> lock(counter.m_WaitingMutex);
+				if (counter.m_Pending.load(std::memory_order_acquire) == 0) // More work may have been submitted against it since
+					pWaiting = std::exchange(counter.m_pWaiting, nullptr);
+			}
 
-		std::latch remaining(tasks.size());
+			while (pWaiting)
+			{
+				Job* pNext             = pWaiting->pNextWaiting;
+				pWaiting->pNextWaiting = nullptr;
+				PushJob(pWaiting);
+				pWaiting = pNext;
+			}
+		}
+		counter.m_Signalling.fetch_sub(1, std::memory_order_release);
+	}
 
+	void ThreadPool::AddContinuation(JobCounter& dependency, Job* pJob)
+	{
 		{
-			std::lock_guard<std::mutex> lock(m_QueueMutex);
-			for (auto& task : tasks)
+			std::lock_guard<std::mutex> lock(dependency.m_WaitingMutex);
+			if (dependency.m_Pending.load(std::memory_order_acquire) != 0)
 			{
-				m_TaskQueue.push_back([task = std::move(task), &remaining]() {
-					task();
-					remaining.count_down();
-				});
+				pJob->pNextWaiting    = dependency.m_pWaiting;
+				dependency.m_pWaiting = pJob;
+				return;
 			}
 		}
-		m_QueueCV.notify_all();
 
-		remaining.wait();
+		PushJob(pJob);
 	}
 
 	void ThreadPool::WorkerLoop(std::stop_token stopToken)
 	{
+		ThreadContext* pContext = GetThreadContext();
+		if (!pContext)
+			return;
+
 		while (true)
 		{
-			std::function<void()> task;
+			if (Job* pJob = FindJob(pContext))
 			{
-				std::unique_lock<std::mutex> lock(m_QueueMutex);
-
-				const bool hasWork = m_QueueCV.wait(lock, stopToken, [] { return !m_TaskQueue.empty(); });
-				if (!hasWork) // Stop requested and the queue has been fully drained
-					return;
+				RunJob(pJob);
+				continue;
+			}
 
-				task = std::move(m_TaskQueue.front());
-				m_TaskQueue.pop_front();
+			// Read the signal before the final look so a push landing in between is never slept through
+			const uint32 signal = s_WorkSignal.load(std::memory_order_acquire);
+			if (Job* pJob = FindJob(pContext))
+			{
+				RunJob(pJob);
+				continue;
 			}
-			task();
+
+			if (stopToken.stop_requested()) // Stop requested and every deque has been fully drained
+				return;
+
+			s_WorkSignal.wait(signal, std::memory_order_acquire);
 		}
 	}
 } // namespace Poly
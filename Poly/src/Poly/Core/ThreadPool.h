@@ -1,9 +1,10 @@
 #pragma once
 
 #include "Core.h"
+#include "Job.h"
 
-#include <condition_variable>
-#include <deque>
+#include <atomic>
+#include <algorithm>
 #include <functional>
 #include <stop_token>
 #include <thread>
@@ -11,11 +12,24 @@
 
 namespace Poly
 {
+	/*
+	 * Work-stealing job system. Every thread that touches the pool (workers, the main thread, and any
+	 * other thread that submits) gets its own lock-free deque and its own ring of Jobs: submitting
+	 * pushes onto the calling thread's deque, and idle threads steal from the other end of everyone
+	 * else's. Nothing is shared between submitters, so there's no single lock for them to convoy on.
+	 *
+	 * Dependencies are expressed with JobCounters rather than fork/join barriers: submit jobs against a
+	 * counter, then either Wait() on it or queue follow-up work with SubmitAfter() so independent phases
+	 * (e.g. building scene data and recording passes) can overlap.
+	 */
 	class ThreadPool
 	{
 	public:
 		CLASS_STATIC(ThreadPool);
 
+		static constexpr uint32 MAX_THREADS     = 64;   // workers + main thread + any other submitting thread
+		static constexpr uint32 JOBS_PER_THREAD = 2048; // size of each thread's job ring/deque - must be a power of two
+
 		/**
 		 * Spawns the worker threads
 		 * @param workerCount - Number of worker threads to spawn, 0 = auto (hardware_concurrency() - 1, clamped to >= 1)
@@ -28,16 +42,101 @@ namespace Poly
 		static void Release();
 
 		/**
-		 * Queues a task to run on a worker thread - fire and forget
-		 * @param task - Task to run, must be self-contained (capture by value / own its data)
+		 * Queues a task to run on a worker thread. Runs the task inline if the pool isn't running.
+		 * @param task - Task to run, must be self-contained (capture by value / own its data) and fit in Job::STORAGE_SIZE
+		 * @param pCounter - Optional counter to signal once the task has run, nullptr = fire and forget
+		 */
+		template<typename Fn>
+		static void Submit(Fn&& task, JobCounter* pCounter = nullptr)
+		{
+			if (pCounter)
+				pCounter->m_Pending.fetch_add(1, std::memory_order_acq_rel);
+
+			SubmitCounted(std::forward<Fn>(task), pCounter);
+		}
+
+		/**
+		 * Queues a task that only becomes runnable once every job submitted against dependency has run.
+		 * Nothing blocks in the meantime - the job is parked on the counter and pushed by whichever thread finishes its last job.
+		 * @param dependency - Counter to wait for, runs right away if it's already done
+		 * @param task - Task to run, same constraints as Submit()
+		 * @param pCounter - Optional counter to signal once the task has run, so further work can chain off it
+		 */
+		template<typename Fn>
+		static void SubmitAfter(JobCounter& dependency, Fn&& task, JobCounter* pCounter = nullptr)
+		{
+			if (pCounter)
+				pCounter->m_Pending.fetch_add(1, std::memory_order_acq_rel);
+
+			Job* pJob = AllocateJob();
+			if (!pJob)
+			{
+				Wait(dependency);
+				task();
+				if (pCounter)
+					SignalCounter(*pCounter);
+				return;
+			}
+
+			pJob->Set(std::forward<Fn>(task));
+			pJob->pCounter = pCounter;
+			AddContinuation(dependency, pJob);
+		}
+
+		/**
+		 * Splits [0, count) into chunks of grainSize indices and queues one job per chunk, without waiting.
+		 * @param count - Number of indices
+		 * @param grainSize - Indices per job - big enough that a chunk outweighs the cost of queueing it
+		 * @param fn - Called as fn(index), copied into every chunk so it must fit in Job::STORAGE_SIZE alongside two uint32s
+		 * @param counter - Signalled once per chunk, done when the whole range has run
 		 */
-		static void Submit(std::function<void()> task);
+		template<typename Fn>
+		static void ParallelFor(uint32 count, uint32 grainSize, const Fn& fn, JobCounter& counter)
+		{
+			if (count == 0)
+				return;
+
+			grainSize               = std::max(grainSize, 1u);
+			const uint32 chunkCount  = (count - 1) / grainSize + 1;
+
+			// Count every chunk up front so the counter can't drain (and release continuations) part way through
+			counter.m_Pending.fetch_add(chunkCount, std::memory_order_acq_rel);
+			for (uint32 begin = 0; begin < count; begin += std::min(grainSize, count - begin))
+			{
+				const uint32 end = begin + std::min(grainSize, count - begin);
+				SubmitCounted(
+				    [fn, begin, end]() {
+					    for (uint32 i = begin; i < end; i++)
+						    fn(i);
+				    },
+				    &counter);
+			}
+		}
+
+		/**
+		 * Blocking ParallelFor() - the calling thread runs chunks too until the whole range is done.
+		 * fn is only referenced, so it has no size limit.
+		 */
+		template<typename Fn>
+		static void ParallelFor(uint32 count, uint32 grainSize, const Fn& fn)
+		{
+			JobCounter counter;
+			ParallelFor(count, grainSize, [pFn = &fn](uint32 i) { (*pFn)(i); }, counter);
+			Wait(counter);
+		}
 
 		/**
-		 * Queues all tasks and blocks the calling thread until every one of them has completed
-		 * @param tasks - Tasks to run in parallel
+		 * Blocks until every job submitted against the counter has run. The calling thread executes queued
+		 * jobs itself while waiting instead of idling.
 		 */
-		static void SubmitAndWait(std::vector<std::function<void()>> tasks);
+		static void Wait(const JobCounter& counter);
+
+		/**
+		 * Queues all tasks and blocks until every one of them has completed. The calling thread executes
+		 * queued jobs itself while waiting instead of idling.
+		 * @param tasks - Tasks to run in parallel, must stay alive until this returns
+		 */
+		static void SubmitAndWait(const std::vector<std::function<void()>>& tasks);
 
 		/**
 		 * @return Number of worker threads
@@ -45,11 +144,31 @@ namespace Poly
 		static uint32 GetWorkerCount() { return static_cast<uint32>(m_Workers.size()); }
 
 	private:
+		// Submit() for a job whose counter has already been bumped by the caller
+		template<typename Fn>
+		static void SubmitCounted(Fn&& task, JobCounter* pCounter)
+		{
+			Job* pJob = AllocateJob();
+			if (!pJob)
+			{
+				task();
+				if (pCounter)
+					SignalCounter(*pCounter);
+				return;
+			}
+
+			pJob->Set(std::forward<Fn>(task));
+			pJob->pCounter = pCounter;
+			PushJob(pJob);
+		}
+
+		static Job* AllocateJob();
+		static void PushJob(Job* pJob);
+		static void RunJob(Job* pJob);
+		static void SignalCounter(JobCounter& counter);
+		static void AddContinuation(JobCounter& dependency, Job* pJob);
 		static void WorkerLoop(std::stop_token stopToken);
 
-		inline static std::vector<std::jthread>         m_Workers;
-		inline static std::deque<std::function<void()>> m_TaskQueue;
-		inline static std::mutex                        m_QueueMutex;
-		inline static std::condition_variable_any       m_QueueCV;
+		inline static std::vector<std::jthread> m_Workers;
 	};
 } // namespace Poly
@@ -0,0 +1,63 @@
+#include "TransformBatch.h"
+
+#include "TransformBatchSIMD.h"
+
+#if defined(POLY_TRANSFORM_BATCH_SSE2) && defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace
+{
+#if defined(POLY_TRANSFORM_BATCH_SSE2)
+	// AVX2 instructions, and the OS saving the YMM registers they use
+	bool HasAVX2()
+	{
+	#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		__cpuid(info, 1);
+		const bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+		__cpuidex(info, 7, 0);
+		return osSavesYmm && (info[1] & (1 << 5)) != 0;
+	#else
+		return __builtin_cpu_supports("avx2");
+	#endif
+	}
+#endif
+} // namespace
+
+namespace Poly
+{
+	void ComposeTransforms(const TransformStreams& streams, uint32 count, glm::mat4* pOut, size_t outStride)
+	{
+		byte*  pOutBytes = reinterpret_cast<byte*>(pOut);
+		uint32 i         = 0;
+
+#if defined(POLY_TRANSFORM_BATCH_SSE2)
+		static const bool s_HasAVX2 = HasAVX2();
+		if (s_HasAVX2)
+			i = ComposeTransformsAVX2(streams, count, pOutBytes, outStride);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 m[3][3];
+			ComposeLanes(streams, i, m);
+
+			const __m128 t[3] = {_mm_loadu_ps(streams.pTranslation[0] + i), _mm_loadu_ps(streams.pTranslation[1] + i), _mm_loadu_ps(streams.pTranslation[2] + i)};
+			StoreLanes(m, t, pOutBytes + i * outStride, outStride);
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			const glm::vec3 translation = {streams.pTranslation[0][i], streams.pTranslation[1][i], streams.pTranslation[2][i]};
+			const glm::quat orientation = glm::quat(streams.pOrientation[3][i], streams.pOrientation[0][i], streams.pOrientation[1][i], streams.pOrientation[2][i]);
+			const glm::vec3 scale       = {streams.pScale[0][i], streams.pScale[1][i], streams.pScale[2][i]};
+
+			*reinterpret_cast<glm::mat4*>(pOutBytes + i * outStride) = ComposeTransform(translation, orientation, scale);
+		}
+	}
+} // namespace Poly
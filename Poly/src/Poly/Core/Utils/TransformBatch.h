@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Poly/Core/Core.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace Poly
+{
+	/*
+	 * A batch of transforms as structure-of-arrays - one stream per component, all of the same length.
+	 * Lets ComposeTransforms() load several transforms' worth of a component into one SIMD register.
+	 */
+	struct TransformStreams
+	{
+		const float* pTranslation[3] = {}; // x, y, z
+		const float* pOrientation[4] = {}; // x, y, z, w - unit quaternion
+		const float* pScale[3]       = {}; // x, y, z
+	};
+
+	/**
+	 * Composes translate * rotate * scale in closed form - the quaternion's rotation columns scaled in place,
+	 * translation as the last column - rather than with three 4x4 multiplies
+	 * @param translation
+	 * @param orientation - unit quaternion
+	 * @param scale
+	 * @return same matrix as glm::translate(T) * glm::toMat4(R) * glm::scale(S)
+	 */
+	inline glm::mat4 ComposeTransform(const glm::vec3& translation, const glm::quat& orientation, const glm::vec3& scale)
+	{
+		const float xx = orientation.x * orientation.x;
+		const float yy = orientation.y * orientation.y;
+		const float zz = orientation.z * orientation.z;
+		const float xy = orientation.x * orientation.y;
+		const float xz = orientation.x * orientation.z;
+		const float yz = orientation.y * orientation.z;
+		const float wx = orientation.w * orientation.x;
+		const float wy = orientation.w * orientation.y;
+		const float wz = orientation.w * orientation.z;
+
+		return glm::mat4(
+		    glm::vec4((1.0f - 2.0f * (yy + zz)) * scale.x, 2.0f * (xy + wz) * scale.x, 2.0f * (xz - wy) * scale.x, 0.0f),
+		    glm::vec4(2.0f * (xy - wz) * scale.y, (1.0f - 2.0f * (xx + zz)) * scale.y, 2.0f * (yz + wx) * scale.y, 0.0f),
+		    glm::vec4(2.0f * (xz + wy) * scale.z, 2.0f * (yz - wx) * scale.z, (1.0f - 2.0f * (xx + yy)) * scale.z, 0.0f),
+		    glm::vec4(translation, 1.0f));
+	}
+
+	/**
+	 * Batch ComposeTransform() - 8 transforms per iteration with AVX2, 4 with SSE2, scalar otherwise (and for the tail).
+	 * SSE2 is part of x64, AVX2 is used if the CPU supports it (checked once, the first call).
+	 * @param streams - input components, count elements each
+	 * @param count - number of transforms
+	 * @param pOut - where to write the first matrix
+	 * @param outStride - bytes between consecutive output matrices - larger than sizeof(glm::mat4) to write straight into
+	 *                    the rows of an interleaved buffer (e.g. GPUInstanceData::Transform)
+	 */
+	void ComposeTransforms(const TransformStreams& streams, uint32 count, glm::mat4* pOut, size_t outStride = sizeof(glm::mat4));
+} // namespace Poly
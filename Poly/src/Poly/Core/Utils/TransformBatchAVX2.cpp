@@ -0,0 +1,37 @@
+#include "TransformBatchSIMD.h"
+
+#if defined(POLY_TRANSFORM_BATCH_SSE2)
+namespace Poly
+{
+	uint32 ComposeTransformsAVX2(const TransformStreams& streams, uint32 count, byte* pOut, size_t outStride)
+	{
+		uint32 i = 0;
+
+	#if defined(__AVX2__)
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 m[3][3];
+			ComposeLanes(streams, i, m);
+
+			// Two halves of four - the transpose to AoS is 128-bit either way
+			__m128 lo[3][3], hi[3][3];
+			for (int column = 0; column < 3; column++)
+			{
+				for (int row = 0; row < 3; row++)
+				{
+					lo[column][row] = _mm256_castps256_ps128(m[column][row]);
+					hi[column][row] = _mm256_extractf128_ps(m[column][row], 1);
+				}
+			}
+
+			const __m128 tLo[3] = {_mm_loadu_ps(streams.pTranslation[0] + i), _mm_loadu_ps(streams.pTranslation[1] + i), _mm_loadu_ps(streams.pTranslation[2] + i)};
+			const __m128 tHi[3] = {_mm_loadu_ps(streams.pTranslation[0] + i + 4), _mm_loadu_ps(streams.pTranslation[1] + i + 4), _mm_loadu_ps(streams.pTranslation[2] + i + 4)};
+			StoreLanes(lo, tLo, pOut + i * outStride, outStride);
+			StoreLanes(hi, tHi, pOut + (i + 4) * outStride, outStride);
+		}
+	#endif
+
+		return i;
+	}
+} // namespace Poly
+#endif
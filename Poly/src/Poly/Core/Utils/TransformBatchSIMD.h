@@ -0,0 +1,96 @@
+#pragma once
+
+#include "TransformBatch.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define POLY_TRANSFORM_BATCH_SSE2
+	#include <immintrin.h>
+#endif
+
+#if defined(POLY_TRANSFORM_BATCH_SSE2)
+namespace Poly
+{
+	/*
+	 * The 8-wide part of ComposeTransforms(), in TransformBatchAVX2.cpp - the only file built with AVX2 enabled
+	 * (see premake5.lua), so it can only be called once the CPU is known to support it
+	 * @return number of transforms composed, count rounded down to a multiple of 8 - 0 if the file was built without AVX2
+	 */
+	uint32 ComposeTransformsAVX2(const TransformStreams& streams, uint32 count, byte* pOut, size_t outStride);
+} // namespace Poly
+
+// Shared by the SSE2 and AVX2 files. Internal linkage, so the linker can't settle on the AVX2 file's copies -
+// which the compiler is free to encode with AVX - for the SSE2 path too.
+namespace
+{
+	inline __m128 Add(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+	inline __m128 Sub(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+	inline __m128 Mul(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+	inline __m128 Splat(__m128, float value) { return _mm_set1_ps(value); }
+	inline __m128 Load(const float* pData, __m128) { return _mm_loadu_ps(pData); }
+
+	#if defined(__AVX2__)
+	inline __m256 Add(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+	inline __m256 Sub(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+	inline __m256 Mul(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+	inline __m256 Splat(__m256, float value) { return _mm256_set1_ps(value); }
+	inline __m256 Load(const float* pData, __m256) { return _mm256_loadu_ps(pData); }
+	#endif
+
+	/*
+	 * The upper 3x3 (rotation * scale) of a lane's worth of transforms, same formula as Poly::ComposeTransform().
+	 * m[column][row], every element holding that entry for all lanes.
+	 */
+	template<typename V>
+	void ComposeLanes(const Poly::TransformStreams& streams, uint32 first, V (&m)[3][3])
+	{
+		const V one = Splat(V(), 1.0f);
+		const V two = Splat(V(), 2.0f);
+
+		const V qx = Load(streams.pOrientation[0] + first, V());
+		const V qy = Load(streams.pOrientation[1] + first, V());
+		const V qz = Load(streams.pOrientation[2] + first, V());
+		const V qw = Load(streams.pOrientation[3] + first, V());
+		const V sx = Load(streams.pScale[0] + first, V());
+		const V sy = Load(streams.pScale[1] + first, V());
+		const V sz = Load(streams.pScale[2] + first, V());
+
+		const V xx = Mul(qx, qx);
+		const V yy = Mul(qy, qy);
+		const V zz = Mul(qz, qz);
+		const V xy = Mul(qx, qy);
+		const V xz = Mul(qx, qz);
+		const V yz = Mul(qy, qz);
+		const V wx = Mul(qw, qx);
+		const V wy = Mul(qw, qy);
+		const V wz = Mul(qw, qz);
+
+		m[0][0] = Mul(Sub(one, Mul(two, Add(yy, zz))), sx);
+		m[0][1] = Mul(Mul(two, Add(xy, wz)), sx);
+		m[0][2] = Mul(Mul(two, Sub(xz, wy)), sx);
+		m[1][0] = Mul(Mul(two, Sub(xy, wz)), sy);
+		m[1][1] = Mul(Sub(one, Mul(two, Add(xx, zz))), sy);
+		m[1][2] = Mul(Mul(two, Add(yz, wx)), sy);
+		m[2][0] = Mul(Mul(two, Add(xz, wy)), sz);
+		m[2][1] = Mul(Mul(two, Sub(yz, wx)), sz);
+		m[2][2] = Mul(Sub(one, Mul(two, Add(xx, yy))), sz);
+	}
+
+	// Transposes 4 lanes of SoA columns into 4 column-major matrices at pOut, pOut + outStride, ...
+	inline void StoreLanes(const __m128 (&m)[3][3], const __m128 (&t)[3], byte* pOut, size_t outStride)
+	{
+		for (int column = 0; column < 4; column++)
+		{
+			__m128 r0 = column < 3 ? m[column][0] : t[0];
+			__m128 r1 = column < 3 ? m[column][1] : t[1];
+			__m128 r2 = column < 3 ? m[column][2] : t[2];
+			__m128 r3 = column < 3 ? _mm_setzero_ps() : _mm_set1_ps(1.0f);
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+			_mm_storeu_ps(reinterpret_cast<float*>(pOut + 0 * outStride) + column * 4, r0);
+			_mm_storeu_ps(reinterpret_cast<float*>(pOut + 1 * outStride) + column * 4, r1);
+			_mm_storeu_ps(reinterpret_cast<float*>(pOut + 2 * outStride) + column * 4, r2);
+			_mm_storeu_ps(reinterpret_cast<float*>(pOut + 3 * outStride) + column * 4, r3);
+		}
+	}
+} // namespace
+#endif
@@ -0,0 +1,16 @@
+#include "Mesh.h"
+
+#include "Poly/Resources/GeometryPool.h"
+
+namespace Poly
+{
+	Mesh::~Mesh()
+	{
+		GeometryPool::FreeMesh(m_Geometry);
+	}
+
+	const MeshRange& Mesh::GetMeshRange() const
+	{
+		return GeometryPool::GetMeshRange(m_Geometry);
+	}
+} // namespace Poly
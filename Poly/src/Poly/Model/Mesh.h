@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Platform/API/GraphicsPipeline.h"
+#include "Poly/Core/Handle.h"
 #include "Poly/RenderGraph/BufferRange.h"
 
 #include <glm/glm.hpp>
@@ -58,32 +59,149 @@ namespace Poly
 	// 8 bytes of padding this struct doesn't otherwise use are simply never touched by the shader.
 	static_assert(sizeof(Vertex) == 64, "Vertex must keep a 64-byte stride to match pbr_bindless.vert's Vertex layout");
 
+	/*
+	 * Compressed alternative to Vertex, stored by GeometryPool when set to EVertexFormat::PACKED and decoded by
+	 * LoadVertex() in common/bindless.glsl (PackedVertex there). Full-precision position, octahedral-encoded
+	 * normal and tangent as two snorm16s each, and a half2 texture coordinate - 24 bytes, 4-byte aligned.
+	 */
+	struct PackedVertex
+	{
+		glm::vec3 Position;
+		uint32    Normal;   // octahedral, packSnorm2x16
+		uint32    Tangent;  // octahedral, packSnorm2x16
+		uint32    TexCoord; // packHalf2x16
+
+		static PackedVertex Pack(const Vertex& vertex)
+		{
+			return {glm::vec3(vertex.Position), glm::packSnorm2x16(EncodeOctahedral(glm::vec3(vertex.Normal))),
+			        glm::packSnorm2x16(EncodeOctahedral(glm::vec3(vertex.Tangent))), glm::packHalf2x16(vertex.TexCoord)};
+		}
+
+		/*
+		 * Maps a direction onto the octahedron |x| + |y| + |z| = 1, unfolded into [-1, 1]^2 - the lower half folded
+		 * over the diagonals. A zero vector (e.g. a mesh without tangents) comes back as +Z.
+		 */
+		static glm::vec2 EncodeOctahedral(const glm::vec3& direction)
+		{
+			const float l1Norm = glm::abs(direction.x) + glm::abs(direction.y) + glm::abs(direction.z);
+			if (l1Norm == 0.0f)
+				return glm::vec2(0.0f);
+
+			const glm::vec3 octahedron = direction / l1Norm;
+			if (octahedron.z >= 0.0f)
+				return glm::vec2(octahedron);
+
+			const glm::vec2 signs = glm::vec2(octahedron.x >= 0.0f ? 1.0f : -1.0f, octahedron.y >= 0.0f ? 1.0f : -1.0f);
+			return (1.0f - glm::abs(glm::vec2(octahedron.y, octahedron.x))) * signs;
+		}
+	};
+	static_assert(sizeof(PackedVertex) == 24, "PackedVertex must keep a 24-byte stride to match common/bindless.glsl's PackedVertex layout");
+
+	/*
+	 * Object-space bounds of a mesh, computed once at import. Also the GPU layout of one entry in
+	 * GeometryPool's bounds buffer (mirrored as MeshBounds in common/bindless.glsl) - the culling pass uses the
+	 * sphere for frustum tests and LOD selection. The LOD range rides along in the box's padding, so the culling
+	 * pass finds a mesh's LODs and meshlets through the one index it has.
+	 */
+	struct MeshBounds
+	{
+		glm::vec4 Sphere;       // xyz = center, w = radius
+		glm::vec3 Min;
+		uint32    FirstLod = 0; // in GeometryPool's LOD buffer, filled in by GeometryPool::UploadMesh()
+		glm::vec3 Max;
+		uint32    LodCount = 0;
+	};
+	static_assert(sizeof(MeshBounds) == 48, "MeshBounds must match common/bindless.glsl's MeshBounds layout");
+
+	/*
+	 * A cluster of up to MeshOptimizer::MAX_MESHLET_VERTICES vertices and MAX_MESHLET_TRIANGLES triangles, built at
+	 * import, which the culling pass (shaders/cull.comp) accepts or rejects on its own. A meshlet's triangles
+	 * are a contiguous run of its mesh's index range - the drawing pass reads a visible one's indices straight from there.
+	 * Also the GPU layout of one entry in GeometryPool's meshlet buffer (mirrored as Meshlet in
+	 * common/bindless.glsl).
+	 */
+	struct Meshlet
+	{
+		glm::vec4 Sphere;     // object space, xyz = center, w = radius
+		glm::vec4 Cone;       // xyz = average normal, w = sine of the widest angle from it - 1 = never backfacing
+		uint32    FirstIndex; // relative to the mesh's first index
+		uint32    IndexCount;
+		uint32    _Pad[2];
+	};
+	static_assert(sizeof(Meshlet) == 48, "Meshlet must match common/bindless.glsl's Meshlet layout");
+
+	/*
+	 * One level of detail of a mesh - every level is a different set of triangles over the same vertices, split
+	 * into its own meshlets. Also the GPU layout of one entry in GeometryPool's LOD buffer (mirrored as MeshLod
+	 * in common/bindless.glsl), which the culling pass picks from by projected Error.
+	 */
+	struct MeshLod
+	{
+		uint32 FirstMeshlet; // in GeometryPool's meshlet buffer
+		uint32 MeshletCount;
+		float  Error;        // object-space distance the level's surface is at most off the full-detail one
+		uint32 _Pad;
+	};
+	static_assert(sizeof(MeshLod) == 16, "MeshLod must match common/bindless.glsl's MeshLod layout");
+
+	// A level of detail as built at import (see MeshOptimizer::BuildLods()), before it goes to GeometryPool
+	struct MeshLodData
+	{
+		std::vector<uint32>  Indices;
+		std::vector<Meshlet> Meshlets; // FirstIndex relative to Indices
+		float                Error = 0.0f;
+	};
+
 	struct MeshRange
 	{
 		BufferRange Vertices;
-		BufferRange Indices;
+		BufferRange Indices;                // in GeometryPool's index buffer of IndexType, all LODs back to back
+		BufferRange Bounds;                 // single element in GeometryPool's bounds buffer
+		BufferRange Meshlets;               // in GeometryPool's meshlet buffer, of all LODs
+		BufferRange Lods;                   // in GeometryPool's LOD buffer, also recorded in the bounds entry
+		EIndexType  IndexType          = EIndexType::UINT32;
+		uint32      MaxLodMeshletCount = 0; // meshlets of the level with the most, the most one instance can draw
+		uint32      MaxLodIndexCount   = 0; // indices of the level with the most, likewise
 	};
 
+	// A mesh's geometry in GeometryPool, which owns its MeshRange since compaction can move it
+	using GeometryHandle = Handle<struct GeometryHandleTag>;
+
+	/*
+	 * A mesh of a Model, owning its geometry in GeometryPool - it's freed once the last reference to the mesh is
+	 * gone (e.g. after AssetManager::UnloadResource() and removing every MeshComponent using the model).
+	 */
 	class Mesh
 	{
 	public:
-		Mesh(Model* pModel, MeshRange meshRange, uint32 meshIndex)
-		    : m_pModel(pModel)
-		    , m_MeshRange(std::move(meshRange))
+		Mesh(Model* pModel, GeometryHandle geometry, const MeshBounds& bounds, uint32 meshIndex)
+		    : m_Geometry(geometry)
+		    , m_Bounds(bounds)
+		    , m_pModel(pModel)
 		    , m_MeshIndex(meshIndex)
 		{}
-		~Mesh() = default;
+		~Mesh();
+		CLASS_REMOVE_COPY(Mesh);
+
+		static Ref<Mesh> Create(Model* pModel, GeometryHandle geometry, const MeshBounds& bounds, uint32 meshIndex)
+		{
+			return CreateRef<Mesh>(pModel, geometry, bounds, meshIndex);
+		}
+
+		// Where the geometry currently is - can change between frames, see GeometryPool::GetGeneration()
+		const MeshRange& GetMeshRange() const;
 
-		static Ref<Mesh> Create(Model* pModel, MeshRange meshRange, uint32 meshIndex) { return CreateRef<Mesh>(pModel, meshRange, meshIndex); }
+		GeometryHandle GetGeometryHandle() const { return m_Geometry; }
 
-		const MeshRange& GetMeshRange() const { return m_MeshRange; }
+		const MeshBounds& GetBounds() const { return m_Bounds; }
 
 		uint32 GetMeshIndex() const { return m_MeshIndex; }
 
 		Model* GetModel() const { return m_pModel; }
 
 	private:
-		MeshRange m_MeshRange;
+		GeometryHandle m_Geometry;
+		MeshBounds     m_Bounds;
 
 		Model* m_pModel;
 		uint32 m_MeshIndex;
@@ -1,32 +1,84 @@
 #include "BufferArena.h"
 
+#include "Platform/API/Buffer.h"
+
 #include <algorithm>
 
 namespace Poly
 {
-	BufferArena::BufferArena(uint64 elementStride, FBufferUsage usage, EMemoryUsage memUsage, std::string debugName)
+	BufferArena::BufferArena(uint64 elementStride, FBufferUsage usage, EMemoryUsage memUsage, std::string debugName, uint32 pageSizeLog2)
 	    : m_ElementStride(elementStride)
 	    , m_Usage(usage | FBufferUsage::TRANSFER_SRC)
 	    , m_MemUsage(memUsage)
 	    , m_DebugName(std::move(debugName))
+	    , m_PageSizeLog2(pageSizeLog2)
 	{}
 
 	BufferRange BufferArena::Upload(const void* pData, uint32 count)
 	{
-		EnsureCapacity(m_ElementCount + count);
+		if (count == 0)
+			return {};
 
-		const BufferRange range{m_ElementCount, count};
-		ResourceManager::UploadBufferData(m_Handle, pData, static_cast<uint64>(count) * m_ElementStride,
-		                                  static_cast<uint64>(range.ElementOffset) * m_ElementStride);
-		m_ElementCount += count;
+		const BufferRange range{Allocate(count), count};
+		WriteElements(range.ElementOffset, pData, count);
 		return range;
 	}
 
+	void BufferArena::Free(BufferRange range)
+	{
+		if (range.ElementCount == 0)
+			return;
+
+		m_ElementCount -= range.ElementCount;
+		m_PendingFrees.push_back({range, FREE_LATENCY});
+	}
+
+	bool BufferArena::Relocate(BufferRange& range)
+	{
+		if (range.ElementCount == 0)
+			return false;
+
+		// Lowest first, so the end of the arena empties out
+		auto it = m_FreeBlocks.begin();
+		while (it != m_FreeBlocks.end() && it->first < range.ElementOffset && it->second < range.ElementCount)
+			it++;
+
+		if (it == m_FreeBlocks.end() || it->first >= range.ElementOffset)
+			return false;
+
+		const uint32 offset = it->first;
+		TakeFreeBlock(offset, it->second, range.ElementCount);
+		CopyElements(range.ElementOffset, offset, range.ElementCount);
+
+		// Still allocated, just somewhere else - the old place is freed without touching the count
+		m_PendingFrees.push_back({range, FREE_LATENCY});
+		range.ElementOffset = offset;
+		return true;
+	}
+
+	void BufferArena::Update()
+	{
+		std::erase_if(m_PendingFrees, [this](PendingFree& pending) {
+			if (--pending.FramesLeft > 0)
+				return false;
+
+			AddFreeBlock(pending.Range.ElementOffset, pending.Range.ElementCount);
+			return true;
+		});
+	}
+
 	void BufferArena::Reset()
 	{
-		m_Handle          = {};
-		m_ElementCapacity = 0;
-		m_ElementCount    = 0;
+		m_Handle = {};
+		m_Pages.clear();
+		m_PageAddresses.clear();
+		m_ElementCapacity  = 0;
+		m_ElementCount     = 0;
+		m_ElementEnd       = 0;
+		m_FreeElementCount = 0;
+		m_FreeBlocks.clear();
+		m_FreeBlocksBySize.clear();
+		m_PendingFrees.clear();
 	}
 
 	void BufferArena::EnsureCapacity(uint32 requiredCount)
@@ -34,9 +86,16 @@ namespace Poly
 		if (requiredCount <= m_ElementCapacity)
 			return;
 
+		if (IsPaged())
+		{
+			while (m_ElementCapacity < requiredCount)
+				AddPage();
+			return;
+		}
+
 		constexpr uint32 kMinCapacity = 1024;
 		uint32           newCapacity  = m_ElementCapacity == 0 ? kMinCapacity : m_ElementCapacity * 2;
-		newCapacity                   = std::max(newCapacity, requiredCount);
+		newCapacity                   = std::max(newCapacity, (requiredCount + 1) & ~1u); // even, so 16-bit elements fill whole words for shaders
 
 		if (!m_Handle.IsValid())
 		{
@@ -44,10 +103,168 @@ namespace Poly
 		}
 		else
 		{
-			const uint64 usedBytes = static_cast<uint64>(m_ElementCount) * m_ElementStride;
+			const uint64 usedBytes = static_cast<uint64>(m_ElementEnd) * m_ElementStride;
 			m_Handle               = ResourceManager::ResizeBuffer(m_Handle, static_cast<uint64>(newCapacity) * m_ElementStride, FQueueType::GRAPHICS, usedBytes);
 		}
 
 		m_ElementCapacity = newCapacity;
 	}
+
+	void BufferArena::AddPage()
+	{
+		POLY_VALIDATE(m_Pages.size() < MAX_PAGES, "BufferArena '{}' is out of pages ({} pages)", m_DebugName, MAX_PAGES);
+
+		if (!m_Handle.IsValid())
+		{
+			m_Handle = ResourceManager::CreateBuffer(sizeof(uint64) * MAX_PAGES, FBufferUsage::STORAGE_BUFFER | FBufferUsage::SHADER_DEVICE_ADDRESS,
+			                                         EMemoryUsage::GPU_ONLY, m_DebugName + ".PageTable");
+		}
+
+		const uint32       pageSize = 1u << m_PageSizeLog2;
+		const BufferHandle page     = ResourceManager::CreateBuffer(static_cast<uint64>(pageSize) * m_ElementStride, m_Usage, m_MemUsage,
+		                                                            m_DebugName + ".Page" + std::to_string(m_Pages.size()));
+		m_Pages.push_back(page);
+		m_PageAddresses.push_back(ResourceManager::Resolve(page)->GetDeviceAddress());
+		m_ElementCapacity += pageSize;
+
+		TouchPageTable();
+	}
+
+	BufferHandle BufferArena::GetElementBuffer(uint32 offset) const
+	{
+		return IsPaged() ? m_Pages[offset >> m_PageSizeLog2] : m_Handle;
+	}
+
+	uint32 BufferArena::GetElementIndex(uint32 offset) const
+	{
+		return IsPaged() ? offset & ((1u << m_PageSizeLog2) - 1) : offset;
+	}
+
+	uint32 BufferArena::GetElementsLeftInBuffer(uint32 offset) const
+	{
+		return IsPaged() ? (1u << m_PageSizeLog2) - GetElementIndex(offset) : m_ElementCapacity - offset;
+	}
+
+	void BufferArena::WriteElements(uint32 offset, const void* pData, uint32 count)
+	{
+		const byte* pBytes = static_cast<const byte*>(pData);
+		while (count > 0)
+		{
+			const uint32 spanCount = std::min(count, GetElementsLeftInBuffer(offset));
+			ResourceManager::UploadBufferData(GetElementBuffer(offset), pBytes, static_cast<uint64>(spanCount) * m_ElementStride,
+			                                  static_cast<uint64>(GetElementIndex(offset)) * m_ElementStride);
+
+			pBytes += static_cast<uint64>(spanCount) * m_ElementStride;
+			offset += spanCount;
+			count -= spanCount;
+		}
+
+		TouchPageTable();
+	}
+
+	void BufferArena::CopyElements(uint32 srcOffset, uint32 dstOffset, uint32 count)
+	{
+		while (count > 0)
+		{
+			const uint32 spanCount = std::min({count, GetElementsLeftInBuffer(srcOffset), GetElementsLeftInBuffer(dstOffset)});
+			ResourceManager::CopyBufferData(GetElementBuffer(srcOffset), static_cast<uint64>(GetElementIndex(srcOffset)) * m_ElementStride,
+			                                GetElementBuffer(dstOffset), static_cast<uint64>(GetElementIndex(dstOffset)) * m_ElementStride,
+			                                static_cast<uint64>(spanCount) * m_ElementStride);
+
+			srcOffset += spanCount;
+			dstOffset += spanCount;
+			count -= spanCount;
+		}
+
+		TouchPageTable();
+	}
+
+	void BufferArena::TouchPageTable()
+	{
+		// The render graph only waits for uploads to the buffers it has been given - the page table, not the pages.
+		// Rewriting it alongside every upload to a page gives it a pending upload in the same flush, which covers them.
+		if (IsPaged())
+			ResourceManager::UploadBufferData(m_Handle, m_PageAddresses.data(), sizeof(uint64) * m_PageAddresses.size());
+	}
+
+	uint32 BufferArena::Allocate(uint32 count)
+	{
+		m_ElementCount += count;
+
+		// Best fit - the smallest block it fits in
+		if (auto it = m_FreeBlocksBySize.lower_bound(count); it != m_FreeBlocksBySize.end())
+		{
+			const uint32 offset = it->second;
+			TakeFreeBlock(offset, it->first, count);
+			return offset;
+		}
+
+		EnsureCapacity(m_ElementEnd + count);
+		const uint32 offset = m_ElementEnd;
+		m_ElementEnd += count;
+		return offset;
+	}
+
+	void BufferArena::TakeFreeBlock(uint32 offset, uint32 blockCount, uint32 count)
+	{
+		EraseFreeBlock(offset, blockCount);
+
+		// The rest stays free - its neighbours are allocated, so there is nothing to merge with
+		if (blockCount > count)
+		{
+			m_FreeBlocks.emplace(offset + count, blockCount - count);
+			m_FreeBlocksBySize.emplace(blockCount - count, offset + count);
+			m_FreeElementCount += blockCount - count;
+		}
+	}
+
+	void BufferArena::AddFreeBlock(uint32 offset, uint32 count)
+	{
+		// Merge with the free blocks right before and after
+		auto next = m_FreeBlocks.lower_bound(offset);
+		if (next != m_FreeBlocks.begin())
+		{
+			auto previous = std::prev(next);
+			if (previous->first + previous->second == offset)
+			{
+				offset = previous->first;
+				count += previous->second;
+				EraseFreeBlock(previous->first, previous->second);
+			}
+		}
+
+		next = m_FreeBlocks.lower_bound(offset + count);
+		if (next != m_FreeBlocks.end() && next->first == offset + count)
+		{
+			count += next->second;
+			EraseFreeBlock(next->first, next->second);
+		}
+
+		// Free up to the end - give it back to the end instead
+		if (offset + count == m_ElementEnd)
+		{
+			m_ElementEnd = offset;
+			return;
+		}
+
+		m_FreeBlocks.emplace(offset, count);
+		m_FreeBlocksBySize.emplace(count, offset);
+		m_FreeElementCount += count;
+	}
+
+	void BufferArena::EraseFreeBlock(uint32 offset, uint32 count)
+	{
+		m_FreeBlocks.erase(offset);
+		m_FreeElementCount -= count;
+
+		auto [first, last] = m_FreeBlocksBySize.equal_range(count);
+		for (auto it = first; it != last; it++)
+		{
+			if (it->second == offset)
+			{
+				m_FreeBlocksBySize.erase(it);
+				return;
+			}
+		}
+	}
 } // namespace Poly
@@ -3,50 +3,125 @@
 #include "Poly/RenderGraph/BufferRange.h"
 #include "Poly/RenderGraph/ResourceManager.h"
 
+#include <map>
 #include <string>
+#include <vector>
 
 namespace Poly
 {
 	/*
-	 * Append-only (bump) allocator over a single GPU buffer that grows on demand. Never frees
-	 * individual allocations - intended for data that's loaded once and kept alive for the
-	 * process's lifetime (e.g. mesh geometry, via GeometryPool). Not thread-safe: callers must
-	 * synchronize externally if Upload() can be called from more than one thread.
+	 * Range allocator over GPU memory that grows on demand - either a single buffer, grown by copying it into a
+	 * bigger one (ResourceManager::ResizeBuffer()), or, for arenas that are only read through buffer device
+	 * addresses, fixed-size pages: growing adds a page and copies nothing. Shaders find an element of a paged
+	 * arena through its page table - GetBufferHandle() is a buffer of the pages' device addresses, element i
+	 * is element (i & (page size - 1)) of page (i >> pageSizeLog2). Ranges may straddle pages.
+	 *
+	 * Freed ranges go to a free list of blocks, merged with their free neighbours, and Upload() reuses the
+	 * smallest block the data fits in before appending at the end. Free() only takes effect FREE_LATENCY
+	 * Update()s later, since frames still in flight may read the range. Relocate() moves an allocation into a
+	 * free block further down, so a fragmented arena can be compacted a few ranges at a time (see
+	 * GeometryPool::Update()). Not thread-safe: callers must synchronize externally if it can be used from more than one thread.
 	 */
 	class BufferArena
 	{
 	public:
-		BufferArena(uint64 elementStride, FBufferUsage usage, EMemoryUsage memUsage, std::string debugName);
+		// Update()s between Free() and the range being reused - one more than the frames in flight, since
+		// users of the arena may only notice a Relocate() on the frame after
+		static constexpr uint32 FREE_LATENCY = ResourceManager::FRAMES_IN_FLIGHT + 1;
+
+		static constexpr uint32 MAX_PAGES = 256; // entries of a paged arena's page table
+
+		/*
+		 * @param elementStride - size of one element in bytes
+		 * @param usage - usage of the underlying buffer(s)
+		 * @param memUsage - memory usage of the underlying buffer(s)
+		 * @param debugName - debug name of the underlying buffer(s)
+		 * @param pageSizeLog2 - log2 of the elements per page, 0 for a single growing buffer
+		 */
+		BufferArena(uint64 elementStride, FBufferUsage usage, EMemoryUsage memUsage, std::string debugName, uint32 pageSizeLog2 = 0);
 		~BufferArena() = default;
 		CLASS_REMOVE_COPY(BufferArena);
 
 		/*
 		 * Allocates `count` elements and uploads pData into them, growing the underlying buffer
-		 * first if it doesn't have room.
+		 * first if no free block has room.
 		 * @param pData - pointer to `count` elements worth of data (each ElementStride bytes)
 		 * @param count - number of elements to allocate and upload
 		 * @return BufferRange - the element range the data was placed at
 		 */
 		BufferRange Upload(const void* pData, uint32 count);
 
+		/*
+		 * Returns a range from Upload() (or Relocate()) to the arena, once frames in flight are done with it
+		 * @param range - range to free, must not be used for anything after this
+		 */
+		void Free(BufferRange range);
+
+		/*
+		 * Moves an allocation into the lowest free block below it that fits, queuing a GPU copy of its contents
+		 * (see ResourceManager::CopyBufferData()) and freeing its old place.
+		 * @param range - allocation to move, updated to where it was moved to
+		 * @return true if it was moved, false if no free block below it fits it
+		 */
+		bool Relocate(BufferRange& range);
+
+		// Ages pending frees - call once per frame
+		void Update();
+
 		// Drops the arena back to its unallocated state without touching the underlying buffer -
 		// for use during engine shutdown, after ResourceManager has already torn everything down.
 		void Reset();
 
-		BufferHandle GetBufferHandle() const { return m_Handle; }
+		BufferHandle GetBufferHandle() const { return m_Handle; } // the page table if paged
+		bool         IsPaged() const { return m_PageSizeLog2 != 0; }
+		uint64       GetElementStride() const { return m_ElementStride; }
 		uint32       GetCapacity() const { return m_ElementCapacity; }
-		uint32       GetCount() const { return m_ElementCount; }
+		uint32       GetCount() const { return m_ElementCount; }         // allocated elements
+		uint32       GetEnd() const { return m_ElementEnd; }             // one past the highest allocated element
+		uint32       GetFreeCount() const { return m_FreeElementCount; } // in free blocks below GetEnd()
 
 	private:
+		struct PendingFree
+		{
+			BufferRange Range;
+			uint32      FramesLeft = 0;
+		};
+
 		void EnsureCapacity(uint32 requiredCount);
+		void AddPage();
+
+		// Where an element is - the buffer holding it, and its index in there
+		BufferHandle GetElementBuffer(uint32 offset) const;
+		uint32       GetElementIndex(uint32 offset) const;
+		uint32       GetElementsLeftInBuffer(uint32 offset) const;
+
+		void WriteElements(uint32 offset, const void* pData, uint32 count);
+		void CopyElements(uint32 srcOffset, uint32 dstOffset, uint32 count);
+		void TouchPageTable();
+
+		uint32 Allocate(uint32 count);
+		void   TakeFreeBlock(uint32 offset, uint32 blockCount, uint32 count);
+		void   AddFreeBlock(uint32 offset, uint32 count);
+		void   EraseFreeBlock(uint32 offset, uint32 count);
 
 		uint64       m_ElementStride;
 		FBufferUsage m_Usage;
 		EMemoryUsage m_MemUsage;
 		std::string  m_DebugName;
+		uint32       m_PageSizeLog2;
+
+		BufferHandle              m_Handle; // the page table if paged
+		std::vector<BufferHandle> m_Pages;
+		std::vector<uint64>       m_PageAddresses;
+
+		uint32 m_ElementCapacity  = 0;
+		uint32 m_ElementCount     = 0;
+		uint32 m_ElementEnd       = 0;
+		uint32 m_FreeElementCount = 0;
 
-		BufferHandle m_Handle;
-		uint32       m_ElementCapacity = 0;
-		uint32       m_ElementCount    = 0;
+		// Free blocks, never adjacent to each other or to m_ElementEnd - a block freed next to one is merged into it
+		std::map<uint32, uint32>      m_FreeBlocks;       // offset -> count
+		std::multimap<uint32, uint32> m_FreeBlocksBySize; // count -> offset, for best fit
+		std::vector<PendingFree>      m_PendingFrees;
 	};
 } // namespace Poly
@@ -1,6 +1,7 @@
 #include "ExecuteContext.h"
 
 #include "Platform/API/CommandBuffer.h"
+#include "Poly/Core/ThreadPool.h"
 #include "Poly/RenderGraph/ResourceManager.h"
 
 namespace Poly
@@ -11,6 +12,46 @@ namespace Poly
 		uint32              heapIndex = textureHandle.GetIndex() | (sampler.GetIndex() << ResourceManager::SAMPLER_INDEX_SHIFT);
 		uint32              offset    = m_TextureSlotOffset + slot * static_cast<uint32>(sizeof(uint32));
 
-		m_pCmdBuffer->UpdatePushConstants(m_pPipelineLayout, FShaderStage::VERTEX | FShaderStage::FRAGMENT, offset, sizeof(uint32), &heapIndex);
+		if (m_pParallelRecording)
+		{
+			POLY_VALIDATE(!m_HasRecordedParallel, "SetTextureSlot after RecordParallel has no draws left to affect - set per-draw slots on the range's context");
+			m_ParallelTextureSlots.emplace_back(offset, heapIndex);
+			return;
+		}
+
+		m_pCmdBuffer->UpdatePushConstants(m_pPipelineLayout, m_PushConstantStages, offset, sizeof(uint32), &heapIndex);
+	}
+
+	void ExecuteContext::RecordParallel(uint32 itemCount, uint32 grainSize, const std::function<void(ExecuteContext& ctx, uint32 begin, uint32 end)>& recordFn)
+	{
+		POLY_VALIDATE(m_pParallelRecording, "RecordParallel called from a pass that wasn't declared WithParallelRecording()");
+		POLY_VALIDATE(!m_HasRecordedParallel, "RecordParallel may only be called once per pass - its secondary buffers are reused every call");
+		m_HasRecordedParallel = true;
+
+		if (itemCount == 0)
+			return;
+
+		// Fewer, bigger ranges than the grain size allows if there aren't enough secondary buffers to go around
+		grainSize               = std::max(grainSize, 1u);
+		const uint32 rangeCount  = std::min((itemCount - 1) / grainSize + 1, m_pParallelRecording->SecondaryBufferCount);
+		const uint32 rangeLength = (itemCount - 1) / rangeCount + 1;
+
+		ThreadPool::ParallelFor(rangeCount, 1, [&](uint32 rangeIndex) {
+			CommandBuffer* pCmd = m_pParallelRecording->ppSecondaryBuffers[rangeIndex];
+			pCmd->BeginSecondary(m_pParallelRecording->pInheritance, FCommandBufferFlag::ONE_TIME_SUBMIT);
+			m_pParallelRecording->BindPassState(pCmd);
+			for (const auto& [offset, heapIndex] : m_ParallelTextureSlots)
+				pCmd->UpdatePushConstants(m_pPipelineLayout, m_PushConstantStages, offset, sizeof(uint32), &heapIndex);
+
+			const uint32   begin = rangeIndex * rangeLength;
+			const uint32   end   = std::min(begin + rangeLength, itemCount);
+			ExecuteContext rangeCtx(pCmd, m_View, m_pPipelineLayout, m_TextureSlotOffset, m_PushConstantStages);
+			if (begin < end)
+				recordFn(rangeCtx, begin, end);
+
+			pCmd->End();
+		});
+
+		m_pCmdBuffer->ExecuteCommands(m_pParallelRecording->ppSecondaryBuffers, rangeCount);
 	}
-} // namespace Poly
\ No newline at end of file
+} // namespace Poly
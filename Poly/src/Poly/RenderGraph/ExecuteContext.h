@@ -1,35 +1,79 @@
 #pragma once
 
 #include "Poly/Core/Handle.h"
+#include "Poly/Rendering/Core/API/GraphicsTypes.h"
 #include "RenderView.h"
 
+#include <functional>
+#include <vector>
+
 namespace Poly
 {
 	class CommandBuffer;
 	class PipelineLayout;
+	struct RenderingInheritanceDesc;
 
 	using TextureHandle = Handle<struct TextureHandleTag>;
 	using SamplerHandle = Handle<struct SamplerHandleTag>;
 
+	// What RecordParallel() needs to split a pass across secondary command buffers - filled in by
+	// RenderProgramInstance for passes declared WithParallelRecording().
+	struct ParallelRecordingDesc
+	{
+		CommandBuffer* const*               ppSecondaryBuffers   = nullptr;
+		uint32                              SecondaryBufferCount = 0;
+		const RenderingInheritanceDesc*     pInheritance         = nullptr;
+		std::function<void(CommandBuffer*)> BindPassState; // pipeline/viewport/descriptor/push constant state isn't inherited by secondaries
+	};
+
 	class ExecuteContext
 	{
 	public:
-		ExecuteContext(CommandBuffer* pCmdBuffer, const RenderView& view, PipelineLayout* pPipelineLayout, uint32 textureSlotOffset)
+		ExecuteContext(CommandBuffer* pCmdBuffer, const RenderView& view, PipelineLayout* pPipelineLayout, uint32 textureSlotOffset,
+		               FShaderStage pushConstantStages, const ParallelRecordingDesc* pParallelRecording = nullptr)
 		    : m_pCmdBuffer(pCmdBuffer)
 		    , m_View(view)
 		    , m_pPipelineLayout(pPipelineLayout)
 		    , m_TextureSlotOffset(textureSlotOffset)
+		    , m_PushConstantStages(pushConstantStages)
+		    , m_pParallelRecording(pParallelRecording)
 		{}
 
+		/**
+		 * Points a texture slot of the pass's push constants at a texture. In a pass declared WithParallelRecording(),
+		 * calling it before RecordParallel() sets the slot for every range's secondary buffer, and per-draw changes
+		 * go through the range's own context instead.
+		 */
 		void SetTextureSlot(uint32 slot, const TextureHandle& textureHandle, const SamplerHandle& samplerHandle);
 
-		CommandBuffer*    GetCommandBuffer() const { return m_pCmdBuffer; }
+		/**
+		 * Splits a pass's draw list across worker threads. [0, itemCount) is cut into contiguous ranges of at least
+		 * grainSize items, one per secondary command buffer, and recordFn is called once per range with a context
+		 * whose GetCommandBuffer() is that range's secondary buffer - already inside the pass's rendering scope with
+		 * its pipeline, descriptors and push constants bound. Blocks until every range is recorded, and may only be
+		 * called once per pass, from a pass declared WithParallelRecording().
+		 */
+		void RecordParallel(uint32 itemCount, uint32 grainSize, const std::function<void(ExecuteContext& ctx, uint32 begin, uint32 end)>& recordFn);
+
+		CommandBuffer* GetCommandBuffer() const
+		{
+			POLY_VALIDATE(!m_pParallelRecording, "Passes declared WithParallelRecording() must record their draws through RecordParallel()");
+			return m_pCmdBuffer;
+		}
+
 		const RenderView& GetView() const { return m_View; }
 
 	private:
-		CommandBuffer*    m_pCmdBuffer;
-		const RenderView& m_View;
-		PipelineLayout*   m_pPipelineLayout;
-		uint32            m_TextureSlotOffset;
+		CommandBuffer*               m_pCmdBuffer;
+		const RenderView&            m_View;
+		PipelineLayout*              m_pPipelineLayout;
+		uint32                       m_TextureSlotOffset;
+		FShaderStage                 m_PushConstantStages; // VERTEX | FRAGMENT, or COMPUTE for a compute pass
+		const ParallelRecordingDesc* m_pParallelRecording;
+		bool                         m_HasRecordedParallel = false;
+
+		// Slots set before RecordParallel() - push constants recorded into the primary wouldn't reach the
+		// secondaries, so every range applies them after binding the pass state
+		std::vector<std::pair<uint32, uint32>> m_ParallelTextureSlots; // offset, heap index
 	};
 } // namespace Poly
@@ -41,11 +41,25 @@ namespace Poly
 		 */
 		virtual IPassDeclaration& WithExecuteFn(std::function<void(ExecuteContext&)> executeFn) = 0;
 
+		/*
+		 * Records the pass's draws across worker threads, each into its own secondary command buffer. The execute
+		 * function must then hand its draw list to ExecuteContext::RecordParallel() instead of recording into
+		 * GetCommandBuffer() directly. Only worth it for passes with a lot of draws.
+		 */
+		virtual IPassDeclaration& WithParallelRecording() = 0;
+
 		/*
 		 * Starts a pipeline override declaration. Finish with .FinishPipeline() to return here.
 		 */
 		virtual IPassDeclarationGraphicsPipeline& WithGraphicsPipeline() = 0;
 
+		/*
+		 * Makes this a compute pass: its single FShaderStage::COMPUTE shader is dispatched from the execute function
+		 * (CommandBuffer::Dispatch()/DispatchIndirect()) outside of any rendering scope, so it can't write attachments.
+		 * Combine with OnQueue(FQueueType::COMPUTE) to run it on the async compute queue alongside graphics work.
+		 */
+		virtual IPassDeclaration& WithComputePipeline() = 0;
+
 		/*
 		 * Maps a feature port to a shader resource of the pass. This works as a connection between the stricter feature pipeline
 		 * and the more flexible pass pipeline. Mapping a feature port means that it is then exposed to other features in the pipeline,
@@ -68,6 +82,17 @@ namespace Poly
 		 */
 		virtual PassDeclaration& MapGlobal(std::string_view globalName, std::string_view shaderGlobalName) = 0;
 
+		/*
+		 * Maps a global variable the pass writes to, e.g. a compute pass filling an argument buffer that a later pass draws from.
+		 * Passes mapping the same global with MapGlobal() are then ordered after this one and synchronized against its writes.
+		 * Takes a bindless slot in declaration order, same as MapGlobal().
+		 *
+		 * @param globalName The name of the global variable to map.
+		 * @param shaderGlobalName The name of the shader global to map to. This should match a global in the shader of the pass.
+		 * @return A reference to this for chaining.
+		 */
+		virtual PassDeclaration& WriteGlobal(std::string_view globalName, std::string_view shaderGlobalName) = 0;
+
 		/*
 		 * Imports a resource to the pass. This is different to mapping feature ports, as it isn't limited to the available feature ports.
 		 * Importing a resource means that the pass can have a dependency to a resource from another pass, without the need of a feature port.
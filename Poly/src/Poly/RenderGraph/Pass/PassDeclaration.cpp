@@ -25,6 +25,12 @@ namespace Poly
 		return *this;
 	}
 
+	PassDeclaration& PassDeclaration::WithParallelRecording()
+	{
+		m_ParallelRecording = true;
+		return *this;
+	}
+
 	PassDeclaration& PassDeclaration::OnQueue(FQueueType queue)
 	{
 		m_Queue = queue;
@@ -36,6 +42,12 @@ namespace Poly
 		return m_GraphicsPipelineDecl;
 	}
 
+	PassDeclaration& PassDeclaration::WithComputePipeline()
+	{
+		m_PipelineType = EPipelineType::COMPUTE;
+		return *this;
+	}
+
 	PassDeclaration& PassDeclaration::MapResource(EFeaturePort port, std::string_view shaderResourceName, ELoadOp loadOp)
 	{
 		m_ResourceMappings.push_back({port, std::string(shaderResourceName), loadOp});
@@ -44,7 +56,13 @@ namespace Poly
 
 	PassDeclaration& PassDeclaration::MapGlobal(std::string_view globalName, std::string_view shaderGlobalName)
 	{
-		m_GlobalMappings.emplace_back(std::string(globalName), std::string(shaderGlobalName));
+		m_GlobalMappings.push_back({std::string(globalName), std::string(shaderGlobalName), /*IsWrite=*/false});
+		return *this;
+	}
+
+	PassDeclaration& PassDeclaration::WriteGlobal(std::string_view globalName, std::string_view shaderGlobalName)
+	{
+		m_GlobalMappings.push_back({std::string(globalName), std::string(shaderGlobalName), /*IsWrite=*/true});
 		return *this;
 	}
 
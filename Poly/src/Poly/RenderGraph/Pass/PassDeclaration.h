@@ -31,6 +31,12 @@ RenderGraph.RegisterPass("imgui")
         .FinishVertexInput()
         .FinishPipeline()
     .WithExecuteFn( ... );
+
+RenderGraph.RegisterPass("cull")
+    .WithShader("shaders/cull.comp", FShaderStage::COMPUTE)
+    .WithComputePipeline()
+    .OnQueue(FQueueType::COMPUTE)
+    .WithExecuteFn([](ExecuteContext& ctx) { ctx.GetCommandBuffer()->Dispatch(groupCount, 1, 1); });
 */
 
 namespace Poly
@@ -48,6 +54,14 @@ namespace Poly
 		ELoadOp      LoadOpOverride = ELoadOp::NONE;
 	};
 
+	// A mapped global - read by default, written if declared through WriteGlobal()
+	struct GlobalMapping
+	{
+		std::string GlobalName;
+		std::string ShaderGlobalName;
+		bool        IsWrite = false;
+	};
+
 	class PassDeclaration : public IPassDeclaration
 	{
 	public:
@@ -57,16 +71,21 @@ namespace Poly
 		PassDeclaration&                 WithShader(std::string_view shaderPath, FShaderStage stage) override;
 		PassDeclaration&                 WithSetupFn(std::function<void(SetupContext&)> setupFn) override;
 		PassDeclaration&                 WithExecuteFn(std::function<void(ExecuteContext&)> executeFn) override;
+		PassDeclaration&                 WithParallelRecording() override;
 		PassDeclaration&                 OnQueue(FQueueType queue) override;
 		PassDeclarationGraphicsPipeline& WithGraphicsPipeline() override;
+		PassDeclaration&                 WithComputePipeline() override;
 
 		PassDeclaration& MapResource(EFeaturePort resourceName, std::string_view shaderResourceName, ELoadOp loadOp = ELoadOp::NONE) override;
 		PassDeclaration& MapGlobal(std::string_view globalName, std::string_view shaderGlobalName) override;
+		PassDeclaration& WriteGlobal(std::string_view globalName, std::string_view shaderGlobalName) override;
 		PassDeclaration& ImportResource(std::string_view resourceName, std::string_view shaderResourceName) override;
 		PassDeclaration& ExportResource(std::string_view resourceName, std::string_view shaderResourceName) override;
 
 		std::string_view GetName() const { return m_Name; }
 		FQueueType       GetQueue() const { return m_Queue; }
+		EPipelineType    GetPipelineType() const { return m_PipelineType; }
+		bool             IsParallelRecording() const { return m_ParallelRecording; }
 
 		const std::vector<std::pair<std::string, FShaderStage>>& GetShaders() const { return m_Shaders; }
 		const PassDeclarationGraphicsPipeline&                   GetGraphicsPipeline() const { return m_GraphicsPipelineDecl; }
@@ -76,7 +95,7 @@ namespace Poly
 		void CallExecuteFn(ExecuteContext& ctx) const;
 
 		const std::vector<ResourceMapping>&                      GetResourceMappings() const { return m_ResourceMappings; }
-		const std::vector<std::pair<std::string, std::string>>&  GetGlobalMappings() const { return m_GlobalMappings; }
+		const std::vector<GlobalMapping>&                        GetGlobalMappings() const { return m_GlobalMappings; }
 		const std::vector<std::pair<std::string, std::string>>&  GetImportedResources() const { return m_ImportedResources; }
 		const std::vector<std::pair<std::string, std::string>>&  GetExportedResources() const { return m_ExportedResources; }
 
@@ -86,7 +105,9 @@ namespace Poly
 
 	private:
 		const std::string m_Name;
-		FQueueType        m_Queue = FQueueType::GRAPHICS;
+		FQueueType        m_Queue             = FQueueType::GRAPHICS;
+		EPipelineType     m_PipelineType      = EPipelineType::GRAPHICS;
+		bool              m_ParallelRecording = false;
 
 		std::vector<std::pair<std::string, FShaderStage>> m_Shaders;
 		std::function<void(SetupContext&)>                m_SetupFn;
@@ -94,7 +115,7 @@ namespace Poly
 		PassDeclarationGraphicsPipeline                   m_GraphicsPipelineDecl;
 
 		std::vector<ResourceMapping>                      m_ResourceMappings;
-		std::vector<std::pair<std::string, std::string>>  m_GlobalMappings;
+		std::vector<GlobalMapping>                        m_GlobalMappings;
 		std::vector<std::pair<std::string, std::string>>  m_ImportedResources;
 		std::vector<std::pair<std::string, std::string>>  m_ExportedResources;
 	};
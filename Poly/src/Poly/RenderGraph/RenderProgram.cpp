@@ -1,9 +1,174 @@
 #include "RenderProgram.h"
 
+#include "Platform/API/PipelineLayout.h"
+#include "Poly/Core/RenderAPI.h"
+#include "Poly/Core/ThreadPool.h"
+#include "Poly/Resources/Shader/ShaderManager.h"
+#include "ResourceManager.h"
+
+#include <algorithm>
+
 namespace Poly
 {
-	RenderProgram::RenderProgram(std::vector<ResolvedPass> sortedPasses, SyncPlan syncPlan)
+	RenderProgram::RenderProgram(std::vector<ResolvedPass> sortedPasses, SyncPlan syncPlan, std::vector<TransientLifetime> transients)
 	    : m_Passes(std::move(sortedPasses))
 	    , m_SyncPlan(std::move(syncPlan))
-	{}
+	    , m_Transients(std::move(transients))
+	{
+		for (const TransientLifetime& transient : m_Transients)
+		{
+			if (transient.AliasSlot != TransientLifetime::NO_ALIAS_SLOT)
+				m_AliasSlotCount = std::max(m_AliasSlotCount, transient.AliasSlot + 1);
+		}
+	}
+
+	RenderProgram::~RenderProgram()
+	{
+		// Compile jobs reference this program - let them finish before it goes away
+		ThreadPool::Wait(m_PipelinesCompiled);
+	}
+
+	const TransientLifetime* RenderProgram::FindTransient(std::string_view resolvedName) const
+	{
+		auto it = std::find_if(m_Transients.begin(), m_Transients.end(), [resolvedName](const TransientLifetime& transient) { return transient.ResolvedName == resolvedName; });
+		return it != m_Transients.end() ? &*it : nullptr;
+	}
+
+	void RenderProgram::PrecompilePipelines(EFormat targetFormat)
+	{
+		if (!m_Precompiled.empty())
+			return;
+
+		m_Precompiled.resize(m_Passes.size());
+		for (size_t i = 0; i < m_Passes.size(); i++)
+			ThreadPool::Submit([this, i, targetFormat]() { PrecompilePass(i, targetFormat); }, &m_PipelinesCompiled);
+	}
+
+	float RenderProgram::GetPipelineCompileProgress() const
+	{
+		if (m_Precompiled.empty())
+			return 1.0f;
+
+		return static_cast<float>(m_PrecompiledPassCount.load(std::memory_order_relaxed)) / static_cast<float>(m_Precompiled.size());
+	}
+
+	Ref<PipelineLayout> RenderProgram::GetPrecompiledLayout(size_t passIndex) const
+	{
+		if (m_Precompiled.empty())
+			return nullptr;
+
+		ThreadPool::Wait(m_PipelinesCompiled);
+		return m_Precompiled[passIndex].Layout;
+	}
+
+	Ref<Pipeline> RenderProgram::GetPrecompiledPipeline(size_t passIndex, const PassAttachmentFormats& formats) const
+	{
+		if (m_Precompiled.empty())
+			return nullptr;
+
+		ThreadPool::Wait(m_PipelinesCompiled);
+		const PrecompiledPass& precompiled = m_Precompiled[passIndex];
+		return precompiled.Formats == formats ? precompiled.Pipeline : nullptr;
+	}
+
+	Ref<PipelineLayout> RenderProgram::CreatePipelineLayout(const ResolvedPass& pass)
+	{
+		PipelineLayoutDesc desc   = {};
+		desc.DescriptorSetLayouts = {ResourceManager::GetSetLayoutDesc()}; // set 0 - shared bindless heap
+
+		if (pass.PushConstantSize > 0)
+		{
+			PushConstantRange range = {};
+			range.ShaderStage       = pass.GetPushConstantStages();
+			range.Offset            = 0;
+			range.Size              = pass.PushConstantSize;
+			desc.PushConstantRanges.push_back(range);
+		}
+
+		return RenderAPI::CreatePipelineLayout(&desc);
+	}
+
+	Ref<Pipeline> RenderProgram::CreatePipeline(const ResolvedPass& pass, PipelineLayout* pLayout, const PassAttachmentFormats& formats)
+	{
+		if (pass.IsCompute())
+		{
+			ComputePipelineDesc desc = {};
+			desc.pPipelineLayout     = pLayout;
+
+			for (const auto& [shaderPath, shaderStage] : pass.Shaders)
+			{
+				if (shaderStage == FShaderStage::COMPUTE)
+					desc.pComputeShader = ShaderManager::GetShader(ShaderManager::CreateShader(shaderPath, shaderStage)).pShader.get();
+			}
+
+			if (!desc.pComputeShader)
+			{
+				POLY_CORE_ERROR("Compute pass '{}' has no FShaderStage::COMPUTE shader declared.", pass.Name);
+				return nullptr;
+			}
+
+			return RenderAPI::CreateComputePipeline(&desc);
+		}
+
+		GraphicsPipelineDesc desc    = pass.PipelineDesc;
+		desc.pPipelineLayout         = pLayout;
+		desc.pRenderPass             = nullptr; // dynamic rendering - no VkRenderPass/Framebuffer
+		desc.ColorAttachmentFormats  = formats.ColorAttachmentFormats;
+		desc.DepthAttachmentFormat   = formats.DepthAttachmentFormat;
+		desc.StencilAttachmentFormat = formats.StencilAttachmentFormat;
+
+		for (const auto& [shaderPath, shaderStage] : pass.Shaders)
+		{
+			const PolyID      shaderID   = ShaderManager::CreateShader(shaderPath, shaderStage);
+			const ShaderData& shaderData = ShaderManager::GetShader(shaderID);
+
+			if (shaderStage == FShaderStage::VERTEX)
+				desc.pVertexShader = shaderData.pShader.get();
+			else if (shaderStage == FShaderStage::FRAGMENT)
+				desc.pFragmentShader = shaderData.pShader.get();
+		}
+
+		return RenderAPI::CreateGraphicsPipeline(&desc);
+	}
+
+	EFormat RenderProgram::GetGraphOwnedFormat(const ResolvedPort& port)
+	{
+		// TODO: IResourceDeclaration has no format setter yet (only WithSize/WithType/WithInitialState) -
+		// default until it does; only affects graph-owned internal resources, not externally-supplied ones.
+		const bool isDepthSemantic = port.ResolvedName == "$Depth" || port.ResolvedName == "$Stencil";
+		return isDepthSemantic ? EFormat::D24_UNORM_S8_UINT : EFormat::R8G8B8A8_UNORM;
+	}
+
+	void RenderProgram::PrecompilePass(size_t passIndex, EFormat targetFormat)
+	{
+		const ResolvedPass& pass        = m_Passes[passIndex];
+		PrecompiledPass&    precompiled = m_Precompiled[passIndex];
+
+		precompiled.Layout = CreatePipelineLayout(pass);
+
+		// Same formats RenderProgramInstance::GetPortFormat() will see at record time, as far as they can be known now
+		bool formatsKnown = true;
+		for (const ResolvedPort& port : pass.Ports)
+		{
+			if (!port.IsWrite)
+				continue;
+
+			if (port.ResolvedName == "$Color")
+			{
+				precompiled.Formats.ColorAttachmentFormats.push_back(targetFormat);
+			}
+			else if (port.ResolvedName == "$Depth" || port.ResolvedName == "$Stencil")
+			{
+				formatsKnown &= !port.IsExternal;
+
+				EFormat& format = port.ResolvedName == "$Depth" ? precompiled.Formats.DepthAttachmentFormat : precompiled.Formats.StencilAttachmentFormat;
+				format          = GetGraphOwnedFormat(port);
+			}
+		}
+
+		if (formatsKnown)
+			precompiled.Pipeline = CreatePipeline(pass, precompiled.Layout.get(), precompiled.Formats);
+
+		m_PrecompiledPassCount.fetch_add(1, std::memory_order_relaxed);
+	}
 } // namespace Poly
@@ -1,11 +1,14 @@
 #pragma once
 
+#include "Platform/API/ComputePipeline.h"
 #include "Platform/API/GraphicsPipeline.h"
+#include "Poly/Core/Job.h"
 #include "Poly/RenderGraph/Resource/ResourceState.h"
 #include "Poly/RenderGraph/Resource/ResourceType.h"
 #include "Poly/RenderGraph/SyncPlan.h"
 #include "Poly/Rendering/Core/API/GraphicsTypes.h"
 
+#include <atomic>
 #include <functional>
 #include <string>
 #include <vector>
@@ -13,6 +16,7 @@
 namespace Poly
 {
 	class ExecuteContext;
+	class PipelineLayout;
 
 	struct ResolvedPort
 	{
@@ -55,7 +59,12 @@ namespace Poly
 		GraphicsPipelineDesc                              PipelineDesc;
 		std::function<void(ExecuteContext&)>              ExecuteFn;
 
-		FQueueType Queue = FQueueType::GRAPHICS;
+		FQueueType    Queue             = FQueueType::GRAPHICS;
+		EPipelineType PipelineType      = EPipelineType::GRAPHICS; // COMPUTE = dispatched outside a rendering scope, PipelineDesc unused
+		bool          ParallelRecording = false;                   // draws go through ExecuteContext::RecordParallel() into secondary command buffers
+
+		bool         IsCompute() const { return PipelineType == EPipelineType::COMPUTE; }
+		FShaderStage GetPushConstantStages() const { return IsCompute() ? FShaderStage::COMPUTE : FShaderStage::VERTEX | FShaderStage::FRAGMENT; }
 
 		std::vector<ResolvedSlot> BufferSlots;
 		std::vector<ResolvedSlot> TextureSlots;
@@ -64,16 +73,101 @@ namespace Poly
 		uint32                    PushConstantSize   = 0;
 	};
 
+	// Lifetime of a graph-owned texture (one the RenderProgramInstance allocates itself) within the sorted
+	// pass list. Transients whose lifetimes don't overlap are put in the same alias slot and share one
+	// memory allocation at runtime - see RenderProgramBuilder::AnalyzeTransientLifetimes().
+	struct TransientLifetime
+	{
+		static constexpr uint32 NO_ALIAS_SLOT = ~0u;
+
+		std::string ResolvedName;
+		size_t      FirstPass = 0;
+		size_t      LastPass  = 0;
+		uint32      AliasSlot = NO_ALIAS_SLOT; // NO_ALIAS_SLOT = gets its own allocation
+	};
+
+	// The dynamic-rendering attachment formats a pass's pipeline is compiled against
+	struct PassAttachmentFormats
+	{
+		std::vector<EFormat> ColorAttachmentFormats;
+		EFormat              DepthAttachmentFormat   = EFormat::UNDEFINED;
+		EFormat              StencilAttachmentFormat = EFormat::UNDEFINED;
+
+		bool operator==(const PassAttachmentFormats& other) const = default;
+	};
+
 	class RenderProgram
 	{
 	public:
-		explicit RenderProgram(std::vector<ResolvedPass> sortedPasses, SyncPlan syncPlan);
-
-		const std::vector<ResolvedPass>& GetPasses() const { return m_Passes; }
-		const SyncPlan&                  GetSyncPlan() const { return m_SyncPlan; }
+		explicit RenderProgram(std::vector<ResolvedPass> sortedPasses, SyncPlan syncPlan, std::vector<TransientLifetime> transients = {});
+		~RenderProgram();
+		CLASS_REMOVE_COPY(RenderProgram);
+
+		const std::vector<ResolvedPass>&      GetPasses() const { return m_Passes; }
+		const SyncPlan&                       GetSyncPlan() const { return m_SyncPlan; }
+		const std::vector<TransientLifetime>& GetTransients() const { return m_Transients; }
+		uint32                                GetAliasSlotCount() const { return m_AliasSlotCount; }
+
+		/**
+		 * @return The transient's lifetime/alias slot, nullptr if resolvedName isn't a graph-owned texture
+		 */
+		const TransientLifetime* FindTransient(std::string_view resolvedName) const;
+
+		/**
+		 * Starts compiling every pass's pipeline layout and pipeline on the ThreadPool, so the first frame
+		 * that executes the program doesn't have to. A pass whose attachments can't be known up front (an
+		 * externally supplied attachment) only gets its layout here - its pipeline is still created on first use.
+		 * Does nothing if compilation has already been started.
+		 * @param targetFormat - Format "$Color" will resolve to (the format of the RenderView targets)
+		 */
+		void PrecompilePipelines(EFormat targetFormat);
+
+		/**
+		 * @return true once every job started by PrecompilePipelines() has finished, or if it was never called
+		 */
+		bool ArePipelinesReady() const { return m_PipelinesCompiled.IsDone(); }
+
+		/**
+		 * @return Fraction [0, 1] of the passes PrecompilePipelines() has finished, for showing a loading state
+		 */
+		float GetPipelineCompileProgress() const;
+
+		/**
+		 * Precompiled layout for a pass. Waits for precompilation to finish if it's still running.
+		 * @return nullptr if PrecompilePipelines() was never called
+		 */
+		Ref<PipelineLayout> GetPrecompiledLayout(size_t passIndex) const;
+
+		/**
+		 * Precompiled pipeline for a pass, if it was compiled for exactly these attachment formats (always empty
+		 * for a compute pass). Waits for precompilation to finish if it's still running.
+		 * @return nullptr if there is no matching precompiled pipeline - the caller creates its own
+		 */
+		Ref<Pipeline> GetPrecompiledPipeline(size_t passIndex, const PassAttachmentFormats& formats) const;
+
+		static Ref<PipelineLayout> CreatePipelineLayout(const ResolvedPass& pass);
+		static Ref<Pipeline>       CreatePipeline(const ResolvedPass& pass, PipelineLayout* pLayout, const PassAttachmentFormats& formats);
+
+		// Format of a texture the RenderProgramInstance allocates itself (a non-external port)
+		static EFormat GetGraphOwnedFormat(const ResolvedPort& port);
 
 	private:
-		std::vector<ResolvedPass> m_Passes;
-		SyncPlan                  m_SyncPlan;
+		struct PrecompiledPass
+		{
+			Ref<PipelineLayout>   Layout;
+			Ref<Poly::Pipeline>   Pipeline; // nullptr if the attachment formats couldn't be predicted
+			PassAttachmentFormats Formats;
+		};
+
+		void PrecompilePass(size_t passIndex, EFormat targetFormat);
+
+		std::vector<ResolvedPass>      m_Passes;
+		SyncPlan                       m_SyncPlan;
+		std::vector<TransientLifetime> m_Transients;
+		uint32                         m_AliasSlotCount = 0;
+
+		std::vector<PrecompiledPass> m_Precompiled; // indexed by pass index, empty until PrecompilePipelines()
+		mutable JobCounter           m_PipelinesCompiled;
+		std::atomic<uint32>          m_PrecompiledPassCount = 0;
 	};
 } // namespace Poly
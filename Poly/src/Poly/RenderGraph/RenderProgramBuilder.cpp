@@ -85,14 +85,29 @@ namespace Poly
 				pass->CallSetupFn(setupCtx);
 
 				ResolvedPass resolved;
-				resolved.Name         = passName;
-				resolved.Shaders      = pass->GetShaders();
-				resolved.PipelineDesc = pass->GetGraphicsPipeline().GetDesc();
-				resolved.ExecuteFn    = pass->GetExecuteFn();
-				resolved.Queue        = pass->GetQueue();
+				resolved.Name              = passName;
+				resolved.Shaders           = pass->GetShaders();
+				resolved.PipelineDesc      = pass->GetGraphicsPipeline().GetDesc();
+				resolved.ExecuteFn         = pass->GetExecuteFn();
+				resolved.Queue             = pass->GetQueue();
+				resolved.PipelineType      = pass->GetPipelineType();
+				resolved.ParallelRecording = pass->IsParallelRecording();
+
+				if (resolved.IsCompute() && resolved.ParallelRecording)
+				{
+					POLY_CORE_WARN("Pass '{}' is a compute pass; WithParallelRecording() only applies to draws and is ignored.", passName);
+					resolved.ParallelRecording = false;
+				}
 
 				for (const ResourceMapping& mapping : pass->GetResourceMappings())
 				{
+					if (resolved.IsCompute())
+					{
+						POLY_CORE_ERROR("Compute pass '{}' maps feature port '{}', but compute passes can't write attachments - skipping it.",
+						                passName, ToSemanticName(mapping.Port));
+						continue;
+					}
+
 					ResolvedPort port;
 					port.ShaderName     = mapping.ShaderResourceName;
 					port.ResolvedName   = std::string(ToSemanticName(mapping.Port));
@@ -101,8 +116,8 @@ namespace Poly
 					resolved.Ports.push_back(std::move(port));
 				}
 
-				for (const auto& [globalName, shaderName] : pass->GetGlobalMappings())
-					resolved.Ports.push_back({shaderName, globalName, /*IsWrite=*/false});
+				for (const GlobalMapping& mapping : pass->GetGlobalMappings())
+					resolved.Ports.push_back({mapping.ShaderGlobalName, mapping.GlobalName, mapping.IsWrite});
 
 				for (const auto& [resName, shaderName] : pass->GetImportedResources())
 					resolved.Ports.push_back({shaderName, scope + resName, /*IsWrite=*/false});
@@ -376,13 +391,143 @@ namespace Poly
 		}
 	}
 
-	// Phase 4: Plan explicit synchronization for the sorted pass list.
+	// Phase 4: Transient lifetime analysis & memory aliasing.
+	// Every graph-owned texture lives from the first to the last pass that touches it in the ALAP order.
+	// Transients whose lifetimes don't overlap are greedily packed into shared alias slots (interval
+	// partitioning, preferring a slot whose last occupant had the same size so slots don't have to grow);
+	// the RenderProgramInstance backs each slot with a single allocation sized for its largest member.
+	// Left out of aliasing (each still gets its own allocation):
+	//  - anything whose contents must survive between frames - first touched by a read or an explicit
+	//    LOAD, or with a declared initial/final state
+	//  - anything touched from more than one queue, since handing memory over between queues would need
+	//    a semaphore wait rather than a barrier
+	struct TransientUsage
+	{
+		size_t     FirstPass   = 0;
+		size_t     LastPass    = 0;
+		FQueueType Queue       = FQueueType::GRAPHICS;
+		bool       IsAliasable = false;
+		uint32     Width       = 0; // 0 = sized to the render target
+		uint32     Height      = 0;
+		EFormat    Format      = EFormat::UNDEFINED;
+	};
+
+	struct AliasSlotState
+	{
+		size_t     LastPass    = 0;
+		FQueueType Queue       = FQueueType::GRAPHICS;
+		uint32     Width       = 0;
+		uint32     Height      = 0;
+		EFormat    Format      = EFormat::UNDEFINED;
+		uint32     MemberCount = 0;
+	};
+
+	std::vector<TransientLifetime> RenderProgramBuilder::AnalyzeTransientLifetimes(const std::vector<ResolvedPass>& passes) const
+	{
+		std::vector<std::string>                        firstTouchOrder; // sorted by FirstPass, keeps slot assignment deterministic
+		std::unordered_map<std::string, TransientUsage> usages;
+
+		for (size_t i = 0; i < passes.size(); ++i)
+		{
+			for (const ResolvedPort& port : passes[i].Ports)
+			{
+				// Same set of resources RenderProgramInstance::ResolvePort() allocates itself
+				const bool isDepthSemantic = port.ResolvedName == "$Depth" || port.ResolvedName == "$Stencil";
+				if (port.IsExternal || port.ResolvedName == "$Color" || (!isDepthSemantic && !IsTextureResourceType(port.ResourceType)))
+					continue;
+
+				auto [it, isFirstTouch] = usages.try_emplace(port.ResolvedName);
+				TransientUsage& usage   = it->second;
+				if (isFirstTouch)
+				{
+					firstTouchOrder.push_back(port.ResolvedName);
+					usage.FirstPass   = i;
+					usage.Queue       = passes[i].Queue;
+					usage.Width       = port.Width;
+					usage.Height      = port.Height;
+					usage.Format      = RenderProgram::GetGraphOwnedFormat(port);
+					usage.IsAliasable = port.IsWrite && port.LoadOpOverride != ELoadOp::LOAD && port.InitialState == FResourceState::Unknown
+					                    && !m_FinalStates.contains(port.ResolvedName);
+				}
+
+				usage.LastPass = i;
+				usage.IsAliasable &= usage.Queue == passes[i].Queue;
+			}
+		}
+
+		std::vector<AliasSlotState>    slots;
+		std::vector<TransientLifetime> lifetimes;
+		lifetimes.reserve(firstTouchOrder.size());
+
+		for (const std::string& name : firstTouchOrder)
+		{
+			const TransientUsage& usage = usages[name];
+
+			TransientLifetime lifetime = {name, usage.FirstPass, usage.LastPass};
+			if (usage.IsAliasable)
+			{
+				uint32 best = TransientLifetime::NO_ALIAS_SLOT;
+				for (uint32 s = 0; s < static_cast<uint32>(slots.size()); ++s)
+				{
+					const AliasSlotState& slot = slots[s];
+					if (slot.Queue != usage.Queue || slot.LastPass >= usage.FirstPass)
+						continue; // still occupied
+
+					const bool isSameSize = slot.Width == usage.Width && slot.Height == usage.Height && slot.Format == usage.Format;
+					if (best == TransientLifetime::NO_ALIAS_SLOT || isSameSize)
+						best = s;
+					if (isSameSize)
+						break;
+				}
+
+				if (best == TransientLifetime::NO_ALIAS_SLOT)
+				{
+					best = static_cast<uint32>(slots.size());
+					slots.push_back({});
+				}
+
+				AliasSlotState& slot = slots[best];
+				slot.LastPass        = usage.LastPass;
+				slot.Queue           = usage.Queue;
+				slot.Width           = usage.Width;
+				slot.Height          = usage.Height;
+				slot.Format          = usage.Format;
+				slot.MemberCount++;
+				lifetime.AliasSlot = best;
+			}
+
+			lifetimes.push_back(std::move(lifetime));
+		}
+
+		// A slot nothing else moved into aliases nothing - give its one member a normal allocation, and
+		// compact the remaining slot indices
+		std::vector<uint32> remap(slots.size(), TransientLifetime::NO_ALIAS_SLOT);
+		uint32              slotCount = 0;
+		for (size_t s = 0; s < slots.size(); ++s)
+		{
+			if (slots[s].MemberCount > 1)
+				remap[s] = slotCount++;
+		}
+
+		for (TransientLifetime& lifetime : lifetimes)
+		{
+			if (lifetime.AliasSlot != TransientLifetime::NO_ALIAS_SLOT)
+				lifetime.AliasSlot = remap[lifetime.AliasSlot];
+		}
+
+		return lifetimes;
+	}
+
+	// Phase 5: Plan explicit synchronization for the sorted pass list.
 	// Tracks, per resolved resource name, the last known layout/access/stage/owning-queue and compares
 	// it against what each port needs. Same-queue transitions batch into one BarrierGroup per consuming
 	// pass (grouped syncs); a resource already in the required state produces no entry at all (indirect
 	// syncs). Cross-queue reads/writes are split into a Release (on the resource's previous owning pass)
 	// and an Acquire (on the consuming pass), paired via a SyncPoint wait whose value is collapsed to the
 	// highest value already awaited on that queue pair (cross-queue indirect sync elision).
+	// A transient sharing memory with others (see Phase 4) gets an aliasing barrier on its first use: the
+	// transition from UNDEFINED waits on the stages/accesses of the slot's previous occupant - for the
+	// slot's first occupant, that's its last one, from the previous frame.
 	// Inspiration source: "Organizing GPU Work with Directed Acyclic Graphs" by Pavlo Muratov https://levelup.gitconnected.com/organizing-gpu-work-with-directed-acyclic-graphs-f3fd5f2c2af3
 	struct ResourceTrackState
 	{
@@ -396,7 +541,14 @@ namespace Poly
 		size_t         LastPassIndex = 0;
 	};
 
-	SyncPlan RenderProgramBuilder::PlanSynchronization(const std::vector<ResolvedPass>& passes) const
+	struct AliasHandover
+	{
+		size_t      PassIndex = 0;
+		std::string ResolvedName;
+		std::string PreviousOccupant;
+	};
+
+	SyncPlan RenderProgramBuilder::PlanSynchronization(const std::vector<ResolvedPass>& passes, const std::vector<TransientLifetime>& transients) const
 	{
 		std::unordered_map<std::string, ResourceTrackState>                      state;
 		std::unordered_map<FQueueType, uint64_t>                                 queueSubmitCounter;
@@ -404,6 +556,24 @@ namespace Poly
 
 		std::vector<PassSyncPlan> passPlans(passes.size());
 
+		// Previous occupant of each aliased transient's memory (transients are sorted by first use)
+		std::unordered_map<std::string, std::string> previousOccupants;
+		{
+			std::unordered_map<uint32, std::vector<const TransientLifetime*>> slotMembers;
+			for (const TransientLifetime& transient : transients)
+			{
+				if (transient.AliasSlot != TransientLifetime::NO_ALIAS_SLOT)
+					slotMembers[transient.AliasSlot].push_back(&transient);
+			}
+
+			for (const auto& [slot, members] : slotMembers)
+			{
+				for (size_t m = 0; m < members.size(); ++m)
+					previousOccupants[members[m]->ResolvedName] = members[(m + members.size() - 1) % members.size()]->ResolvedName;
+			}
+		}
+		std::vector<AliasHandover> wrappedHandovers; // previous occupant only runs later in the program - patched once it has
+
 		for (size_t i = 0; i < passes.size(); ++i)
 		{
 			const ResolvedPass& pass  = passes[i];
@@ -450,6 +620,21 @@ namespace Poly
 						rs.Access                = seed.Access;
 						rs.Stage                 = seed.Stage;
 					}
+
+					// Aliasing barrier - the memory was last used by another transient, wait for it to be done
+					if (auto prevIt = previousOccupants.find(port.ResolvedName); prevIt != previousOccupants.end())
+					{
+						auto previous = state.find(prevIt->second);
+						if (previous != state.end() && previous->second.IsTracked)
+						{
+							rs.Access = previous->second.Access;
+							rs.Stage  = previous->second.Stage;
+						}
+						else
+						{
+							wrappedHandovers.push_back({i, port.ResolvedName, prevIt->second});
+						}
+					}
 				}
 
 				// Attachment load op: a pass declaration can force one explicitly (LoadOpOverride); otherwise
@@ -506,6 +691,19 @@ namespace Poly
 			}
 		}
 
+		for (const AliasHandover& handover : wrappedHandovers)
+		{
+			const ResourceTrackState& previous = state[handover.PreviousOccupant];
+			for (TextureTransitionPlan& transition : passPlans[handover.PassIndex].PreBarriers.Textures)
+			{
+				if (transition.ResolvedName != handover.ResolvedName)
+					continue;
+
+				transition.SrcAccess = previous.Access;
+				transition.SrcStage  = previous.Stage;
+			}
+		}
+
 		// Closing transitions: for each resolved name with a declared WithFinalState(), leave it in that
 		// state after its last use in the program (e.g. "$Color" -> Present)
 		for (const auto& [resolvedName, finalState] : m_FinalStates)
@@ -541,7 +739,8 @@ namespace Poly
 		auto nodes  = BuildDAG(flat);
 		auto sorted = TopoSortALAP(nodes, flat);
 		AssignBindlessSlots(sorted);
-		auto syncPlan = PlanSynchronization(sorted);
-		return CreateRef<RenderProgram>(std::move(sorted), std::move(syncPlan));
+		auto transients = AnalyzeTransientLifetimes(sorted);
+		auto syncPlan   = PlanSynchronization(sorted, transients);
+		return CreateRef<RenderProgram>(std::move(sorted), std::move(syncPlan), std::move(transients));
 	}
 } // namespace Poly
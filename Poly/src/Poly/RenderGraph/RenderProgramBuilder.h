@@ -43,12 +43,14 @@ namespace Poly
 		Ref<RenderProgram> Build();
 
 	private:
-		std::vector<ResolvedPass>    FlattenFeatures();
-		std::vector<struct PassNode> BuildDAG(const std::vector<ResolvedPass>& flat) const;
-		std::vector<ResolvedPass>    TopoSortALAP(const std::vector<struct PassNode>& nodes,
-		                                          const std::vector<ResolvedPass>&    flat) const;
-		void                         AssignBindlessSlots(std::vector<ResolvedPass>& passes) const;
-		SyncPlan                     PlanSynchronization(const std::vector<ResolvedPass>& passes) const;
+		std::vector<ResolvedPass>      FlattenFeatures();
+		std::vector<struct PassNode>   BuildDAG(const std::vector<ResolvedPass>& flat) const;
+		std::vector<ResolvedPass>      TopoSortALAP(const std::vector<struct PassNode>& nodes,
+		                                            const std::vector<ResolvedPass>&    flat) const;
+		void                           AssignBindlessSlots(std::vector<ResolvedPass>& passes) const;
+		std::vector<TransientLifetime> AnalyzeTransientLifetimes(const std::vector<ResolvedPass>& passes) const;
+		SyncPlan                       PlanSynchronization(const std::vector<ResolvedPass>&      passes,
+		                                                   const std::vector<TransientLifetime>& transients) const;
 
 		Ref<RenderCatalog>       m_Catalog;
 		std::vector<std::string> m_Features;
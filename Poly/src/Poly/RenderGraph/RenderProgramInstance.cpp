@@ -5,8 +5,10 @@
 #include "Platform/API/CommandBuffer.h"
 #include "Platform/API/CommandPool.h"
 #include "Platform/API/CommandQueue.h"
+#include "Platform/API/ComputePipeline.h"
 #include "Platform/API/DescriptorSet.h"
 #include "Platform/API/GraphicsPipeline.h"
+#include "Platform/API/MemoryBlock.h"
 #include "Platform/API/PipelineLayout.h"
 #include "Platform/API/Sampler.h"
 #include "Platform/API/SyncPoint.h"
@@ -14,16 +16,18 @@
 #include "Platform/API/TextureView.h"
 #include "Poly/Core/RenderAPI.h"
 #include "Poly/Core/ThreadPool.h"
-#include "Poly/Resources/Shader/ShaderManager.h"
 #include "RenderView.h"
 #include "Resource/ResourceUsage.h"
 
+#include <algorithm>
 #include <cstring>
+#include <unordered_set>
 
 namespace Poly
 {
 	RenderProgramInstance::RenderProgramInstance(Ref<RenderProgram> pRenderProgram)
 	    : m_pRenderProgram(std::move(pRenderProgram))
+	    , m_AliasSlots(m_pRenderProgram->GetAliasSlotCount())
 	{}
 
 	void RenderProgramInstance::Execute(const RenderView& view)
@@ -40,19 +44,33 @@ namespace Poly
 		const auto& passes    = m_pRenderProgram->GetPasses();
 		const auto& passPlans = m_pRenderProgram->GetSyncPlan().GetPassPlans();
 
-		// Phase A: parallel recording
-		std::vector<std::function<void()>> tasks;
-		tasks.reserve(passes.size());
+		// Phase A: parallel recording. Each pass signals its own counter instead of joining on all of them,
+		// so Phase B can build the frame's submits while the passes are still being recorded.
 		for (size_t i = 0; i < passes.size(); i++)
-			tasks.push_back([this, i, &view]() { RecordPass(i, view); });
+			ThreadPool::Submit([this, i, &view]() { RecordPass(i, view); }, m_PassResources[i].pRecorded.get());
+
+		// Phase B: batch submits per queue, in program order. Vulkan requires submission order to a queue
+		// to match what SyncPlan assumed (same-queue barriers rely on prior work already being enqueued;
+		// SubmissionIndex is defined as position within a queue's submission order) - a sequential pass over
+		// the program-ordered list gives every queue its submissions in order for free.
+		//
+		// Consecutive passes on the same queue share one batch as long as the later pass has nothing to wait
+		// on (a batch's waits all happen before its first command buffer). Only a batch's last pass signals -
+		// timeline waits are >=, so anyone waiting on an earlier pass in it is released at the batch's end.
+		for (FQueueType queue : m_SubmitQueueOrder)
+			m_QueueSubmits[queue].Count = 0;
+		m_SubmitQueueOrder.clear();
+		m_FrameSubmits.clear();
 
-		ThreadPool::SubmitAndWait(tasks);
-
-		// Phase B: sequential per-queue submit, in program order. Vulkan requires submission order to a
-		// queue to match what SyncPlan assumed (same-queue barriers rely on prior work already being
-		// enqueued; SubmissionIndex is defined as position within a queue's submission order) - a plain
-		// sequential pass over the program-ordered list gives every queue its submissions in order for free.
 		std::unordered_map<FQueueType, uint64> highestSubmissionIndexThisFrame;
+		SubmitDesc*                            pOpenSubmit = nullptr;
+		FQueueType                             openQueue   = FQueueType::NONE;
+
+		// Textures read through the bindless heap (materials') aren't bound to any port - every queue's first
+		// batch waits for all textures uploaded so far instead, in every instance (free once it's been reached)
+		SyncPointValue                 textureUploadWait = {};
+		const bool                     hasTextureUpload  = ResourceManager::GetTextureUploadSync(&textureUploadWait.pSyncPoint, &textureUploadWait.Value);
+		std::unordered_set<FQueueType> textureUploadWaited;
 		for (size_t i = 0; i < passes.size(); i++)
 		{
 			const ResolvedPass& pass            = passes[i];
@@ -60,14 +78,16 @@ namespace Poly
 			SyncPoint*          pQueueSyncPoint = GetOrCreateQueueSyncPoint(pass.Queue);
 			const uint64        base            = m_QueueTimelineBase[pass.Queue];
 
-			SubmitDesc submitDesc     = {};
-			submitDesc.CommandBuffers = {GetCommandBuffer(i)};
+			m_PassWaits.clear();
 			for (const auto& [srcQueue, waitValue] : plan.RequiredWaits)
 			{
 				SyncPoint* pSrcSyncPoint = GetOrCreateQueueSyncPoint(srcQueue);
-				submitDesc.WaitSyncPoints.push_back({pSrcSyncPoint, m_QueueTimelineBase[srcQueue] + waitValue});
+				m_PassWaits.push_back({pSrcSyncPoint, m_QueueTimelineBase[srcQueue] + waitValue});
 			}
 
+			if (hasTextureUpload && textureUploadWaited.insert(pass.Queue).second)
+				m_PassWaits.push_back(textureUploadWait);
+
 			// Acquire any pending uploads for each port resource, handles upload sync and queue acqusition.
 			for (const ResolvedPort& port : pass.Ports)
 			{
@@ -80,19 +100,60 @@ namespace Poly
 				const bool hasPendingUpload = pRes->IsTexture() ? ResourceManager::ConsumePendingUploadSync(pRes->TexHandle, &pUploadSyncPoint, &uploadValue)
 				                                                : ResourceManager::ConsumePendingUploadSync(pRes->BufHandle, &pUploadSyncPoint, &uploadValue);
 				if (hasPendingUpload)
-					submitDesc.WaitSyncPoints.push_back({pUploadSyncPoint, uploadValue});
+					m_PassWaits.push_back({pUploadSyncPoint, uploadValue});
 			}
 
-			const uint64 signalValue    = base + plan.SubmissionIndex;
-			submitDesc.SignalSyncPoints = {{pQueueSyncPoint, signalValue}};
+			if (!pOpenSubmit || openQueue != pass.Queue || !m_PassWaits.empty())
+			{
+				pOpenSubmit                 = &BeginQueueSubmit(pass.Queue);
+				pOpenSubmit->WaitSyncPoints = m_PassWaits;
+				openQueue                   = pass.Queue;
+				m_FrameSubmits.push_back({pass.Queue, m_QueueSubmits[pass.Queue].Count - 1, i});
+			}
+			m_FrameSubmits.back().LastPass = i;
 
-			RenderAPI::GetCommandQueue(pass.Queue)->Submit(submitDesc);
+			const uint64 signalValue = base + plan.SubmissionIndex;
+			pOpenSubmit->CommandBuffers.push_back(GetCommandBuffer(i));
+			pOpenSubmit->SignalSyncPoints.clear();
+			pOpenSubmit->SignalSyncPoints.push_back({pQueueSyncPoint, signalValue});
 
 			uint64& highest                                = highestSubmissionIndexThisFrame[pass.Queue];
 			highest                                        = std::max(highest, plan.SubmissionIndex);
 			m_FrameReclaimValues[m_FrameIndex][pass.Queue] = signalValue;
 		}
 
+		// Phase C: submit as recording finishes. Walking the submits in program order keeps every queue's submission
+		// order, and each one goes out as soon as its own passes are recorded - together with the submits after it on
+		// the same queue whose passes are already done, so a frame recorded faster than it's submitted still makes one
+		// driver submission per queue. A queue may be handed a wait on another queue's timeline value before that
+		// queue's submit is made - fine for timeline semaphores, the signal follows. Every pass belongs to a submit,
+		// so every pass's counter is waited on here and nothing recorded outlives the view.
+		size_t nextPass = 0;
+		for (size_t first = 0; first < m_FrameSubmits.size();)
+		{
+			const FQueueType queue = m_FrameSubmits[first].Queue;
+			for (; nextPass <= m_FrameSubmits[first].LastPass; nextPass++)
+				ThreadPool::Wait(*m_PassResources[nextPass].pRecorded);
+
+			size_t end = first + 1;
+			while (end < m_FrameSubmits.size() && m_FrameSubmits[end].Queue == queue)
+			{
+				bool isRecorded = true;
+				for (size_t i = nextPass; i <= m_FrameSubmits[end].LastPass && isRecorded; i++)
+					isRecorded = m_PassResources[i].pRecorded->IsDone();
+
+				if (!isRecorded)
+					break;
+
+				nextPass = m_FrameSubmits[end].LastPass + 1;
+				end++;
+			}
+
+			const QueueSubmitBatch& batch = m_QueueSubmits[queue];
+			RenderAPI::GetCommandQueue(queue)->SubmitBatch(&batch.Submits[m_FrameSubmits[first].SubmitIndex], static_cast<uint32>(end - first));
+			first = end;
+		}
+
 		for (const auto& [queue, count] : highestSubmissionIndexThisFrame)
 			m_QueueTimelineBase[queue] += count;
 
@@ -129,7 +190,20 @@ namespace Poly
 			{
 				res.CommandPools[f]   = RenderAPI::CreateCommandPool(passes[i].Queue, FCommandPoolFlags::RESET_COMMAND_BUFFERS);
 				res.CommandBuffers[f] = res.CommandPools[f]->AllocateCommandBuffer(ECommandBufferLevel::PRIMARY);
+
+				if (!passes[i].ParallelRecording)
+					continue;
+
+				// One more than the worker count so the recording thread, which helps while it waits, gets a buffer too
+				const uint32 secondaryCount = std::min(ThreadPool::GetWorkerCount() + 1, MAX_SECONDARY_COMMAND_BUFFERS);
+				for (uint32 slot = 0; slot < secondaryCount; slot++)
+				{
+					Ref<CommandPool> pPool = RenderAPI::CreateCommandPool(passes[i].Queue, FCommandPoolFlags::RESET_COMMAND_BUFFERS);
+					res.SecondaryCommandBuffers[f].push_back(pPool->AllocateCommandBuffer(ECommandBufferLevel::SECONDARY));
+					res.SecondaryCommandPools[f].push_back(std::move(pPool));
+				}
 			}
+			res.pRecorded = CreateUnique<JobCounter>();
 		}
 	}
 
@@ -141,9 +215,20 @@ namespace Poly
 
 	void RenderProgramInstance::ResizeSizedToTargetResources(const RenderView& view)
 	{
+		const uint32 targetWidth  = view.pTarget->GetTexture()->GetDesc().Width;
+		const uint32 targetHeight = view.pTarget->GetTexture()->GetDesc().Height;
+
+		// Aliased transients are re-placed as a whole slot, the block's size depends on all of them
+		for (uint32 slotIndex = 0; slotIndex < m_AliasSlots.size(); slotIndex++)
+		{
+			const AliasSlotMemory& slot = m_AliasSlots[slotIndex];
+			if (slot.HasSizedToTargetMembers && (slot.TargetWidth != targetWidth || slot.TargetHeight != targetHeight))
+				AllocateAliasSlot(slotIndex, view);
+		}
+
 		for (auto& [name, res] : m_Resources)
 		{
-			if (!res.IsSizedToTarget || res.IsBuffer())
+			if (!res.IsSizedToTarget || res.IsBuffer() || res.AliasSlot != TransientLifetime::NO_ALIAS_SLOT)
 				continue;
 
 			TextureDesc desc = ResourceManager::Resolve(res.TexHandle)->GetDesc();
@@ -159,6 +244,23 @@ namespace Poly
 		}
 	}
 
+	SubmitDesc& RenderProgramInstance::BeginQueueSubmit(FQueueType queue)
+	{
+		QueueSubmitBatch& batch = m_QueueSubmits[queue];
+		if (batch.Count == 0)
+			m_SubmitQueueOrder.push_back(queue);
+
+		// Recycle last frame's SubmitDescs in place so their vectors keep their capacity
+		if (batch.Count == batch.Submits.size())
+			batch.Submits.emplace_back();
+
+		SubmitDesc& submitDesc = batch.Submits[batch.Count++];
+		submitDesc.CommandBuffers.clear();
+		submitDesc.WaitSyncPoints.clear();
+		submitDesc.SignalSyncPoints.clear();
+		return submitDesc;
+	}
+
 	SyncPoint* RenderProgramInstance::GetOrCreateQueueSyncPoint(FQueueType queue)
 	{
 		auto it = m_QueueSyncPoints.find(queue);
@@ -177,21 +279,10 @@ namespace Poly
 		if (res.Layout)
 			return res.Layout.get();
 
-		const ResolvedPass& pass = m_pRenderProgram->GetPasses()[passIndex];
-
-		PipelineLayoutDesc desc   = {};
-		desc.DescriptorSetLayouts = {ResourceManager::GetSetLayoutDesc()}; // set 0 - shared bindless heap
-
-		if (pass.PushConstantSize > 0)
-		{
-			PushConstantRange range = {};
-			range.ShaderStage       = FShaderStage::VERTEX | FShaderStage::FRAGMENT;
-			range.Offset            = 0;
-			range.Size              = pass.PushConstantSize;
-			desc.PushConstantRanges.push_back(range);
-		}
+		res.Layout = m_pRenderProgram->GetPrecompiledLayout(passIndex);
+		if (!res.Layout)
+			res.Layout = RenderProgram::CreatePipelineLayout(m_pRenderProgram->GetPasses()[passIndex]);
 
-		res.Layout = RenderAPI::CreatePipelineLayout(&desc);
 		return res.Layout.get();
 	}
 
@@ -204,7 +295,7 @@ namespace Poly
 		return (pRes && pRes->IsTexture()) ? ResourceManager::Resolve(pRes->TexHandle)->GetDesc().Format : EFormat::UNDEFINED;
 	}
 
-	GraphicsPipeline* RenderProgramInstance::GetOrCreatePipeline(size_t passIndex, const RenderView& view)
+	Pipeline* RenderProgramInstance::GetOrCreatePipeline(size_t passIndex, const RenderView& view)
 	{
 		PerPassResources& res = m_PassResources[passIndex];
 		if (res.Pipeline)
@@ -212,35 +303,26 @@ namespace Poly
 
 		const ResolvedPass& pass = m_pRenderProgram->GetPasses()[passIndex];
 
-		GraphicsPipelineDesc desc = pass.PipelineDesc;
-		desc.pPipelineLayout      = GetOrCreatePipelineLayout(passIndex);
-		desc.pRenderPass          = nullptr; // dynamic rendering - no VkRenderPass/Framebuffer
-
+		PassAttachmentFormats formats;
 		for (const ResolvedPort& port : pass.Ports)
 		{
 			if (!port.IsWrite)
 				continue;
 
 			if (port.ResolvedName == "$Color")
-				desc.ColorAttachmentFormats.push_back(GetPortFormat(port, view));
+				formats.ColorAttachmentFormats.push_back(GetPortFormat(port, view));
 			else if (port.ResolvedName == "$Depth")
-				desc.DepthAttachmentFormat = GetPortFormat(port, view);
+				formats.DepthAttachmentFormat = GetPortFormat(port, view);
 			else if (port.ResolvedName == "$Stencil")
-				desc.StencilAttachmentFormat = GetPortFormat(port, view);
+				formats.StencilAttachmentFormat = GetPortFormat(port, view);
 		}
 
-		for (const auto& [shaderPath, shaderStage] : pass.Shaders)
-		{
-			const PolyID      shaderID   = ShaderManager::CreateShader(shaderPath, shaderStage);
-			const ShaderData& shaderData = ShaderManager::GetShader(shaderID);
-
-			if (shaderStage == FShaderStage::VERTEX)
-				desc.pVertexShader = shaderData.pShader.get();
-			else if (shaderStage == FShaderStage::FRAGMENT)
-				desc.pFragmentShader = shaderData.pShader.get();
-		}
+		// Normally compiled ahead of time (see Renderer::SetRenderProgram) - only falls back to compiling
+		// here, on the recording thread, if the attachments didn't turn out as predicted.
+		res.Pipeline = m_pRenderProgram->GetPrecompiledPipeline(passIndex, formats);
+		if (!res.Pipeline)
+			res.Pipeline = RenderProgram::CreatePipeline(pass, GetOrCreatePipelineLayout(passIndex), formats);
 
-		res.Pipeline = RenderAPI::CreateGraphicsPipeline(&desc);
 		return res.Pipeline.get();
 	}
 
@@ -274,28 +356,115 @@ namespace Poly
 			return nullptr;
 		}
 
+		// Shares its memory with other transients - allocate the whole alias slot at once, since the block
+		// has to be sized for every member before any of them can be placed in it
+		const TransientLifetime* pTransient = m_pRenderProgram->FindTransient(port.ResolvedName);
+		if (pTransient && pTransient->AliasSlot != TransientLifetime::NO_ALIAS_SLOT)
+		{
+			AllocateAliasSlot(pTransient->AliasSlot, view);
+			it = m_Resources.find(port.ResolvedName);
+			return it != m_Resources.end() ? &it->second : nullptr;
+		}
+
 		// Graph-owned texture: allocate now, sized either explicitly (WithSize()) or to the render target.
-		const bool   isSizedToTarget = (port.Width == 0 || port.Height == 0);
-		const uint32 width           = port.Width != 0 ? port.Width : (view.pTarget ? view.pTarget->GetTexture()->GetWidth() : 0);
-		const uint32 height          = port.Height != 0 ? port.Height : (view.pTarget ? view.pTarget->GetTexture()->GetHeight() : 0);
-
-		// TODO: IResourceDeclaration has no format setter yet (only WithSize/WithType/WithInitialState) -
-		// default until it does; only affects graph-owned internal resources, not externally-supplied ones.
-		const EFormat       format = isDepthSemantic ? EFormat::D24_UNORM_S8_UINT : EFormat::R8G8B8A8_UNORM;
-		const FTextureUsage usage  = isDepthSemantic ? FTextureUsage::DEPTH_STENCIL_ATTACHMENT | FTextureUsage::SAMPLED
-		                                             : FTextureUsage::SAMPLED | (port.ResourceType == EResourceType::StorageImage
-		                                                                             ? FTextureUsage::STORAGE
-		                                                                             : FTextureUsage::COLOR_ATTACHMENT);
+		const GraphOwnedTexture texture = GetGraphOwnedTexture(port, view);
 
 		RuntimeResource res;
-		res.TexHandle       = ResourceManager::CreateTexture2D(width, height, format, usage, port.ResolvedName);
+		res.TexHandle       = ResourceManager::CreateTexture2D(texture.Width, texture.Height, texture.Format, texture.Usage, port.ResolvedName);
 		res.SamplerHnd      = ResourceManager::GetDefaultLinearSampler();
-		res.IsSizedToTarget = isSizedToTarget;
+		res.IsSizedToTarget = texture.IsSizedToTarget;
 
 		auto [insertedIt, inserted] = m_Resources.emplace(port.ResolvedName, std::move(res));
 		return &insertedIt->second;
 	}
 
+	RenderProgramInstance::GraphOwnedTexture RenderProgramInstance::GetGraphOwnedTexture(const ResolvedPort& port, const RenderView& view)
+	{
+		const bool isDepthSemantic = port.ResolvedName == "$Depth" || port.ResolvedName == "$Stencil";
+
+		GraphOwnedTexture texture;
+		texture.IsSizedToTarget = (port.Width == 0 || port.Height == 0);
+		texture.Width           = port.Width != 0 ? port.Width : (view.pTarget ? view.pTarget->GetTexture()->GetWidth() : 0);
+		texture.Height          = port.Height != 0 ? port.Height : (view.pTarget ? view.pTarget->GetTexture()->GetHeight() : 0);
+		texture.Format          = RenderProgram::GetGraphOwnedFormat(port);
+		texture.Usage           = isDepthSemantic ? FTextureUsage::DEPTH_STENCIL_ATTACHMENT | FTextureUsage::SAMPLED
+		                                          : FTextureUsage::SAMPLED | (port.ResourceType == EResourceType::StorageImage
+		                                                                          ? FTextureUsage::STORAGE
+		                                                                          : FTextureUsage::COLOR_ATTACHMENT);
+		return texture;
+	}
+
+	void RenderProgramInstance::AllocateAliasSlot(uint32 slotIndex, const RenderView& view)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_ResourcesMutex);
+
+		struct Member
+		{
+			const std::string* pName = nullptr;
+			GraphOwnedTexture  Texture;
+		};
+
+		std::vector<Member> members;
+		MemoryRequirements  requirements = {};
+		requirements.MemoryTypeBits      = ~0u;
+
+		AliasSlotMemory& slot        = m_AliasSlots[slotIndex];
+		slot.HasSizedToTargetMembers = false;
+
+		for (const TransientLifetime& transient : m_pRenderProgram->GetTransients())
+		{
+			if (transient.AliasSlot != slotIndex)
+				continue;
+
+			// The first touch is the write that defines the texture, same port ResolvePort() would have seen first
+			const auto& ports = m_pRenderProgram->GetPasses()[transient.FirstPass].Ports;
+			auto        port  = std::find_if(ports.begin(), ports.end(), [&](const ResolvedPort& p) { return p.ResolvedName == transient.ResolvedName; });
+
+			Member member = {&transient.ResolvedName, GetGraphOwnedTexture(*port, view)};
+
+			const MemoryRequirements memberRequirements = ResourceManager::GetTexture2DMemoryRequirements(
+			    member.Texture.Width, member.Texture.Height, member.Texture.Format, member.Texture.Usage);
+			requirements.Size            = std::max(requirements.Size, memberRequirements.Size);
+			requirements.Alignment       = std::max(requirements.Alignment, memberRequirements.Alignment);
+			requirements.MemoryTypeBits &= memberRequirements.MemoryTypeBits;
+
+			slot.HasSizedToTargetMembers |= member.Texture.IsSizedToTarget;
+			members.push_back(member);
+		}
+
+		if (requirements.MemoryTypeBits != 0)
+		{
+			MemoryBlockDesc desc = {};
+			desc.Requirements    = requirements;
+			desc.MemoryUsage     = EMemoryUsage::GPU_ONLY;
+			desc.DebugName       = "Transient alias slot " + std::to_string(slotIndex);
+			slot.pMemory         = RenderAPI::CreateMemoryBlock(&desc);
+		}
+		else
+		{
+			// Can happen when e.g. a depth and a color target end up in the same slot on hardware that keeps them in different heaps
+			POLY_CORE_WARN("Transients in alias slot {} have no memory type in common, allocating them separately", slotIndex);
+			slot.pMemory = nullptr;
+		}
+
+		slot.TargetWidth  = view.pTarget ? view.pTarget->GetTexture()->GetWidth() : 0;
+		slot.TargetHeight = view.pTarget ? view.pTarget->GetTexture()->GetHeight() : 0;
+
+		for (const Member& member : members)
+		{
+			const GraphOwnedTexture& texture = member.Texture;
+
+			RuntimeResource& res = m_Resources[*member.pName];
+			if (res.TexHandle.IsValid())
+				ResourceManager::Destroy(res.TexHandle); // re-placed after a resize - the old texture keeps the old block alive until it's destroyed
+
+			res.TexHandle       = ResourceManager::CreateTexture2D(texture.Width, texture.Height, texture.Format, texture.Usage, *member.pName, slot.pMemory);
+			res.SamplerHnd      = ResourceManager::GetDefaultLinearSampler();
+			res.IsSizedToTarget = texture.IsSizedToTarget;
+			res.AliasSlot       = slotIndex;
+		}
+	}
+
 	Texture* RenderProgramInstance::GetTextureForBarrier(const std::string& resolvedName, const RenderView& view)
 	{
 		if (resolvedName == "$Color")
@@ -499,6 +668,23 @@ namespace Poly
 
 		ApplyBarrierGroup(pCmd, plan.PreBarriers, view);
 
+		if (pass.IsCompute())
+			RecordComputePass(pCmd, passIndex, view);
+		else
+			RecordGraphicsPass(pCmd, passIndex, plan, view);
+
+		for (const QueueReleasePlan& release : plan.PostReleases)
+			ApplyRelease(pCmd, release, pass.Queue, view);
+
+		ApplyBarrierGroup(pCmd, plan.PostBarriers, view);
+
+		pCmd->End();
+	}
+
+	void RenderProgramInstance::RecordGraphicsPass(CommandBuffer* pCmd, size_t passIndex, const PassSyncPlan& plan, const RenderView& view)
+	{
+		const ResolvedPass& pass = m_pRenderProgram->GetPasses()[passIndex];
+
 		// Dynamic rendering: gather this pass's write ports into color/depth/stencil attachments.
 		// Only $Color/$Depth/$Stencil are supported as attachments today - PassDeclaration's
 		// MapResource() only exposes those three feature ports, so there's no MRT case to handle yet.
@@ -572,43 +758,106 @@ namespace Poly
 		renderingDesc.ColorAttachments   = colorAttachments;
 		renderingDesc.pDepthAttachment   = hasDepth ? &depthAttachmentInfo : nullptr;
 		renderingDesc.pStencilAttachment = hasStencil ? &stencilAttachmentInfo : nullptr;
+		renderingDesc.SecondaryContents  = pass.ParallelRecording;
 
 		pCmd->BeginRendering(&renderingDesc);
 
-		GraphicsPipeline* pPipeline = GetOrCreatePipeline(passIndex, view);
-		pCmd->BindPipeline(pPipeline);
+		Pipeline*       pPipeline = GetOrCreatePipeline(passIndex, view);
+		PipelineLayout* pLayout   = GetOrCreatePipelineLayout(passIndex);
 
-		ViewportDesc viewport = {};
-		viewport.Width        = static_cast<float>(width);
-		viewport.Height       = static_cast<float>(height);
-		pCmd->SetViewport(&viewport);
+		std::vector<byte> pushData;
+		if (pass.PushConstantSize > 0)
+			BuildPushConstants(passIndex, pushData);
 
-		ScissorDesc scissor = {};
-		scissor.Width       = width;
-		scissor.Height      = height;
-		pCmd->SetScissor(&scissor);
+		if (!pass.ParallelRecording)
+		{
+			BindPassState(pCmd, pPipeline, pLayout, width, height, pushData);
 
-		pCmd->BindDescriptor(pPipeline, ResourceManager::GetDescriptorSet());
+			ExecuteContext ctx(pCmd, view, pLayout, pass.TextureSlotsOffset, pass.GetPushConstantStages());
+			if (pass.ExecuteFn)
+				pass.ExecuteFn(ctx);
+		}
+		else
+		{
+			// Secondaries inherit the attachment formats and nothing else - each one re-binds the pass state itself
+			RenderingInheritanceDesc inheritance = {};
+			inheritance.ViewMask                 = renderingDesc.ViewMask;
+			for (const ResolvedPort& port : pass.Ports)
+			{
+				if (!port.IsWrite)
+					continue;
 
+				if (port.ResolvedName == "$Color")
+					inheritance.ColorAttachmentFormats.push_back(GetPortFormat(port, view));
+				else if (port.ResolvedName == "$Depth")
+					inheritance.DepthAttachmentFormat = GetPortFormat(port, view);
+				else if (port.ResolvedName == "$Stencil")
+					inheritance.StencilAttachmentFormat = GetPortFormat(port, view);
+			}
+
+			const std::vector<CommandBuffer*>& secondaries = m_PassResources[passIndex].SecondaryCommandBuffers[m_FrameIndex];
+
+			ParallelRecordingDesc parallelDesc = {};
+			parallelDesc.ppSecondaryBuffers    = secondaries.data();
+			parallelDesc.SecondaryBufferCount  = static_cast<uint32>(secondaries.size());
+			parallelDesc.pInheritance          = &inheritance;
+			parallelDesc.BindPassState         = [&](CommandBuffer* pSecondary) { BindPassState(pSecondary, pPipeline, pLayout, width, height, pushData); };
+
+			ExecuteContext ctx(pCmd, view, pLayout, pass.TextureSlotsOffset, pass.GetPushConstantStages(), &parallelDesc);
+			if (pass.ExecuteFn)
+				pass.ExecuteFn(ctx);
+		}
+
+		pCmd->EndRendering();
+	}
+
+	void RenderProgramInstance::RecordComputePass(CommandBuffer* pCmd, size_t passIndex, const RenderView& view)
+	{
+		const ResolvedPass& pass = m_pRenderProgram->GetPasses()[passIndex];
+
+		// No attachments and no rendering scope - the execute function dispatches straight into the primary buffer
+		Pipeline*       pPipeline = GetOrCreatePipeline(passIndex, view);
+		PipelineLayout* pLayout   = GetOrCreatePipelineLayout(passIndex);
+		if (!pPipeline)
+			return;
+
+		std::vector<byte> pushData;
 		if (pass.PushConstantSize > 0)
-		{
-			std::vector<byte> pushData;
 			BuildPushConstants(passIndex, pushData);
-			pCmd->UpdatePushConstants(GetOrCreatePipelineLayout(passIndex), FShaderStage::VERTEX | FShaderStage::FRAGMENT, 0,
-			                          static_cast<uint32>(pushData.size()), pushData.data());
-		}
 
-		ExecuteContext ctx(pCmd, view, GetOrCreatePipelineLayout(passIndex), pass.TextureSlotsOffset);
+		BindPassState(pCmd, pPipeline, pLayout, 0, 0, pushData);
+
+		ExecuteContext ctx(pCmd, view, pLayout, pass.TextureSlotsOffset, pass.GetPushConstantStages());
 		if (pass.ExecuteFn)
 			pass.ExecuteFn(ctx);
+	}
 
-		pCmd->EndRendering();
+	void RenderProgramInstance::BindPassState(CommandBuffer* pCmd, Pipeline* pPipeline, PipelineLayout* pLayout, uint32 width, uint32 height,
+	                                          const std::vector<byte>& pushData)
+	{
+		const bool isCompute = pPipeline->GetPipelineType() == EPipelineType::COMPUTE;
 
-		for (const QueueReleasePlan& release : plan.PostReleases)
-			ApplyRelease(pCmd, release, pass.Queue, view);
+		pCmd->BindPipeline(pPipeline);
 
-		ApplyBarrierGroup(pCmd, plan.PostBarriers, view);
+		if (!isCompute)
+		{
+			ViewportDesc viewport = {};
+			viewport.Width        = static_cast<float>(width);
+			viewport.Height       = static_cast<float>(height);
+			pCmd->SetViewport(&viewport);
+
+			ScissorDesc scissor = {};
+			scissor.Width       = width;
+			scissor.Height      = height;
+			pCmd->SetScissor(&scissor);
+		}
 
-		pCmd->End();
+		pCmd->BindDescriptor(pPipeline, ResourceManager::GetDescriptorSet());
+
+		if (!pushData.empty())
+		{
+			const FShaderStage pushStages = isCompute ? FShaderStage::COMPUTE : FShaderStage::VERTEX | FShaderStage::FRAGMENT;
+			pCmd->UpdatePushConstants(pLayout, pushStages, 0, static_cast<uint32>(pushData.size()), pushData.data());
+		}
 	}
 } // namespace Poly
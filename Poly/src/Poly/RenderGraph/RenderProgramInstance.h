@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Poly/Core/Core.h"
+#include "Poly/Core/Job.h"
+#include "Platform/API/CommandQueue.h"
 #include "Poly/Rendering/Core/API/GraphicsTypes.h"
 #include "RenderProgram.h"
 #include "ResourceManager.h"
@@ -20,7 +22,8 @@ namespace Poly
 	class CommandBuffer;
 	class TextureView;
 	class PipelineLayout;
-	class GraphicsPipeline;
+	class Pipeline;
+	class MemoryBlock;
 
 	/*
 	 * An instantiated, active version of a RenderProgram. Holds the compiled RenderProgram
@@ -36,7 +39,8 @@ namespace Poly
 	class RenderProgramInstance
 	{
 	public:
-		static constexpr uint32 FRAMES_IN_FLIGHT = 2;
+		static constexpr uint32 FRAMES_IN_FLIGHT              = 2;
+		static constexpr uint32 MAX_SECONDARY_COMMAND_BUFFERS = 8; // per WithParallelRecording() pass, per frame in flight
 
 		explicit RenderProgramInstance(Ref<RenderProgram> pRenderProgram);
 		~RenderProgramInstance() = default;
@@ -65,11 +69,31 @@ namespace Poly
 			TextureHandle TexHandle;
 			SamplerHandle SamplerHnd;
 			bool          IsSizedToTarget = false;
+			uint32        AliasSlot       = TransientLifetime::NO_ALIAS_SLOT; // shares memory with other transients, see AllocateAliasSlot()
 
 			bool IsBuffer() const { return BufHandle.IsValid(); }
 			bool IsTexture() const { return TexHandle.IsValid(); }
 		};
 
+		// Creation parameters of a graph-owned (non-external) texture
+		struct GraphOwnedTexture
+		{
+			uint32        Width           = 0;
+			uint32        Height          = 0;
+			EFormat       Format          = EFormat::UNDEFINED;
+			FTextureUsage Usage           = FTextureUsage::NONE;
+			bool          IsSizedToTarget = false;
+		};
+
+		// Memory shared by every transient in one of the RenderProgram's alias slots
+		struct AliasSlotMemory
+		{
+			Ref<MemoryBlock> pMemory;                         // nullptr if the members couldn't share a memory type
+			uint32           TargetWidth             = 0;     // render target size the members were last placed for
+			uint32           TargetHeight            = 0;
+			bool             HasSizedToTargetMembers = false; // false until first allocated
+		};
+
 		// Per-pass runtime state, stable for the RenderProgramInstance's lifetime (ResolvedPass list
 		// never changes) except for the command buffers, which are re-recorded every frame.
 		struct PerPassResources
@@ -77,31 +101,58 @@ namespace Poly
 			std::array<Ref<CommandPool>, FRAMES_IN_FLIGHT> CommandPools;
 			std::array<CommandBuffer*, FRAMES_IN_FLIGHT>   CommandBuffers{};
 			Ref<PipelineLayout>                            Layout;
-			Ref<GraphicsPipeline>                          Pipeline;
+			Ref<Poly::Pipeline>                            Pipeline;
+			Unique<JobCounter>                             pRecorded; // done once this frame's RecordPass has finished
+
+			// WithParallelRecording() passes only - one pool per secondary buffer, since each is recorded on its own thread
+			std::array<std::vector<Ref<CommandPool>>, FRAMES_IN_FLIGHT> SecondaryCommandPools;
+			std::array<std::vector<CommandBuffer*>, FRAMES_IN_FLIGHT>   SecondaryCommandBuffers;
+		};
+
+		// A frame's submits for one queue, handed to CommandQueue::SubmitBatch() in runs as their passes are recorded. Kept across frames
+		// (only Count is reset) so batching doesn't allocate once the vectors have grown to size.
+		struct QueueSubmitBatch
+		{
+			std::vector<SubmitDesc> Submits;
+			uint32                  Count = 0;
+		};
+
+		// Where one of a frame's SubmitDescs is, and the last pass (in program order) it submits
+		struct FrameSubmit
+		{
+			FQueueType Queue;
+			uint32     SubmitIndex; // in m_QueueSubmits[Queue].Submits
+			size_t     LastPass;
 		};
 
 		void EnsurePerPassResources();
 		void WaitForFrameSlotReuse(uint32 frameIndex);
 		void ResizeSizedToTargetResources(const RenderView& view);
 
-		CommandBuffer*    GetCommandBuffer(size_t passIndex) const { return m_PassResources[passIndex].CommandBuffers[m_FrameIndex]; }
-		PipelineLayout*   GetOrCreatePipelineLayout(size_t passIndex);
-		GraphicsPipeline* GetOrCreatePipeline(size_t passIndex, const RenderView& view);
+		CommandBuffer*  GetCommandBuffer(size_t passIndex) const { return m_PassResources[passIndex].CommandBuffers[m_FrameIndex]; }
+		PipelineLayout* GetOrCreatePipelineLayout(size_t passIndex);
+		Pipeline*       GetOrCreatePipeline(size_t passIndex, const RenderView& view);
 
-		RuntimeResource* ResolvePort(const ResolvedPort& port, const RenderView& view);
-		EFormat          GetPortFormat(const ResolvedPort& port, const RenderView& view);
-		uint32           GetBindlessIndex(const RuntimeResource* pResource);
+		RuntimeResource*  ResolvePort(const ResolvedPort& port, const RenderView& view);
+		GraphOwnedTexture GetGraphOwnedTexture(const ResolvedPort& port, const RenderView& view);
+		void              AllocateAliasSlot(uint32 slotIndex, const RenderView& view);
+		EFormat           GetPortFormat(const ResolvedPort& port, const RenderView& view);
+		uint32            GetBindlessIndex(const RuntimeResource* pResource);
 
 		Texture* GetTextureForBarrier(const std::string& resolvedName, const RenderView& view);
 		Buffer*  GetBufferForBarrier(const std::string& resolvedName);
 
 		void RecordPass(size_t passIndex, const RenderView& view);
+		void RecordGraphicsPass(CommandBuffer* pCmd, size_t passIndex, const struct PassSyncPlan& plan, const RenderView& view);
+		void RecordComputePass(CommandBuffer* pCmd, size_t passIndex, const RenderView& view);
+		void BindPassState(CommandBuffer* pCmd, Pipeline* pPipeline, PipelineLayout* pLayout, uint32 width, uint32 height, const std::vector<byte>& pushData);
 		void BuildPushConstants(size_t passIndex, std::vector<byte>& outData);
 		void ApplyAcquire(CommandBuffer* pCmd, const struct QueueAcquirePlan& acquire, FQueueType currentQueue, const RenderView& view);
 		void ApplyRelease(CommandBuffer* pCmd, const struct QueueReleasePlan& release, FQueueType currentQueue, const RenderView& view);
 		void ApplyBarrierGroup(CommandBuffer* pCmd, const struct BarrierGroup& group, const RenderView& view);
 
-		SyncPoint* GetOrCreateQueueSyncPoint(FQueueType queue);
+		SyncPoint*  GetOrCreateQueueSyncPoint(FQueueType queue);
+		SubmitDesc& BeginQueueSubmit(FQueueType queue);
 
 		Ref<RenderProgram> m_pRenderProgram;
 		uint32             m_FrameIndex  = 0;
@@ -115,10 +166,16 @@ namespace Poly
 		// each other while already holding the lock.
 		std::recursive_mutex                             m_ResourcesMutex;
 		std::unordered_map<std::string, RuntimeResource> m_Resources; // keyed by ResolvedPort::ResolvedName
+		std::vector<AliasSlotMemory>                     m_AliasSlots; // indexed by TransientLifetime::AliasSlot, guarded by m_ResourcesMutex
 
 		std::unordered_map<FQueueType, Ref<SyncPoint>> m_QueueSyncPoints;
 		std::unordered_map<FQueueType, uint64>         m_QueueTimelineBase;
 
+		std::unordered_map<FQueueType, QueueSubmitBatch> m_QueueSubmits;
+		std::vector<FQueueType>                          m_SubmitQueueOrder; // queues with submits this frame, in first-use order
+		std::vector<FrameSubmit>                         m_FrameSubmits;     // this frame's submits, in program order
+		std::vector<SyncPointValue>                      m_PassWaits;        // scratch for the pass currently being batched
+
 		// Highest signal value each queue reached the last time this frame-in-flight slot was used -
 		// waited on before that slot's command pools are reset & reused again.
 		std::array<std::unordered_map<FQueueType, uint64>, FRAMES_IN_FLIGHT> m_FrameReclaimValues;
@@ -15,6 +15,7 @@ namespace Poly
 		RawBufferReadWrite,     // RawBuffer_UAV  - read/write byte-addressable buffer
 		UniformBuffer,          // ConstantBuffer
 		DynamicUniformBuffer,   // VolatileConstantBuffer
+		IndirectBuffer,         // IndirectArgs - draw/dispatch arguments, written by shaders and read by the indirect command
 		Sampler,
 		AccelerationStructure, // RayTracingAccelStruct
 		PushConstants,
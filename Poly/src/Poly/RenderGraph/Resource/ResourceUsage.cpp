@@ -21,6 +21,7 @@ namespace Poly
 		case EResourceType::RawBufferReadWrite:
 		case EResourceType::UniformBuffer:
 		case EResourceType::DynamicUniformBuffer:
+		case EResourceType::IndirectBuffer:
 			return true;
 		default:
 			return false;
@@ -83,6 +84,14 @@ namespace Poly
 			return {ETextureLayout::UNDEFINED, isWrite ? FAccessFlag::SHADER_WRITE : FAccessFlag::SHADER_READ, passShaderStages,
 			        FImageViewFlag::NONE};
 
+		// Written from shaders, read by the draw/dispatch command itself - and as the index buffer or by the pass's
+		// shaders, for buffers that carry what the draws look up next to the commands (see SceneRenderBridge::RecordDraws())
+		case EResourceType::IndirectBuffer:
+			if (isWrite)
+				return {ETextureLayout::UNDEFINED, FAccessFlag::SHADER_WRITE, passShaderStages, FImageViewFlag::NONE};
+			return {ETextureLayout::UNDEFINED, FAccessFlag::INDIRECT_COMMAND_READ | FAccessFlag::INDEX_READ | FAccessFlag::SHADER_READ,
+			        FPipelineStage::DRAW_INDIRECT | FPipelineStage::VERTEX_INPUT | passShaderStages, FImageViewFlag::NONE};
+
 		// Not yet used by any pass in a way that requires barrier tracking - no sync.
 		case EResourceType::Sampler:
 		case EResourceType::PushConstants:
@@ -127,6 +136,9 @@ namespace Poly
 		case FResourceState::Present:
 			return {ETextureLayout::PRESENT, FAccessFlag::MEMORY_READ, FPipelineStage::ALL_COMMANDS, FImageViewFlag::COLOR};
 
+		case FResourceState::IndirectArgument:
+			return {ETextureLayout::UNDEFINED, FAccessFlag::INDIRECT_COMMAND_READ, FPipelineStage::DRAW_INDIRECT, FImageViewFlag::NONE};
+
 		case FResourceState::ConstantBuffer:
 			return {ETextureLayout::UNDEFINED, FAccessFlag::UNIFORM_READ, FPipelineStage::ALL_COMMANDS, FImageViewFlag::NONE};
 
@@ -8,10 +8,94 @@
 #include "Poly/Core/RenderAPI.h"
 
 #include <algorithm>
+#include <bit>
 #include <cstring>
 #include <tuple>
 #include <unordered_set>
 
+namespace
+{
+	using namespace Poly;
+
+	TextureDesc GetTexture2DDesc(uint32 width, uint32 height, EFormat format, FTextureUsage usage, uint32 mipLevels)
+	{
+		TextureDesc texDesc  = {};
+		texDesc.Width        = width;
+		texDesc.Height       = height;
+		texDesc.Depth        = 1;
+		texDesc.ArrayLayers  = 1;
+		texDesc.MipLevels    = mipLevels;
+		texDesc.SampleCount  = 1;
+		texDesc.MemoryUsage  = EMemoryUsage::GPU_ONLY;
+		texDesc.Format       = format;
+		texDesc.TextureDim   = ETextureDim::DIM_2D;
+		texDesc.TextureUsage = usage | FTextureUsage::TRANSFER_DST;
+		return texDesc;
+	}
+
+	// Texture data in the staging buffer starts at a multiple of every format's texel block size
+	constexpr uint64 TEXTURE_STAGING_ALIGNMENT = 16;
+
+	uint64 AlignUp(uint64 value, uint64 alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	/*
+	 * Fills mip levels [firstLevel, MipLevels) of a texture by downsampling each from the one above it. Expects
+	 * every level in TRANSFER_DST_OPTIMAL with the ones above firstLevel written, leaves them all in
+	 * SHADER_READ_ONLY_OPTIMAL.
+	 */
+	void GenerateMipLevels(CommandBuffer* pCommandBuffer, Texture* pTexture, uint32 firstLevel)
+	{
+		const uint32 levelCount = pTexture->GetDesc().MipLevels;
+
+		TextureBarrier barrier = {};
+		barrier.pTexture       = pTexture;
+		barrier.AspectMask     = FImageViewFlag::COLOR;
+		barrier.MipLevelCount  = 1;
+
+		for (uint32 level = firstLevel; level < levelCount; level++)
+		{
+			barrier.SrcAccessFlag = FAccessFlag::TRANSFER_WRITE;
+			barrier.DstAccessFlag = FAccessFlag::TRANSFER_READ;
+			barrier.OldLayout     = ETextureLayout::TRANSFER_DST_OPTIMAL;
+			barrier.NewLayout     = ETextureLayout::TRANSFER_SRC_OPTIMAL;
+			barrier.MipLevel      = level - 1;
+			pCommandBuffer->PipelineBarrier(FPipelineStage::TRANSFER, FPipelineStage::TRANSFER, {}, {}, {barrier});
+
+			pCommandBuffer->BlitTexture(pTexture, ETextureLayout::TRANSFER_SRC_OPTIMAL, level - 1, pTexture, ETextureLayout::TRANSFER_DST_OPTIMAL, level,
+			                            EFilter::LINEAR);
+		}
+
+		// Levels above firstLevel - 1 were only written, the ones from there to the last were blitted from as well
+		std::vector<TextureBarrier> readBarriers;
+		barrier.DstAccessFlag = FAccessFlag::SHADER_READ;
+		barrier.NewLayout     = ETextureLayout::SHADER_READ_ONLY_OPTIMAL;
+
+		barrier.SrcAccessFlag = FAccessFlag::TRANSFER_WRITE;
+		barrier.OldLayout     = ETextureLayout::TRANSFER_DST_OPTIMAL;
+		barrier.MipLevel      = 0;
+		barrier.MipLevelCount = firstLevel - 1;
+		if (barrier.MipLevelCount > 0)
+			readBarriers.push_back(barrier);
+
+		barrier.SrcAccessFlag = FAccessFlag::TRANSFER_READ;
+		barrier.OldLayout     = ETextureLayout::TRANSFER_SRC_OPTIMAL;
+		barrier.MipLevel      = firstLevel - 1;
+		barrier.MipLevelCount = levelCount - firstLevel;
+		readBarriers.push_back(barrier);
+
+		barrier.SrcAccessFlag = FAccessFlag::TRANSFER_WRITE;
+		barrier.OldLayout     = ETextureLayout::TRANSFER_DST_OPTIMAL;
+		barrier.MipLevel      = levelCount - 1;
+		barrier.MipLevelCount = 1;
+		readBarriers.push_back(barrier);
+
+		pCommandBuffer->PipelineBarrier(FPipelineStage::TRANSFER, FPipelineStage::ALL_COMMANDS, {}, {}, readBarriers);
+	}
+} // namespace
+
 namespace Poly
 {
 	void ResourceManager::Init()
@@ -65,6 +149,9 @@ namespace Poly
 		s_AcquireRings.clear();
 		s_UploadTimeline  = {};
 		s_SlotSignalValue = {};
+		s_FlushSignalValues.clear();
+		s_LastTextureUploadValue    = 0;
+		s_PendingTextureUploadBytes = 0;
 
 		for (uint32 i = 0; i < FRAMES_IN_FLIGHT; i++)
 		{
@@ -126,22 +213,26 @@ namespace Poly
 		return static_cast<uint32>(s_Buffers.size() - 1);
 	}
 
-	TextureHandle ResourceManager::CreateTexture2D(uint32 width, uint32 height, EFormat format, FTextureUsage usage, std::string debugName)
+	MemoryRequirements ResourceManager::GetTexture2DMemoryRequirements(uint32 width, uint32 height, EFormat format, FTextureUsage usage, uint32 mipLevels)
+	{
+		const TextureDesc texDesc = GetTexture2DDesc(width, height, format, usage, mipLevels);
+		return RenderAPI::GetTextureMemoryRequirements(&texDesc);
+	}
+
+	uint32 ResourceManager::GetMipLevelCount(uint32 width, uint32 height)
+	{
+		return std::bit_width(std::max({width, height, 1u}));
+	}
+
+	TextureHandle ResourceManager::CreateTexture2D(uint32 width, uint32 height, EFormat format, FTextureUsage usage, std::string debugName, Ref<MemoryBlock> pMemoryBlock,
+	                                               uint64 memoryOffset, uint32 mipLevels)
 	{
 		const bool isDepth = BitsSet(FTextureUsage::DEPTH_STENCIL_ATTACHMENT, usage);
 
-		TextureDesc texDesc  = {};
-		texDesc.Width        = width;
-		texDesc.Height       = height;
-		texDesc.Depth        = 1;
-		texDesc.ArrayLayers  = 1;
-		texDesc.MipLevels    = 1;
-		texDesc.SampleCount  = 1;
-		texDesc.MemoryUsage  = EMemoryUsage::GPU_ONLY;
-		texDesc.Format       = format;
-		texDesc.TextureDim   = ETextureDim::DIM_2D;
-		texDesc.TextureUsage = usage | FTextureUsage::TRANSFER_DST;
+		TextureDesc texDesc  = GetTexture2DDesc(width, height, format, usage, mipLevels);
 		texDesc.DebugName    = debugName;
+		texDesc.pMemoryBlock = std::move(pMemoryBlock);
+		texDesc.MemoryOffset = memoryOffset;
 
 		Ref<Texture> pTexture = RenderAPI::CreateTexture(&texDesc);
 
@@ -150,7 +241,7 @@ namespace Poly
 		viewDesc.ImageViewType   = EImageViewType::TYPE_2D;
 		viewDesc.Format          = format;
 		viewDesc.ImageViewFlag   = isDepth ? FImageViewFlag::DEPTH_STENCIL : FImageViewFlag::COLOR;
-		viewDesc.MipLevelCount   = 1;
+		viewDesc.MipLevelCount   = mipLevels;
 		viewDesc.ArrayLayerCount = 1;
 		viewDesc.DebugName       = debugName;
 
@@ -163,6 +254,7 @@ namespace Poly
 		slot.pDefaultView                           = pView;
 		slot.Width                                  = width;
 		slot.Height                                 = height;
+		slot.MipLevels                              = mipLevels;
 		slot.Format                                 = format;
 		slot.DebugName                              = std::move(debugName);
 		slot.Alive                                  = true;
@@ -218,6 +310,11 @@ namespace Poly
 		return CreateBuffer(size, FBufferUsage::STORAGE_BUFFER | FBufferUsage::SHADER_DEVICE_ADDRESS, memUsage, std::move(debugName));
 	}
 
+	BufferHandle ResourceManager::CreateIndirectBuffer(uint64 size, EMemoryUsage memUsage, std::string debugName)
+	{
+		return CreateBuffer(size, FBufferUsage::INDIRECT_BUFFER | FBufferUsage::STORAGE_BUFFER | FBufferUsage::SHADER_DEVICE_ADDRESS, memUsage, std::move(debugName));
+	}
+
 	BufferHandle ResourceManager::ResizeBuffer(BufferHandle handle, uint64 newSize, FQueueType targetQueue, uint64 preserveBytes)
 	{
 		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
@@ -426,24 +523,48 @@ namespace Poly
 		s_PendingBufferDestroys.push_back({index, s_CurrentFrame, requiredSyncValue});
 	}
 
-	void ResourceManager::UploadTextureData(TextureHandle handle, const void* pData, uint32 width, uint32 height, FQueueType targetQueue)
+	UploadToken ResourceManager::UploadTextureData(TextureHandle handle, const void* pData, uint32 width, uint32 height, FQueueType targetQueue, uint32 mipLevelCount)
 	{
 		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
 		if (!handle.IsValid() || handle.GetIndex() >= s_Textures.size() || s_Textures[handle.GetIndex()].Generation != handle.GetGeneration())
 		{
 			POLY_CORE_WARN("UploadTextureData: stale or invalid TextureHandle");
-			return;
+			return {};
+		}
+
+		const TextureSlot& slot = s_Textures[handle.GetIndex()];
+		mipLevelCount           = std::clamp(mipLevelCount, 1u, slot.MipLevels);
+
+		// The missing levels are blitted from the uploaded ones, which needs a graphics queue to record on, a texture that can be
+		// blitted from, and a format that can be blitted at all - block-compressed ones can't
+		const bool generateMips = mipLevelCount < slot.MipLevels;
+		if (generateMips && (targetQueue != FQueueType::GRAPHICS || !BitsSet(FTextureUsage::TRANSFER_SRC, slot.pTexture->GetDesc().TextureUsage) || IsBlockCompressed(slot.Format)))
+		{
+			POLY_CORE_WARN("UploadTextureData: can't generate the mip levels of '{}' - it needs GRAPHICS as target queue, TRANSFER_SRC usage and a format "
+			               "that isn't block compressed",
+			               slot.DebugName);
+			return {};
 		}
 
-		// TODO: assumes 4 bytes/pixel (RGBA8), same simplification AssetLoader::LoadTextureFromMemory
-		// makes today - format/channels should determine the real stride instead.
+		size_t size = 0;
+		for (uint32 level = 0; level < mipLevelCount; level++)
+			size += GetFormatImageSize(slot.Format, std::max(width >> level, 1u), std::max(height >> level, 1u));
+
 		PendingTextureUpload upload;
-		upload.Handle      = handle;
-		upload.Width       = width;
-		upload.Height      = height;
-		upload.TargetQueue = targetQueue;
-		upload.Data.assign(static_cast<const byte*>(pData), static_cast<const byte*>(pData) + static_cast<size_t>(width) * height * 4);
+		upload.Handle        = handle;
+		upload.Width         = width;
+		upload.Height        = height;
+		upload.MipLevelCount = mipLevelCount;
+		upload.TargetQueue   = targetQueue;
+		upload.Data.assign(static_cast<const byte*>(pData), static_cast<const byte*>(pData) + size);
+		s_PendingTextureUploadBytes += upload.Data.size();
 		s_PendingTextureUploads.push_back(std::move(upload));
+
+		const UploadToken token = {s_FlushIndex + 1};
+		if (s_PendingTextureUploadBytes >= MAX_PENDING_TEXTURE_UPLOAD_BYTES)
+			FlushUploads();
+
+		return token;
 	}
 
 	void ResourceManager::UploadBufferData(BufferHandle handle, const void* pData, uint64 size, uint64 offset, FQueueType targetQueue)
@@ -477,6 +598,70 @@ namespace Poly
 		s_PendingBufferUploads.push_back(std::move(upload));
 	}
 
+	void ResourceManager::CopyBufferData(BufferHandle srcHandle, uint64 srcOffset, BufferHandle dstHandle, uint64 dstOffset, uint64 size, FQueueType targetQueue)
+	{
+		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+		for (BufferHandle handle : {srcHandle, dstHandle})
+		{
+			if (!handle.IsValid() || handle.GetIndex() >= s_Buffers.size())
+			{
+				POLY_CORE_WARN("CopyBufferData: invalid BufferHandle");
+				return;
+			}
+
+			const BufferSlot& slot = s_Buffers[handle.GetIndex()];
+			if (!slot.Alive || slot.Generation != handle.GetGeneration())
+			{
+				POLY_CORE_WARN("CopyBufferData: stale BufferHandle");
+				return;
+			}
+		}
+
+		if (srcHandle == dstHandle && srcOffset < dstOffset + size && dstOffset < srcOffset + size)
+		{
+			POLY_CORE_WARN("CopyBufferData: source and destination ranges of '{}' overlap", s_Buffers[srcHandle.GetIndex()].DebugName);
+			return;
+		}
+
+		PendingBufferCopy copy;
+		copy.SrcHandle   = srcHandle;
+		copy.DstHandle   = dstHandle;
+		copy.Size        = size;
+		copy.SrcOffset   = srcOffset;
+		copy.DstOffset   = dstOffset;
+		copy.TargetQueue = targetQueue;
+		copy.DestroySrc  = false;
+		s_PendingBufferCopies.push_back(copy);
+	}
+
+	bool ResourceManager::IsUploadComplete(UploadToken token)
+	{
+		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+		if (token.FlushIndex > s_FlushIndex)
+			return false;
+
+		// Flushes are dropped from the map once their value is reached
+		auto it = s_FlushSignalValues.find(token.FlushIndex);
+		return it == s_FlushSignalValues.end() || s_UploadTimeline.pSyncPoint->GetValue() >= it->second;
+	}
+
+	void ResourceManager::WaitForUpload(UploadToken token)
+	{
+		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+		if (token.FlushIndex > s_FlushIndex)
+			FlushUploads();
+
+		if (auto it = s_FlushSignalValues.find(token.FlushIndex); it != s_FlushSignalValues.end())
+			s_UploadTimeline.pSyncPoint->Wait(it->second);
+	}
+
+	void ResourceManager::WaitForUploads()
+	{
+		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+		if (!s_FlushSignalValues.empty())
+			s_UploadTimeline.pSyncPoint->Wait(s_FlushSignalValues.rbegin()->second);
+	}
+
 	bool ResourceManager::ConsumePendingUploadSync(TextureHandle handle, SyncPoint** ppSyncPoint, uint64* pValue)
 	{
 		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
@@ -509,6 +694,17 @@ namespace Poly
 		return true;
 	}
 
+	bool ResourceManager::GetTextureUploadSync(SyncPoint** ppSyncPoint, uint64* pValue)
+	{
+		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+		if (s_LastTextureUploadValue == 0)
+			return false;
+
+		*ppSyncPoint = s_UploadTimeline.pSyncPoint.get();
+		*pValue      = s_LastTextureUploadValue;
+		return true;
+	}
+
 	void ResourceManager::EnsureStagingCapacity(uint32 slot, uint64 requiredSize)
 	{
 		if (s_StagingBuffers[slot].pBuffer && s_StagingBuffers[slot].Capacity >= requiredSize)
@@ -558,7 +754,7 @@ namespace Poly
 
 		uint64 totalStagingSize = 0;
 		for (const auto& upload : s_PendingTextureUploads)
-			totalStagingSize += upload.Data.size();
+			totalStagingSize = AlignUp(totalStagingSize, TEXTURE_STAGING_ALIGNMENT) + upload.Data.size();
 		for (const auto& upload : s_PendingBufferUploads)
 			totalStagingSize += upload.Data.size();
 
@@ -568,8 +764,8 @@ namespace Poly
 
 		const uint32 transferFamily = RenderAPI::GetCommandQueue(FQueueType::TRANSFER)->GetQueueFamilyIndex();
 
-		std::unordered_map<FQueueType, std::vector<TextureHandle>> texturesByTarget;
-		std::unordered_map<FQueueType, std::vector<BufferHandle>>  buffersByTarget;
+		std::unordered_map<FQueueType, std::vector<const PendingTextureUpload*>> texturesByTarget;
+		std::unordered_map<FQueueType, std::vector<BufferHandle>>                buffersByTarget;
 
 		CommandPool*   pTransferPool = s_TransferCommands[slot].pPool.get();
 		CommandBuffer* pTransferCmd  = s_TransferCommands[slot].pBuffer;
@@ -579,6 +775,7 @@ namespace Poly
 
 		for (const auto& upload : s_PendingTextureUploads)
 		{
+			offset = AlignUp(offset, TEXTURE_STAGING_ALIGNMENT);
 			memcpy(pMapped + offset, upload.Data.data(), upload.Data.size());
 			Texture* pTexture = s_Textures[upload.Handle.GetIndex()].pTexture.get();
 
@@ -587,19 +784,40 @@ namespace Poly
 
 			CopyBufferDesc copyDesc = {};
 			copyDesc.BufferOffset   = offset;
-			copyDesc.Width          = upload.Width;
-			copyDesc.Height         = upload.Height;
 			copyDesc.Depth          = 1;
 			copyDesc.ArrayCount     = 1;
-			pTransferCmd->CopyBufferToTexture(s_StagingBuffers[slot].pBuffer.get(), pTexture, ETextureLayout::TRANSFER_DST_OPTIMAL, copyDesc);
+			for (uint32 level = 0; level < upload.MipLevelCount; level++)
+			{
+				// In texels even for block-compressed formats - a level that isn't a multiple of the block size
+				// still has a whole block's worth of data in the buffer for its partial blocks
+				copyDesc.MipLevel = level;
+				copyDesc.Width    = std::max(upload.Width >> level, 1u);
+				copyDesc.Height   = std::max(upload.Height >> level, 1u);
+				pTransferCmd->CopyBufferToTexture(s_StagingBuffers[slot].pBuffer.get(), pTexture, ETextureLayout::TRANSFER_DST_OPTIMAL, copyDesc);
+				copyDesc.BufferOffset += GetFormatImageSize(pTexture->GetDesc().Format, copyDesc.Width, copyDesc.Height);
+			}
+
+			// With levels left to generate, the texture stays a transfer destination until they are
+			const bool           generateMips = upload.MipLevelCount < pTexture->GetDesc().MipLevels;
+			const ETextureLayout uploadLayout = generateMips ? ETextureLayout::TRANSFER_DST_OPTIMAL : ETextureLayout::SHADER_READ_ONLY_OPTIMAL;
 
 			const uint32 targetFamily = RenderAPI::GetCommandQueue(upload.TargetQueue)->GetQueueFamilyIndex();
 			if (targetFamily != transferFamily)
 			{
 				pTransferCmd->ReleaseTexture(pTexture, FPipelineStage::TRANSFER, FPipelineStage::TRANSFER, FAccessFlag::TRANSFER_READ,
-				                             ETextureLayout::TRANSFER_DST_OPTIMAL, ETextureLayout::SHADER_READ_ONLY_OPTIMAL, transferFamily,
-				                             targetFamily);
-				texturesByTarget[upload.TargetQueue].push_back(upload.Handle);
+				                             ETextureLayout::TRANSFER_DST_OPTIMAL, uploadLayout, transferFamily, targetFamily);
+				texturesByTarget[upload.TargetQueue].push_back(&upload);
+			}
+			else if (generateMips)
+			{
+				// Same family as the target, which is GRAPHICS (see UploadTextureData()), so the blits can go here
+				GenerateMipLevels(pTransferCmd, pTexture, upload.MipLevelCount);
+			}
+			else
+			{
+				// No ownership transfer to do the layout transition in - do it here
+				pTransferCmd->PipelineTextureBarrier(pTexture, FPipelineStage::TRANSFER, FPipelineStage::ALL_COMMANDS, FAccessFlag::TRANSFER_WRITE,
+				                                     FAccessFlag::SHADER_READ, ETextureLayout::TRANSFER_DST_OPTIMAL, ETextureLayout::SHADER_READ_ONLY_OPTIMAL);
 			}
 
 			offset += upload.Data.size();
@@ -611,25 +829,23 @@ namespace Poly
 			Buffer* pBuffer = s_Buffers[upload.Handle.GetIndex()].pBuffer.get();
 
 			pTransferCmd->CopyBuffer(s_StagingBuffers[slot].pBuffer.get(), pBuffer, upload.Data.size(), offset, upload.Offset);
-
-			const uint32 targetFamily = RenderAPI::GetCommandQueue(upload.TargetQueue)->GetQueueFamilyIndex();
-			if (targetFamily != transferFamily)
-			{
-				pTransferCmd->ReleaseBuffer(pBuffer, FPipelineStage::TRANSFER, FPipelineStage::TRANSFER, FAccessFlag::TRANSFER_READ,
-				                            transferFamily, targetFamily);
-				buffersByTarget[upload.TargetQueue].push_back(upload.Handle);
-			}
-
 			offset += upload.Data.size();
 		}
 
+		// CopyBufferData() copies may read what was just uploaded
+		if (!s_PendingBufferUploads.empty() && !s_PendingBufferCopies.empty())
+		{
+			const AccessBarrier uploadBarrier = {FAccessFlag::TRANSFER_WRITE, FAccessFlag::TRANSFER_READ};
+			pTransferCmd->PipelineBarrier(FPipelineStage::TRANSFER, FPipelineStage::TRANSFER, {uploadBarrier}, {}, {});
+		}
+
 		// Buffer-to-buffer copies
 		for (const auto& copy : s_PendingBufferCopies)
 		{
 			Buffer* pSrcBuffer = s_Buffers[copy.SrcHandle.GetIndex()].pBuffer.get();
 			Buffer* pDstBuffer = s_Buffers[copy.DstHandle.GetIndex()].pBuffer.get();
 
-			pTransferCmd->CopyBuffer(pSrcBuffer, pDstBuffer, copy.Size, 0, 0);
+			pTransferCmd->CopyBuffer(pSrcBuffer, pDstBuffer, copy.Size, copy.SrcOffset, copy.DstOffset);
 
 			const uint32 targetFamily = RenderAPI::GetCommandQueue(copy.TargetQueue)->GetQueueFamilyIndex();
 			if (targetFamily != transferFamily)
@@ -640,6 +856,19 @@ namespace Poly
 			}
 		}
 
+		// Uploaded buffers are released only now, since the copies above may still have read them on this queue
+		for (const auto& upload : s_PendingBufferUploads)
+		{
+			const uint32 targetFamily = RenderAPI::GetCommandQueue(upload.TargetQueue)->GetQueueFamilyIndex();
+			if (targetFamily != transferFamily)
+			{
+				Buffer* pBuffer = s_Buffers[upload.Handle.GetIndex()].pBuffer.get();
+				pTransferCmd->ReleaseBuffer(pBuffer, FPipelineStage::TRANSFER, FPipelineStage::TRANSFER, FAccessFlag::TRANSFER_READ,
+				                            transferFamily, targetFamily);
+				buffersByTarget[upload.TargetQueue].push_back(upload.Handle);
+			}
+		}
+
 		pTransferCmd->End();
 
 		const uint64 transferSignalValue = ++s_UploadTimeline.Value;
@@ -664,12 +893,16 @@ namespace Poly
 
 			const uint32 targetFamily = RenderAPI::GetCommandQueue(target)->GetQueueFamilyIndex();
 
-			for (const auto& handle : texturesByTarget[target])
+			for (const PendingTextureUpload* pUpload : texturesByTarget[target])
 			{
-				Texture* pTexture = s_Textures[handle.GetIndex()].pTexture.get();
+				Texture*             pTexture     = s_Textures[pUpload->Handle.GetIndex()].pTexture.get();
+				const bool           generateMips = pUpload->MipLevelCount < pTexture->GetDesc().MipLevels;
+				const ETextureLayout uploadLayout = generateMips ? ETextureLayout::TRANSFER_DST_OPTIMAL : ETextureLayout::SHADER_READ_ONLY_OPTIMAL;
+
 				ring.Slots[slot].pBuffer->AcquireTexture(pTexture, FPipelineStage::TRANSFER, FPipelineStage::TRANSFER, FAccessFlag::TRANSFER_READ,
-				                                         ETextureLayout::TRANSFER_DST_OPTIMAL, ETextureLayout::SHADER_READ_ONLY_OPTIMAL,
-				                                         transferFamily, targetFamily);
+				                                         ETextureLayout::TRANSFER_DST_OPTIMAL, uploadLayout, transferFamily, targetFamily);
+				if (generateMips)
+					GenerateMipLevels(ring.Slots[slot].pBuffer, pTexture, pUpload->MipLevelCount);
 			}
 			for (const auto& bufferHandle : buffersByTarget[target])
 			{
@@ -689,14 +922,16 @@ namespace Poly
 
 			highestSignalValue = std::max(highestSignalValue, acquireSignalValue);
 
-			for (const auto& handle : texturesByTarget[target])
-				s_Textures[handle.GetIndex()].PendingUploadValue = acquireSignalValue;
+			for (const PendingTextureUpload* pUpload : texturesByTarget[target])
+				s_Textures[pUpload->Handle.GetIndex()].PendingUploadValue = acquireSignalValue;
+			if (!texturesByTarget[target].empty())
+				s_LastTextureUploadValue = std::max(s_LastTextureUploadValue, acquireSignalValue);
 			for (const auto& bufferHandle : buffersByTarget[target])
 				s_Buffers[bufferHandle.GetIndex()].PendingUploadValue = acquireSignalValue;
 
 			// Any ResizeBuffer copy targeting this queue is now retirable once that value is reached
 			for (const auto& copy : s_PendingBufferCopies)
-				if (copy.TargetQueue == target)
+				if (copy.TargetQueue == target && copy.DestroySrc)
 					EnqueueBufferDestroy(copy.SrcHandle.GetIndex(), acquireSignalValue);
 		}
 
@@ -704,7 +939,10 @@ namespace Poly
 		// queue still needs to wait for the transfer submit itself to finish before it's visible.
 		for (const auto& upload : s_PendingTextureUploads)
 			if (RenderAPI::GetCommandQueue(upload.TargetQueue)->GetQueueFamilyIndex() == transferFamily)
+			{
 				s_Textures[upload.Handle.GetIndex()].PendingUploadValue = transferSignalValue;
+				s_LastTextureUploadValue                               = std::max(s_LastTextureUploadValue, transferSignalValue);
+			}
 		for (const auto& upload : s_PendingBufferUploads)
 			if (RenderAPI::GetCommandQueue(upload.TargetQueue)->GetQueueFamilyIndex() == transferFamily)
 				s_Buffers[upload.Handle.GetIndex()].PendingUploadValue = transferSignalValue;
@@ -712,12 +950,15 @@ namespace Poly
 			if (RenderAPI::GetCommandQueue(copy.TargetQueue)->GetQueueFamilyIndex() == transferFamily)
 			{
 				s_Buffers[copy.DstHandle.GetIndex()].PendingUploadValue = transferSignalValue;
-				EnqueueBufferDestroy(copy.SrcHandle.GetIndex(), transferSignalValue);
+				if (copy.DestroySrc)
+					EnqueueBufferDestroy(copy.SrcHandle.GetIndex(), transferSignalValue);
 			}
 
-		s_SlotSignalValue[slot] = highestSignalValue;
+		s_SlotSignalValue[slot]             = highestSignalValue;
+		s_FlushSignalValues[++s_FlushIndex] = highestSignalValue;
 
 		s_PendingTextureUploads.clear();
+		s_PendingTextureUploadBytes = 0;
 		s_PendingBufferUploads.clear();
 		s_PendingBufferCopies.clear();
 	}
@@ -730,6 +971,9 @@ namespace Poly
 
 		s_CurrentFrame++;
 
+		const uint64 uploadValue = s_UploadTimeline.pSyncPoint->GetValue();
+		std::erase_if(s_FlushSignalValues, [uploadValue](const auto& flush) { return flush.second <= uploadValue; });
+
 		const auto isSafeToFree = [](const PendingDestroy& entry) {
 			if (entry.RequiredSyncValue != 0)
 				return s_UploadTimeline.pSyncPoint->GetValue() >= entry.RequiredSyncValue;
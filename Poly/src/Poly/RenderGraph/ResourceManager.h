@@ -26,6 +26,12 @@ namespace Poly
 	using BufferHandle  = Handle<struct BufferHandleTag>;
 	using SamplerHandle = Handle<struct SamplerHandleTag>;
 
+	// Which upload flush an upload goes out with - see ResourceManager::IsUploadComplete()
+	struct UploadToken
+	{
+		uint64 FlushIndex = 0; // 0 = nothing to wait for
+	};
+
 	class ResourceManager
 	{
 	public:
@@ -35,6 +41,10 @@ namespace Poly
 		static constexpr uint32 MAX_SAMPLERS     = 256;
 		static constexpr uint32 FRAMES_IN_FLIGHT = 2;
 
+		// Queued texture data that makes UploadTextureData() flush straight away instead of at the next Update() -
+		// bounds the staging buffers when a lot of textures are loaded at once
+		static constexpr uint64 MAX_PENDING_TEXTURE_UPLOAD_BYTES = 256ull * 1024 * 1024;
+
 		// Bit layout of the packed uint32 used in a pass's textureIndices[] push-constant slot: texture
 		// index in the low TEXTURE_INDEX_BITS bits, sampler index directly above it (mirrors bindless.glsl).
 		static constexpr uint32 TEXTURE_INDEX_BITS  = 12; // log2(MAX_TEXTURES)
@@ -66,9 +76,27 @@ namespace Poly
 		 * @param format - Format of the texture
 		 * @param usage - Usage of the texture
 		 * @param debugName - Debug name of the texture
+		 * @param pMemoryBlock - Memory to place the texture in (see RenderAPI::CreateMemoryBlock) - nullptr gives it its own allocation
+		 * @param memoryOffset - Offset into pMemoryBlock, must satisfy the texture's alignment requirement
+		 * @param mipLevels - Mip levels of the texture, all of them in its default view (see GetMipLevelCount())
 		 * @return TextureHandle - Handle to the created texture
 		 */
-		static TextureHandle CreateTexture2D(uint32 width, uint32 height, EFormat format, FTextureUsage usage, std::string debugName = "");
+		static TextureHandle CreateTexture2D(uint32 width, uint32 height, EFormat format, FTextureUsage usage, std::string debugName = "",
+		                                     Ref<MemoryBlock> pMemoryBlock = nullptr, uint64 memoryOffset = 0, uint32 mipLevels = 1);
+
+		/*
+		 * Gets the memory a CreateTexture2D() texture with the same parameters would need, e.g. to size a
+		 * MemoryBlock that several textures are placed in
+		 * @return MemoryRequirements - Size, alignment and allowed memory types
+		 */
+		static MemoryRequirements GetTexture2DMemoryRequirements(uint32 width, uint32 height, EFormat format, FTextureUsage usage, uint32 mipLevels = 1);
+
+		/*
+		 * Mip levels of a full chain, down to 1x1
+		 * @param width - Width of the top level
+		 * @param height - Height of the top level
+		 */
+		static uint32 GetMipLevelCount(uint32 width, uint32 height);
 
 		/*
 		 * Creates a specified GPU buffer
@@ -115,6 +143,16 @@ namespace Poly
 		 */
 		static BufferHandle CreateStorageBuffer(uint64 size, EMemoryUsage memUsage = EMemoryUsage::GPU_ONLY, std::string debugName = "");
 
+		/*
+		 * Creates a buffer of indirect draw/dispatch arguments - also a BDA-addressable storage buffer, so a
+		 * compute pass can write the arguments it's later drawn with
+		 * @param size - Size of the buffer
+		 * @param memUsage - Memory usage of the buffer
+		 * @param debugName - Debug name of the buffer
+		 * @return BufferHandle - Handle to the created buffer
+		 */
+		static BufferHandle CreateIndirectBuffer(uint64 size, EMemoryUsage memUsage = EMemoryUsage::GPU_ONLY, std::string debugName = "");
+
 		/*
 		 * Grows (or shrinks) a buffer in place: creates a new buffer of newSize and queues a copy
 		 * of the old buffer's contents into it for the next FlushUploads() - The old handle is
@@ -196,15 +234,20 @@ namespace Poly
 		/*
 		 * Uploads data to a texture.
 		 * @param handle - Handle to the texture
-		 * @param pData - Pointer to the data to upload
+		 * @param pData - Pointer to the data to upload, tightly packed texels (or blocks) of the texture's format
 		 * @param width - Width of the texture
 		 * @param height - Height of the texture
 		 * @param targetQueue - Queue family the texture's ownership should be released to after the
 		 *        transfer completes - i.e. whichever queue the render program's first-touching pass
 		 *        runs on. Defaults to GRAPHICS since that's overwhelmingly the common case; get this
 		 *        wrong for a compute-first consumer and the acquire barrier never happens.
+		 * @param mipLevelCount - Mip levels in pData, back to back from the top one. The texture's levels below
+		 *        them are downsampled from the last one with blits on the target queue, which has to be GRAPHICS
+		 *        for that (and the texture needs TRANSFER_SRC usage)
+		 * @return UploadToken - to check or wait for the upload with, for consumers outside the render graph
 		 */
-		static void UploadTextureData(TextureHandle handle, const void* pData, uint32 width, uint32 height, FQueueType targetQueue = FQueueType::GRAPHICS);
+		static UploadToken UploadTextureData(TextureHandle handle, const void* pData, uint32 width, uint32 height, FQueueType targetQueue = FQueueType::GRAPHICS,
+		                                     uint32 mipLevelCount = 1);
 
 		/*
 		 * Uploads data to a buffer. If GPU_ONLY the transfer is queued for next Execute of the render instance. If CPU_VISIBLE the transfer is immediate.
@@ -218,6 +261,39 @@ namespace Poly
 		 */
 		static void UploadBufferData(BufferHandle handle, const void* pData, uint64 size, uint64 offset = 0, FQueueType targetQueue = FQueueType::GRAPHICS);
 
+		/*
+		 * Copies a range of a GPU_ONLY buffer to a range of another (or the same) buffer, queued for the next Execute of
+		 * the render instance like UploadBufferData - runs after that flush's uploads, so it may copy data uploaded in the
+		 * same frame. Used to move allocations within an arena (see BufferArena::Relocate()).
+		 * @param srcHandle - Handle to the buffer to copy from, must have been created with TRANSFER_SRC usage
+		 * @param srcOffset - Offset of the range to copy from
+		 * @param dstHandle - Handle to the buffer to copy to
+		 * @param dstOffset - Offset of the range to copy to, must not overlap the source range if it's the same buffer
+		 * @param size - Size of the range to copy
+		 * @param targetQueue - Queue family the destination's ownership should be released to (see UploadBufferData)
+		 */
+		static void CopyBufferData(BufferHandle srcHandle, uint64 srcOffset, BufferHandle dstHandle, uint64 dstOffset, uint64 size,
+		                           FQueueType targetQueue = FQueueType::GRAPHICS);
+
+		/*
+		 * Checks whether an upload has landed on its target queue, without blocking
+		 * @param token - from the upload call
+		 */
+		static bool IsUploadComplete(UploadToken token);
+
+		/*
+		 * Blocks until an upload has landed on its target queue, flushing it first if it's still queued. Waits on
+		 * the upload timeline only - other work on the queues carries on.
+		 * @param token - from the upload call
+		 */
+		static void WaitForUpload(UploadToken token);
+
+		/*
+		 * Blocks until every flushed upload has landed - for consumers that can't wait on the upload timeline
+		 * on the GPU (the old render graph, see Renderer::Render())
+		 */
+		static void WaitForUploads();
+
 		/*
 		 * Updates resource manager state, handling any pending uploads and deferred destruction of resources. Should be called once per frame.
 		 * NOTE: Should only be called from the Renderer::Render() function
@@ -238,6 +314,14 @@ namespace Poly
 		 */
 		static bool ConsumePendingUploadSync(BufferHandle handle, SyncPoint** ppSyncPoint, uint64* pValue);
 
+		/*
+		 * Gets what to wait on for every texture uploaded so far - for textures that are read without being bound
+		 * to a port, through the bindless heap (e.g. materials' textures, see SceneRenderBridge). Not consumed:
+		 * every RenderProgramInstance has to wait, and waiting on a value that's already been reached is free.
+		 * @return false if no texture has been uploaded
+		 */
+		static bool GetTextureUploadSync(SyncPoint** ppSyncPoint, uint64* pValue);
+
 		/*
 		 * Gets all textures registered in the resource manager.
 		 * @return std::vector<TextureInfo> - Vector of texture information
@@ -271,6 +355,7 @@ namespace Poly
 			Ref<TextureView> pDefaultView; // null for externally-registered slots
 			uint32           Generation = 0;
 			uint32           Width = 0, Height = 0;
+			uint32           MipLevels = 1;
 			EFormat          Format = EFormat::UNDEFINED;
 			std::string      DebugName;
 			bool             Alive              = false;
@@ -295,9 +380,10 @@ namespace Poly
 		struct PendingTextureUpload
 		{
 			TextureHandle     Handle;
-			std::vector<byte> Data;
+			std::vector<byte> Data; // MipLevelCount levels, back to back
 			uint32            Width, Height;
-			FQueueType        TargetQueue = FQueueType::GRAPHICS;
+			uint32            MipLevelCount = 1;
+			FQueueType        TargetQueue   = FQueueType::GRAPHICS;
 		};
 
 		struct PendingBufferUpload
@@ -313,7 +399,10 @@ namespace Poly
 			BufferHandle SrcHandle;
 			BufferHandle DstHandle;
 			uint64       Size;
+			uint64       SrcOffset   = 0;
+			uint64       DstOffset   = 0;
 			FQueueType   TargetQueue = FQueueType::GRAPHICS;
+			bool         DestroySrc  = true; // ResizeBuffer()'s old buffer, retired once the copy completes
 		};
 
 		struct PendingDestroy
@@ -391,5 +480,10 @@ namespace Poly
 		inline static UploadTimeline s_UploadTimeline;
 
 		inline static std::array<uint64, FRAMES_IN_FLIGHT> s_SlotSignalValue{};
+
+		inline static uint64                   s_FlushIndex                = 0; // FlushUploads() calls that submitted anything
+		inline static std::map<uint64, uint64> s_FlushSignalValues;             // flush index -> its last timeline value, until reached
+		inline static uint64                   s_LastTextureUploadValue    = 0; // see GetTextureUploadSync()
+		inline static uint64                   s_PendingTextureUploadBytes = 0; // in s_PendingTextureUploads
 	};
 } // namespace Poly
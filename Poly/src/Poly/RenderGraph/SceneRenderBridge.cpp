@@ -1,15 +1,20 @@
 #include "SceneRenderBridge.h"
 
 #include "Platform/API/Buffer.h"
+#include "Platform/API/CommandBuffer.h"
 #include "Platform/API/Sampler.h"
+#include "Platform/API/Texture.h"
 #include "Poly/Core/RenderAPI.h"
 #include "Poly/Model/Mesh.h"
+#include "Poly/Model/Model.h"
 #include "Poly/RenderGraph/RenderProgramInstance.h"
 #include "Poly/RenderGraph/ResourceManager.h"
 #include "Poly/Resources/GeometryPool.h"
 #include "Poly/Scene/Components.h"
 #include "Poly/Scene/Scene.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
 namespace
@@ -17,6 +22,21 @@ namespace
 	constexpr Poly::Material::Type kMaterialTextureOrder[6] = {
 	    Poly::Material::Type::ALBEDO, Poly::Material::Type::METALIC, Poly::Material::Type::NORMAL,
 	    Poly::Material::Type::ROUGHNESS, Poly::Material::Type::AMBIENT_OCCLUSION, Poly::Material::Type::COMBINED};
+
+	// Pops a free slot, or appends a new default-constructed row for one
+	template<typename Row>
+	uint32 AllocRow(std::vector<Row>& rows, std::vector<uint32>& freeSlots)
+	{
+		if (!freeSlots.empty())
+		{
+			const uint32 slot = freeSlots.back();
+			freeSlots.pop_back();
+			return slot;
+		}
+
+		rows.emplace_back();
+		return static_cast<uint32>(rows.size() - 1);
+	}
 } // namespace
 
 namespace Poly
@@ -24,106 +44,306 @@ namespace Poly
 	SceneRenderBridge::SceneRenderBridge(Scene& scene, Ref<RenderProgramInstance> pProgramInstance)
 	    : m_Scene(scene)
 	    , m_pProgramInstance(std::move(pProgramInstance))
-	{}
+	{
+		entt::registry& registry = m_Scene.m_Registry;
+		registry.on_construct<MeshComponent>().connect<&SceneRenderBridge::OnMeshComponentConstructed>(this);
+		registry.on_destroy<MeshComponent>().connect<&SceneRenderBridge::OnMeshComponentDestroyed>(this);
 
-	void SceneRenderBridge::Update()
+		// Entities that existed before the bridge was created have to go through the first Update() too
+		for (entt::entity entity : registry.view<MeshComponent>())
+			registry.emplace_or_replace<DirtyTag>(entity);
+	}
+
+	SceneRenderBridge::~SceneRenderBridge()
 	{
-		struct PendingBatch
-		{
-			MeshInstance           Instance;
-			std::vector<glm::mat4> Transforms;
-		};
+		entt::registry& registry = m_Scene.m_Registry;
+		registry.on_construct<MeshComponent>().disconnect<&SceneRenderBridge::OnMeshComponentConstructed>(this);
+		registry.on_destroy<MeshComponent>().disconnect<&SceneRenderBridge::OnMeshComponentDestroyed>(this);
+	}
 
-		std::vector<PendingBatch>          pendingBatches;
-		std::unordered_map<size_t, size_t> hashToBatchIndex;
+	void SceneRenderBridge::Update()
+	{
+		for (entt::entity entity : m_RemovedEntities)
+			ReleaseInstance(entity);
+		m_RemovedEntities.clear();
 
-		// TODO: When/if possible, only walk dirty entities instead of the whole registry every rebuild.
-		auto view = m_Scene.m_Registry.view<MeshComponent, TransformComponent>();
+		auto view = m_Scene.m_Registry.view<DirtyTag, MeshComponent, WorldTransformComponent>();
 		for (auto [entity, meshComp, transform] : view.each())
-		{
-			MeshInstance instance = meshComp.pModel->GetMeshInstance(meshComp.MeshIndex);
-			const size_t hash     = instance.GetUniqueHash();
+			UpdateInstance(entity, meshComp, transform);
+
+		if (m_GeometryGeneration != GeometryPool::GetGeneration())
+			RefreshBatchRanges();
 
-			auto it = hashToBatchIndex.find(hash);
-			if (it == hashToBatchIndex.end())
+		UploadChanges();
+		WriteCullParams();
+	}
+
+	void SceneRenderBridge::RecordCulling(CommandBuffer* pCmd) const
+	{
+		Buffer* pVisibleDraws = GetVisibleDrawBuffer();
+		if (!pVisibleDraws || m_InstanceSlotCount == 0)
+			return;
+
+		// Culling appends from no draws and no indices. The graph only syncs the shader writes below against last frame's
+		// reads, not this reset.
+		pCmd->PipelineBufferBarrier(pVisibleDraws, FPipelineStage::DRAW_INDIRECT, FPipelineStage::TRANSFER, FAccessFlag::INDIRECT_COMMAND_READ,
+		                            FAccessFlag::TRANSFER_WRITE);
+
+		constexpr uint32 counts[VISIBLE_DRAWS_HEADER_SIZE / sizeof(uint32)] = {};
+		pCmd->UpdateBuffer(pVisibleDraws, VISIBLE_DRAWS_HEADER_SIZE, 0, counts);
+
+		pCmd->PipelineBufferBarrier(pVisibleDraws, FPipelineStage::TRANSFER, FPipelineStage::COMPUTE_SHADER, FAccessFlag::TRANSFER_WRITE,
+		                            FAccessFlag::SHADER_READ | FAccessFlag::SHADER_WRITE);
+
+		// Workgroup counts per dimension are only guaranteed up to 65535 - wrap into rows, cull.comp skips the overhang
+		constexpr uint32 maxGroupsX = 65535;
+		const uint32     groupsX    = std::min(GetInstanceCount(), maxGroupsX);
+		pCmd->Dispatch(groupsX, (GetInstanceCount() + groupsX - 1) / groupsX, 1);
+	}
+
+	void SceneRenderBridge::RecordDraws(CommandBuffer* pCmd) const
+	{
+		Buffer* pVisibleDraws = GetVisibleDrawBuffer();
+		if (!pVisibleDraws || m_InstanceSlotCount == 0)
+			return;
+
+		// The draw count is the header's first word, the draws follow it - see shaders/cull.comp
+		pCmd->BindIndexBuffer(pVisibleDraws, GetVisibleIndexOffset(), EIndexType::UINT32);
+		pCmd->DrawIndexedIndirectCount(pVisibleDraws, VISIBLE_DRAWS_HEADER_SIZE, pVisibleDraws, 0, m_VisibleDrawCapacity);
+	}
+
+	void SceneRenderBridge::SetLodErrorTarget(const glm::mat4& projection, float viewportHeight, float maxPixelError)
+	{
+		// projection[1][1] is cot(fovY / 2) - a unit at distance 1 covers that much of half the viewport's height
+		m_CullParams.LodScale = maxPixelError > 0.0f ? std::abs(projection[1][1]) * 0.5f * viewportHeight / maxPixelError : 0.0f;
+	}
+
+	void SceneRenderBridge::SetInstanceFormat(EInstanceFormat format)
+	{
+		if (format == m_InstanceFormat)
+			return;
+
+		m_InstanceFormat            = format;
+		m_CullParams.InstanceFormat = static_cast<uint32>(format);
+
+		// Start over in the new layout - free slots are written right away, live ones on the next Update()
+		m_InstanceRows.clear();
+		m_CompactInstanceRows.clear();
+		m_InstanceDrawRows.clear();
+
+		GPUInstanceData freeRow = {};
+		freeRow.DrawIndex       = GPUInstanceData::INVALID_DRAW_INDEX;
+		for (uint32 slot = 0; slot < m_InstanceSlotCount; slot++)
+			WriteInstanceRow(slot, freeRow);
+
+		for (const auto& [entity, record] : m_Instances)
+			m_Scene.m_Registry.emplace_or_replace<DirtyTag>(entity);
+
+		// Capacity is counted in rows of the old layout - recreated by the next upload
+		ResourceManager::Destroy(m_InstanceBuffer.Handle);
+		ResourceManager::Destroy(m_InstanceDrawBuffer.Handle);
+		m_InstanceBuffer     = {};
+		m_InstanceDrawBuffer = {};
+	}
+
+	Buffer* SceneRenderBridge::GetVisibleDrawBuffer() const
+	{
+		return m_VisibleDrawsHandle.IsValid() ? ResourceManager::Resolve(m_VisibleDrawsHandle) : nullptr;
+	}
+
+	void SceneRenderBridge::OnMeshComponentConstructed(entt::registry& registry, entt::entity entity)
+	{
+		registry.emplace_or_replace<DirtyTag>(entity);
+	}
+
+	void SceneRenderBridge::OnMeshComponentDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		// Deferred to Update() - the registry is mid-removal here
+		m_RemovedEntities.push_back(entity);
+	}
+
+	void SceneRenderBridge::UpdateInstance(entt::entity entity, const MeshComponent& meshComp, const WorldTransformComponent& transform)
+	{
+		const MeshInstance instance   = meshComp.pModel->GetMeshInstance(meshComp.MeshIndex);
+		const uint32       batchIndex = GetOrCreateBatch(instance);
+
+		auto [it, inserted]    = m_Instances.try_emplace(entity);
+		InstanceRecord& record = it->second;
+		if (inserted)
+		{
+			if (!m_FreeInstanceSlots.empty())
 			{
-				hashToBatchIndex[hash] = pendingBatches.size();
-				pendingBatches.push_back({instance, {transform.GetTransform()}});
+				record.Slot = m_FreeInstanceSlots.back();
+				m_FreeInstanceSlots.pop_back();
 			}
 			else
 			{
-				pendingBatches[it->second].Transforms.push_back(transform.GetTransform());
+				record.Slot = m_InstanceSlotCount++;
 			}
+			AddBatchMember(batchIndex);
 		}
+		else if (record.BatchIndex != batchIndex) // mesh or material changed
+		{
+			AddBatchMember(batchIndex);
+			RemoveBatchMember(record.BatchIndex);
+		}
+		record.BatchIndex = batchIndex;
+
+		const GPUBatchData& batchRow = m_BatchRows[batchIndex];
+		GPUInstanceData     row      = {};
+		row.Transform                = transform.World;
+		row.MaterialIndex            = batchRow.MaterialIndex;
+		row.DrawIndex                = batchIndex;
+		row.BoundsIndex              = batchRow.BoundsIndex;
+		row.Flags                    = batchRow.Flags;
+		WriteInstanceRow(record.Slot, row);
+	}
 
-		m_DrawBatches.clear();
-		if (pendingBatches.empty())
+	void SceneRenderBridge::ReleaseInstance(entt::entity entity)
+	{
+		auto it = m_Instances.find(entity);
+		if (it == m_Instances.end())
 			return;
 
-		// Resolve unique meshes - copy each mesh's GPU vertex/index data into the combined buffers exactly
-		// once, in first-seen order, recording where each mesh's slice ends up.
-		std::unordered_map<Mesh*, MeshRange>     meshRanges;
-		std::vector<std::pair<Mesh*, MeshRange>> meshesToCopy;
+		const InstanceRecord record = it->second;
+		m_Instances.erase(it);
+		RemoveBatchMember(record.BatchIndex);
 
-		for (const PendingBatch& batch : pendingBatches)
+		// Free slots stay in the buffer until reused - the culling pass skips them
+		GPUInstanceData freeRow = {};
+		freeRow.DrawIndex       = GPUInstanceData::INVALID_DRAW_INDEX;
+		WriteInstanceRow(record.Slot, freeRow);
+		m_FreeInstanceSlots.push_back(record.Slot);
+	}
+
+	void SceneRenderBridge::WriteInstanceRow(uint32 slot, const GPUInstanceData& row)
+	{
+		// Slots are handed out in order, so a new one is at most one past the end
+		if (m_InstanceFormat == EInstanceFormat::COMPACT)
 		{
-			Mesh*       pMesh       = batch.Instance.pMesh.get();
-			BufferRange vertexRange = pMesh->GetMeshRange().Vertices;
-			BufferRange indexRange  = pMesh->GetMeshRange().Indices;
+			if (slot >= m_CompactInstanceRows.size())
+			{
+				m_CompactInstanceRows.resize(slot + 1);
+				m_InstanceDrawRows.resize(slot + 1);
+			}
+			m_CompactInstanceRows[slot] = GPUCompactInstanceData::FromTransform(row.Transform);
+			m_InstanceDrawRows[slot]    = row.DrawIndex;
+			m_InstanceDrawBuffer.DirtyRows.push_back(slot);
+		}
+		else
+		{
+			if (slot >= m_InstanceRows.size())
+				m_InstanceRows.resize(slot + 1);
+			m_InstanceRows[slot] = row;
+		}
 
-			if (meshRanges.contains(pMesh))
-				continue;
+		m_InstanceBuffer.DirtyRows.push_back(slot);
+	}
 
-			MeshRange range;
-			range.BaseVertex = vertexRange.ElementOffset;
-			range.BaseIndex  = indexRange.ElementOffset;
-			range.IndexCount = indexRange.ElementCount;
+	uint32 SceneRenderBridge::GetOrCreateBatch(const MeshInstance& instance)
+	{
+		const size_t hash = instance.GetUniqueHash();
+		if (auto it = m_BatchIndices.find(hash); it != m_BatchIndices.end())
+			return it->second;
 
-			meshRanges[pMesh] = range;
-			meshesToCopy.push_back({pMesh, range});
-		}
+		const uint32 batchIndex = AllocRow(m_DrawBatches, m_FreeBatches);
+		m_BatchIndices[hash]    = batchIndex;
+		m_BatchHashes.resize(m_DrawBatches.size());
+		m_DrawCommands.resize(m_DrawBatches.size());
+		m_BatchRows.resize(m_DrawBatches.size());
+		m_BatchHashes[batchIndex] = hash;
 
-		// Resolve unique materials - one GPUMaterialData row each.
-		std::unordered_map<Material*, uint32> materialIndices;
-		std::vector<GPUMaterialData>          materialData;
+		const MeshRange& range = instance.pMesh->GetMeshRange();
+		SceneDrawBatch&  batch = m_DrawBatches[batchIndex];
+		batch.BaseVertex       = range.Vertices.ElementOffset;
+		batch.BaseIndex        = range.Indices.ElementOffset;
+		batch.IndexCount       = range.Indices.ElementCount;
+		batch.InstanceCount    = 0;
+		batch.MeshletCount     = range.MaxLodMeshletCount;
+		batch.LodIndexCount    = range.MaxLodIndexCount;
+		batch.IndexType        = range.IndexType;
+		batch.pMesh            = instance.pMesh;
 
-		for (const PendingBatch& batch : pendingBatches)
-		{
-			Material* pMaterial = batch.Instance.pMaterial.get();
-			if (materialIndices.contains(pMaterial))
-				continue;
+		m_DrawCommands[batchIndex] = {batch.IndexCount, 0, batch.BaseIndex, static_cast<int32>(batch.BaseVertex), 0};
+		m_DrawCommandBuffer.DirtyRows.push_back(batchIndex);
+
+		GPUBatchData& row = m_BatchRows[batchIndex];
+		row.MaterialIndex = GetOrCreateMaterialIndex(instance.pMaterial.get());
+		row.BoundsIndex   = range.Bounds.ElementOffset;
+		row.Flags         = range.IndexType == EIndexType::UINT16 ? GPUInstanceData::FLAG_INDEX16 : 0;
+		m_BatchBuffer.DirtyRows.push_back(batchIndex);
+		return batchIndex;
+	}
+
+	void SceneRenderBridge::AddBatchMember(uint32 batchIndex)
+	{
+		SceneDrawBatch& batch = m_DrawBatches[batchIndex];
+		m_MaxVisibleDrawCount += (batch.MeshletCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE;
+		m_MaxVisibleIndexCount += batch.LodIndexCount;
 
-			materialIndices[pMaterial] = static_cast<uint32>(materialData.size());
-			materialData.push_back(BuildMaterialData(pMaterial));
+		m_DrawCommands[batchIndex].InstanceCount = ++batch.InstanceCount;
+		m_DrawCommandBuffer.DirtyRows.push_back(batchIndex);
+	}
+
+	void SceneRenderBridge::RemoveBatchMember(uint32 batchIndex)
+	{
+		SceneDrawBatch& batch = m_DrawBatches[batchIndex];
+		m_MaxVisibleDrawCount -= (batch.MeshletCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE;
+		m_MaxVisibleIndexCount -= batch.LodIndexCount;
+
+		if (--batch.InstanceCount == 0)
+		{
+			m_BatchIndices.erase(m_BatchHashes[batchIndex]);
+			batch = {};
+			m_FreeBatches.push_back(batchIndex);
 		}
 
-		// Lay out instances contiguously per batch and record each batch's draw parameters.
-		std::vector<GPUInstanceData> instanceData;
-		m_DrawBatches.reserve(pendingBatches.size());
+		m_DrawCommands[batchIndex].InstanceCount = batch.InstanceCount;
+		m_DrawCommands[batchIndex].IndexCount    = batch.IndexCount;
+		m_DrawCommandBuffer.DirtyRows.push_back(batchIndex);
+	}
 
-		for (const PendingBatch& batch : pendingBatches)
+	void SceneRenderBridge::RefreshBatchRanges()
+	{
+		// GeometryPool's compaction moved some meshes - point their templates at the new place
+		for (uint32 batchIndex = 0; batchIndex < static_cast<uint32>(m_DrawBatches.size()); batchIndex++)
 		{
-			const MeshRange& range       = meshRanges[batch.Instance.pMesh.get()];
-			const uint32     materialIdx = materialIndices[batch.Instance.pMaterial.get()];
-
-			SceneDrawBatch drawBatch;
-			drawBatch.BaseVertex    = range.BaseVertex;
-			drawBatch.BaseIndex     = range.BaseIndex;
-			drawBatch.IndexCount    = range.IndexCount;
-			drawBatch.FirstInstance = static_cast<uint32>(instanceData.size());
-			drawBatch.InstanceCount = static_cast<uint32>(batch.Transforms.size());
-			m_DrawBatches.push_back(drawBatch);
-
-			for (const glm::mat4& transform : batch.Transforms)
-				instanceData.push_back(GPUInstanceData{transform, materialIdx});
+			SceneDrawBatch& batch = m_DrawBatches[batchIndex];
+			if (batch.InstanceCount == 0)
+				continue;
+
+			const MeshRange& range = batch.pMesh->GetMeshRange();
+			if (range.Vertices.ElementOffset == batch.BaseVertex && range.Indices.ElementOffset == batch.BaseIndex)
+				continue;
+
+			batch.BaseVertex                        = range.Vertices.ElementOffset;
+			batch.BaseIndex                         = range.Indices.ElementOffset;
+			m_DrawCommands[batchIndex].FirstIndex   = batch.BaseIndex;
+			m_DrawCommands[batchIndex].VertexOffset = static_cast<int32>(batch.BaseVertex);
+			m_DrawCommandBuffer.DirtyRows.push_back(batchIndex);
 		}
 
-		UploadInstanceAndMaterialBuffers(instanceData, materialData);
+		m_GeometryGeneration = GeometryPool::GetGeneration();
 	}
 
-	Buffer* SceneRenderBridge::GetIndexBuffer() const
+	uint64 SceneRenderBridge::GetVisibleIndexOffset() const
 	{
-		return ResourceManager::Resolve(GeometryPool::GetIndexBufferHandle());
+		// Buffer references to the indices assume 16-byte alignment
+		const uint64 drawsEnd = VISIBLE_DRAWS_HEADER_SIZE + sizeof(DrawIndexedIndirectCommand) * m_VisibleDrawCapacity;
+		return (drawsEnd + 15) / 16 * 16;
+	}
+
+	uint32 SceneRenderBridge::GetOrCreateMaterialIndex(Material* pMaterial)
+	{
+		// Materials are never unloaded today, so their rows are only ever appended
+		auto [it, inserted] = m_MaterialIndices.try_emplace(pMaterial, static_cast<uint32>(m_MaterialRows.size()));
+		if (inserted)
+		{
+			m_MaterialRows.push_back(BuildMaterialData(pMaterial));
+			m_MaterialBuffer.DirtyRows.push_back(it->second);
+		}
+
+		return it->second;
 	}
 
 	GPUMaterialData SceneRenderBridge::BuildMaterialData(Material* pMaterial)
@@ -148,24 +368,114 @@ namespace Poly
 		return data;
 	}
 
-	void SceneRenderBridge::UploadInstanceAndMaterialBuffers(const std::vector<GPUInstanceData>& instances, const std::vector<GPUMaterialData>& materials)
+	template<typename Row>
+	bool SceneRenderBridge::UploadRows(RowBuffer& rowBuffer, const std::vector<Row>& rows, FBufferUsage usage, const char* pDebugName)
 	{
-		const uint64 instanceSize = sizeof(GPUInstanceData) * instances.size();
-		if (!m_InstanceBufferHandle.IsValid())
-			m_InstanceBufferHandle = ResourceManager::CreateStorageBuffer(instanceSize, EMemoryUsage::CPU_VISIBLE, "SceneRenderBridge.Instances");
-		else
-			m_InstanceBufferHandle = ResourceManager::ResizeBuffer(m_InstanceBufferHandle, instanceSize);
-		ResourceManager::UploadBufferData(m_InstanceBufferHandle, instances.data(), instanceSize);
+		const uint32 rowCount = static_cast<uint32>(rows.size());
+		if (rowCount == 0)
+			return false;
 
-		const uint64 materialSize = sizeof(GPUMaterialData) * materials.size();
-		if (!m_MaterialBufferHandle.IsValid())
-			m_MaterialBufferHandle = ResourceManager::CreateStorageBuffer(materialSize, EMemoryUsage::CPU_VISIBLE, "SceneRenderBridge.Materials");
-		else
-			m_MaterialBufferHandle = ResourceManager::ResizeBuffer(m_MaterialBufferHandle, materialSize);
-		ResourceManager::UploadBufferData(m_MaterialBufferHandle, materials.data(), materialSize);
+		// Outgrown - replace with headroom and upload everything, instead of going through ResizeBuffer(), whose
+		// copy of the old contents would land after (and overwrite) this frame's sparse uploads
+		if (rowCount > rowBuffer.Capacity)
+		{
+			ResourceManager::Destroy(rowBuffer.Handle);
+			rowBuffer.Capacity = std::max(rowCount, rowBuffer.Capacity + rowBuffer.Capacity / 2);
+			rowBuffer.Handle   = ResourceManager::CreateBuffer(sizeof(Row) * rowBuffer.Capacity, usage, EMemoryUsage::GPU_ONLY, pDebugName);
+			ResourceManager::UploadBufferData(rowBuffer.Handle, rows.data(), sizeof(Row) * rowCount);
+			rowBuffer.DirtyRows.clear();
+			return true;
+		}
+
+		// One upload per run of consecutive dirty rows
+		std::vector<uint32>& dirty = rowBuffer.DirtyRows;
+		std::sort(dirty.begin(), dirty.end());
+		dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+		for (size_t first = 0; first < dirty.size();)
+		{
+			size_t last = first;
+			while (last + 1 < dirty.size() && dirty[last + 1] == dirty[last] + 1)
+				last++;
+
+			const uint32 rowOffset = dirty[first];
+			const uint32 runLength = dirty[last] - rowOffset + 1;
+			ResourceManager::UploadBufferData(rowBuffer.Handle, rows.data() + rowOffset, sizeof(Row) * runLength, sizeof(Row) * rowOffset);
+			first = last + 1;
+		}
+		dirty.clear();
+
+		return false;
+	}
+
+	void SceneRenderBridge::UploadChanges()
+	{
+		const FBufferUsage storageUsage = FBufferUsage::STORAGE_BUFFER | FBufferUsage::SHADER_DEVICE_ADDRESS;
+
+		const bool instancesRecreated = m_InstanceFormat == EInstanceFormat::COMPACT
+		                                    ? UploadRows(m_InstanceBuffer, m_CompactInstanceRows, storageUsage, "SceneRenderBridge.Instances")
+		                                    : UploadRows(m_InstanceBuffer, m_InstanceRows, storageUsage, "SceneRenderBridge.Instances");
+		if (instancesRecreated)
+			m_pProgramInstance->UpdateResource(Scene::INSTANCE_RESOURCE_NAME_2, m_InstanceBuffer.Handle);
 
+		// Full rows carry their own DrawIndex, so the stream only needs something bound in its slot then
+		if (m_InstanceFormat == EInstanceFormat::COMPACT)
+		{
+			if (UploadRows(m_InstanceDrawBuffer, m_InstanceDrawRows, storageUsage, "SceneRenderBridge.InstanceDraws"))
+				m_pProgramInstance->UpdateResource(Scene::INSTANCE_DRAWS_RESOURCE_NAME_2, m_InstanceDrawBuffer.Handle);
+		}
+		else if (instancesRecreated)
+		{
+			m_pProgramInstance->UpdateResource(Scene::INSTANCE_DRAWS_RESOURCE_NAME_2, m_InstanceBuffer.Handle);
+		}
+		if (UploadRows(m_MaterialBuffer, m_MaterialRows, storageUsage, "SceneRenderBridge.Materials"))
+			m_pProgramInstance->UpdateResource(Scene::MATERIAL_RESOURCE_NAME_2, m_MaterialBuffer.Handle);
+		if (UploadRows(m_DrawCommandBuffer, m_DrawCommands, storageUsage, "SceneRenderBridge.DrawCommands"))
+			m_pProgramInstance->UpdateResource(Scene::DRAW_COMMANDS_RESOURCE_NAME_2, m_DrawCommandBuffer.Handle);
+		if (UploadRows(m_BatchBuffer, m_BatchRows, storageUsage, "SceneRenderBridge.Batches"))
+			m_pProgramInstance->UpdateResource(Scene::BATCHES_RESOURCE_NAME_2, m_BatchBuffer.Handle);
+
+		// Culling output - GPU-written only, the counts, draws and compacted indices, sized for every instance drawing its
+		// largest LOD in full. Culling can't overrun it, so it needs no bounds checks.
+		if (m_MaxVisibleDrawCount > m_VisibleDrawCapacity || m_MaxVisibleIndexCount > m_VisibleIndexCapacity)
+		{
+			const FBufferUsage visibleDrawsUsage = FBufferUsage::INDIRECT_BUFFER | FBufferUsage::INDEX_BUFFER | storageUsage;
+
+			ResourceManager::Destroy(m_VisibleDrawsHandle);
+			m_VisibleDrawCapacity  = std::max(m_MaxVisibleDrawCount, m_VisibleDrawCapacity + m_VisibleDrawCapacity / 2);
+			m_VisibleIndexCapacity = std::max(m_MaxVisibleIndexCount, m_VisibleIndexCapacity + m_VisibleIndexCapacity / 2);
+			m_VisibleDrawsHandle   = ResourceManager::CreateBuffer(GetVisibleIndexOffset() + sizeof(uint32) * m_VisibleIndexCapacity, visibleDrawsUsage,
+			                                                       EMemoryUsage::GPU_ONLY, "SceneRenderBridge.VisibleDraws");
+
+			m_pProgramInstance->UpdateResource(Scene::VISIBLE_DRAWS_RESOURCE_NAME_2, m_VisibleDrawsHandle);
+		}
+
+		// Culling reads the meshes' indices to compact them. An index type nothing has been uploaded in yet has no
+		// buffer - and no batch to read it either, so the other one keeps its slot bound.
+		const BufferHandle indices   = GeometryPool::GetIndexBufferHandle(EIndexType::UINT32);
+		const BufferHandle indices16 = GeometryPool::GetIndexBufferHandle(EIndexType::UINT16);
+		m_pProgramInstance->UpdateResource(Scene::INDICES_RESOURCE_NAME_2, indices.IsValid() ? indices : indices16);
+		m_pProgramInstance->UpdateResource(Scene::INDICES16_RESOURCE_NAME_2, indices16.IsValid() ? indices16 : indices);
+
+		// GeometryPool's arenas get new handles whenever loading a model grows them
 		m_pProgramInstance->UpdateResource(Scene::VERTICES_RESOURCE_NAME_2, GeometryPool::GetVertexBufferHandle());
-		m_pProgramInstance->UpdateResource(Scene::INSTANCE_RESOURCE_NAME_2, m_InstanceBufferHandle);
-		m_pProgramInstance->UpdateResource(Scene::MATERIAL_RESOURCE_NAME_2, m_MaterialBufferHandle);
+		m_pProgramInstance->UpdateResource(Scene::MESH_BOUNDS_RESOURCE_NAME_2, GeometryPool::GetBoundsBufferHandle());
+		m_pProgramInstance->UpdateResource(Scene::MESHLETS_RESOURCE_NAME_2, GeometryPool::GetMeshletBufferHandle());
+		m_pProgramInstance->UpdateResource(Scene::MESH_LODS_RESOURCE_NAME_2, GeometryPool::GetLodBufferHandle());
+	}
+
+	void SceneRenderBridge::WriteCullParams()
+	{
+		// Never the copy the GPU may still be reading - see CULL_PARAMS_BUFFER_COUNT
+		m_CullParamsIndex          = (m_CullParamsIndex + 1) % CULL_PARAMS_BUFFER_COUNT;
+		BufferHandle& paramsHandle = m_CullParamsHandles[m_CullParamsIndex];
+		if (!paramsHandle.IsValid())
+			paramsHandle = ResourceManager::CreateUniformBuffer(sizeof(GPUCullParams), "SceneRenderBridge.CullParams");
+
+		m_CullParams.InstanceCount      = GetInstanceCount();
+		m_CullParams.VertexFormat       = static_cast<uint32>(GeometryPool::GetVertexFormat());
+		m_CullParams.VisibleIndexOffset = static_cast<uint32>(GetVisibleIndexOffset());
+		ResourceManager::UploadBufferData(paramsHandle, &m_CullParams, sizeof(GPUCullParams));
+		m_pProgramInstance->UpdateResource(Scene::CULL_PARAMS_RESOURCE_NAME_2, paramsHandle);
 	}
 } // namespace Poly
@@ -1,74 +1,206 @@
 #pragma once
 
+#include "Platform/API/CommandBuffer.h"
 #include "Poly/Core/Core.h"
 #include "Poly/RenderGraph/ResourceManager.h"
+#include "Poly/RenderGraph/Shader/GPUCullParams.h"
 #include "Poly/RenderGraph/Shader/GPUInstanceData.h"
 #include "Poly/RenderGraph/Shader/GPUMaterialData.h"
 
 #include <array>
+#include <entt/entt.hpp>
 #include <unordered_map>
 #include <vector>
 
 namespace Poly
 {
 	class Scene;
+	class Mesh;
 	class Material;
 	class Buffer;
 	class RenderProgramInstance;
+	struct MeshInstance;
+	struct MeshComponent;
+	struct WorldTransformComponent;
 
 	struct SceneDrawBatch
 	{
-		uint32 BaseVertex    = 0;
-		uint32 BaseIndex     = 0;
-		uint32 IndexCount    = 0;
-		uint32 FirstInstance = 0;
-		uint32 InstanceCount = 0;
+		uint32     BaseVertex    = 0;
+		uint32     BaseIndex     = 0;
+		uint32     IndexCount    = 0;                  // of all LODs, 0 = free batch slot
+		uint32     InstanceCount = 0;                  // member entities, wherever their instance slots are
+		uint32     MeshletCount  = 0;                  // of the LOD with the most, see MeshRange::MaxLodMeshletCount
+		uint32     LodIndexCount = 0;                  // of the LOD with the most, see MeshRange::MaxLodIndexCount
+		EIndexType IndexType     = EIndexType::UINT32; // which of GeometryPool's index buffers BaseIndex points into
+		Ref<Mesh>  pMesh;                              // kept alive while drawn, and re-read when GeometryPool moves it
 	};
 
 	// TODO: Rename to RenderScene when old RenderScene is deprecated
 	/*
-	 * Entities sharing the same (Mesh, Material) pair are batched into one instanced draw call.
-	 * A pass would consume this as:
+	 * Mirrors the scene's MeshComponent entities into GPU instance/material/draw buffers, incrementally:
+	 * every entity owns a persistent instance slot and every (Mesh, Material) pair a persistent batch slot,
+	 * and Update() only rewrites the rows of entities tagged with DirtyTag (see Entity::MarkDirty()) or
+	 * removed since the last call, uploading them as sparse ranges. Frame cost scales with the number of
+	 * changed entities, not with the scene.
 	 *
-	 *   .WithExecuteFn([pBridge](ExecuteContext& ctx) {
-	 *       CommandBuffer* pCmd = ctx.GetCommandBuffer();
-	 *       pCmd->BindIndexBuffer(pBridge->GetIndexBuffer(), 0, EIndexType::UINT32);
-	 *       for (const SceneDrawBatch& b : pBridge->GetDrawBatches())
-	 *           pCmd->DrawIndexedInstanced(b.IndexCount, b.InstanceCount, b.BaseIndex, b.BaseVertex, b.FirstInstance);
-	 *   });
+	 * Since slots are persistent, a batch's members aren't contiguous in the instance buffer, so a batch can't be
+	 * drawn as one instanced command. Its row in Scene::DRAW_COMMANDS_RESOURCE_NAME_2 only records its mesh range
+	 * and member count (in DrawIndexedIndirectCommand's layout), and is never drawn from. A compute pass
+	 * (shaders/cull.comp) calling RecordCulling() builds the actual draws from it: it tests every instance's mesh
+	 * bounds against the camera frustum, picks the coarsest level of detail (see MeshLod) whose error projects
+	 * below the target set with SetLodErrorTarget(), then tests each of that level's meshlets the same way, plus a
+	 * backface test against the meshlet's normal cone. There's no occlusion test - the graph can't build a
+	 * hierarchical-Z pyramid yet (depth isn't sampleable through the bindless heap, which has no storage images
+	 * either), so everything in the frustum is drawn. The survivors' indices are copied into
+	 * one compacted index buffer in Scene::VISIBLE_DRAWS_RESOURCE_NAME_2, and every round of an instance's meshlets
+	 * that has any appends an indexed draw of them - with the mesh's VertexOffset and the instance slot as its
+	 * FirstInstance - and bumps the buffer's draw count. RecordDraws() then draws the whole scene with one
+	 * DrawIndexedIndirectCount() from that buffer. The culling pass must WriteGlobal() it and the drawing pass
+	 * MapGlobal() it (as an EResourceType::IndirectBuffer), so the graph orders the two and syncs the writes against
+	 * the indirect and index reads:
 	 *
+	 *   .WithExecuteFn([pBridge](ExecuteContext& ctx) { pBridge->RecordDraws(ctx.GetCommandBuffer()); });
 	 */
 	class SceneRenderBridge
 	{
 	public:
+		static constexpr uint32 CULL_GROUP_SIZE           = 64; // local_size_x of shaders/cull.comp - one group per instance slot, a thread per meshlet
+		static constexpr uint64 VISIBLE_DRAWS_HEADER_SIZE = 16; // draw count, index count and padding ahead of the visible draws
+
+		// Cull params are host-visible and rewritten by every Update(), so each frame gets its own copy. Update() runs
+		// before the frame's Execute(), which only waits for the frame FRAMES_IN_FLIGHT back once it starts - one more
+		// copy than frames in flight means the one written was last read by a frame the previous Execute() waited for.
+		static constexpr uint32 CULL_PARAMS_BUFFER_COUNT = ResourceManager::FRAMES_IN_FLIGHT + 1;
+
+		// Layout of the instance buffer (Scene::INSTANCE_RESOURCE_NAME_2). Shaders read it through LoadInstance()
+		// in common/bindless.glsl, which picks the layout from GPUCullParams::InstanceFormat - so any pass fetching
+		// instances also has to map Scene::CULL_PARAMS_RESOURCE_NAME_2.
+		enum class EInstanceFormat : uint32
+		{
+			FULL    = 0, // GPUInstanceData, 80 bytes
+			COMPACT = 1  // GPUCompactInstanceData, 48 bytes of affine transform plus the DrawIndex in Scene::INSTANCE_DRAWS_RESOURCE_NAME_2,
+			             // the rest read from GPUBatchData
+		};
+
 		SceneRenderBridge(Scene& scene, Ref<RenderProgramInstance> pProgramInstance);
-		~SceneRenderBridge() = default;
+		~SceneRenderBridge();
 		CLASS_REMOVE_COPY(SceneRenderBridge);
 
 		void Update();
 
+		/*
+		 * Records the culling dispatch into a compute pass - resets the visible draw and index counts, then runs one
+		 * workgroup per instance slot. Expects the pass's pipeline to be shaders/cull.comp.
+		 * @param pCmd - the compute pass's command buffer
+		 */
+		void RecordCulling(CommandBuffer* pCmd) const;
+
+		/*
+		 * Records the draws of everything the culling pass let through - binds the compacted indices and draws them with
+		 * one indirect call, as many draws as culling wrote. Pipeline and push constants are left to the caller.
+		 * @param pCmd - the drawing pass's command buffer
+		 */
+		void RecordDraws(CommandBuffer* pCmd) const;
+
+		/*
+		 * Sets how far the culling pass may coarsen an instance's level of detail - the coarsest LOD whose error,
+		 * projected at the instance's distance, stays within maxPixelError is drawn. Cheap to call every frame, before
+		 * the Update() it should take effect on.
+		 * @param projection - the camera's projection matrix
+		 * @param viewportHeight - in pixels
+		 * @param maxPixelError - allowed error on screen in pixels, 0 = always draw LOD 0
+		 */
+		void SetLodErrorTarget(const glm::mat4& projection, float viewportHeight, float maxPixelError);
+
+		/*
+		 * Switches the instance buffer's layout. Rebuilds the whole buffer on the next Update(), so meant to be set
+		 * once at setup rather than toggled per frame.
+		 * @param format - new layout, COMPACT requires every transform to be affine (no projection)
+		 */
+		void            SetInstanceFormat(EInstanceFormat format);
+		EInstanceFormat GetInstanceFormat() const { return m_InstanceFormat; }
+
 		const std::vector<SceneDrawBatch>& GetDrawBatches() const { return m_DrawBatches; }
-		Buffer*                            GetIndexBuffer() const;
+		uint32                             GetDrawCount() const { return static_cast<uint32>(m_DrawBatches.size()); }
+		uint32                             GetInstanceCount() const { return m_InstanceSlotCount; } // slots in use or free
+		Buffer*                            GetVisibleDrawBuffer() const;
 
 	private:
-		struct MeshRange
+		// Where an entity's instance lives
+		struct InstanceRecord
 		{
-			uint32 BaseVertex;
-			uint32 BaseIndex;
-			uint32 IndexCount;
+			uint32 Slot       = 0;
+			uint32 BatchIndex = 0;
 		};
 
+		// GPU copy of a CPU-side row array - recreated (and fully re-uploaded) when the rows outgrow it,
+		// otherwise only the rows listed in DirtyRows are uploaded
+		struct RowBuffer
+		{
+			BufferHandle        Handle;
+			uint32              Capacity = 0; // in rows
+			std::vector<uint32> DirtyRows;
+		};
+
+		void OnMeshComponentConstructed(entt::registry& registry, entt::entity entity);
+		void OnMeshComponentDestroyed(entt::registry& registry, entt::entity entity);
+
+		void   UpdateInstance(entt::entity entity, const MeshComponent& meshComp, const WorldTransformComponent& transform);
+		void   ReleaseInstance(entt::entity entity);
+		void   WriteInstanceRow(uint32 slot, const GPUInstanceData& row);
+		uint32 GetOrCreateBatch(const MeshInstance& instance);
+		void   AddBatchMember(uint32 batchIndex);
+		void   RemoveBatchMember(uint32 batchIndex);
+		void   RefreshBatchRanges();
+		uint64 GetVisibleIndexOffset() const; // in the visible draw buffer
+		uint32 GetOrCreateMaterialIndex(Material* pMaterial);
+
 		GPUMaterialData BuildMaterialData(Material* pMaterial);
-		void            UploadInstanceAndMaterialBuffers(const std::vector<GPUInstanceData>& instances, const std::vector<GPUMaterialData>& materials);
+
+		template<typename Row>
+		bool UploadRows(RowBuffer& rowBuffer, const std::vector<Row>& rows, FBufferUsage usage, const char* pDebugName);
+		void UploadChanges();
+		void WriteCullParams();
 
 		Scene&                     m_Scene;
 		Ref<RenderProgramInstance> m_pProgramInstance;
 
 		std::unordered_map<Material*, std::array<uint32, 6>> m_MaterialTextureCache;
 
-		std::vector<SceneDrawBatch> m_DrawBatches;
+		std::unordered_map<entt::entity, InstanceRecord> m_Instances;
+		std::vector<entt::entity>                        m_RemovedEntities; // since the last Update()
+		std::vector<GPUInstanceData>                     m_InstanceRows;        // indexed by instance slot, EInstanceFormat::FULL only
+		std::vector<GPUCompactInstanceData>              m_CompactInstanceRows; // indexed by instance slot, EInstanceFormat::COMPACT only
+		std::vector<uint32>                              m_InstanceDrawRows;    // indexed by instance slot, the compact rows' DrawIndex
+		std::vector<uint32>                              m_FreeInstanceSlots;
+		uint32                                           m_InstanceSlotCount = 0;
+		EInstanceFormat                                  m_InstanceFormat    = EInstanceFormat::FULL;
+
+		std::unordered_map<size_t, uint32>      m_BatchIndices; // MeshInstance::GetUniqueHash() -> batch slot
+		std::vector<size_t>                     m_BatchHashes;  // indexed by batch slot
+		std::vector<SceneDrawBatch>             m_DrawBatches;  // indexed by batch slot
+		std::vector<DrawIndexedIndirectCommand> m_DrawCommands; // indexed by batch slot, mesh range and member count read by culling
+		std::vector<GPUBatchData>               m_BatchRows;    // indexed by batch slot
+		std::vector<uint32>                     m_FreeBatches;
+		uint32                                  m_GeometryGeneration = 0; // GeometryPool::GetGeneration() the batches' ranges are from
+
+		std::unordered_map<Material*, uint32> m_MaterialIndices;
+		std::vector<GPUMaterialData>          m_MaterialRows;
+
+		RowBuffer    m_InstanceBuffer;
+		RowBuffer    m_InstanceDrawBuffer;
+		RowBuffer    m_MaterialBuffer;
+		RowBuffer    m_DrawCommandBuffer;
+		RowBuffer    m_BatchBuffer;
+		BufferHandle m_VisibleDrawsHandle;
+		uint32       m_VisibleDrawCapacity  = 0; // in draws - the compacted indices follow
+		uint32       m_VisibleIndexCapacity = 0; // in 32-bit indices
+		uint32       m_MaxVisibleDrawCount  = 0; // every instance drawing its largest LOD in full, the most culling can emit
+		uint32       m_MaxVisibleIndexCount = 0; // likewise
+
+		std::array<BufferHandle, CULL_PARAMS_BUFFER_COUNT> m_CullParamsHandles;
+		uint32                                             m_CullParamsIndex = 0; // copy the last Update() wrote
 
-		BufferHandle m_InstanceBufferHandle;
-		BufferHandle m_MaterialBufferHandle;
+		GPUCullParams m_CullParams = {};
 	};
 } // namespace Poly
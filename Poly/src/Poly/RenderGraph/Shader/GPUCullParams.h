@@ -0,0 +1,18 @@
+#pragma once
+
+namespace Poly
+{
+	// Struct defining the layout of the culling parameters buffer (Scene::CULL_PARAMS_RESOURCE_NAME_2).
+	// This layout must match CullParamsBuffer in common/bindless.glsl. Also read by every shader that fetches
+	// instances or vertices, for InstanceFormat/VertexFormat.
+	struct GPUCullParams
+	{
+		uint32 InstanceCount;
+		uint32 InstanceFormat;     // layout of the instance buffer, a SceneRenderBridge::EInstanceFormat
+		uint32 VertexFormat;       // layout of the vertex buffer, a GeometryPool::EVertexFormat
+		uint32 VisibleIndexOffset; // bytes into the visible draw buffer the compacted indices start at, see SceneRenderBridge::RecordDraws()
+		float  LodScale;           // pixels per unit at distance 1 over the allowed pixel error, 0 = always LOD 0 (see SceneRenderBridge::SetLodErrorTarget())
+	};
+	static_assert(sizeof(GPUCullParams) == 20, "GPUCullParams must match common/bindless.glsl's CullParamsBuffer layout");
+
+} // namespace Poly
@@ -8,9 +8,40 @@ namespace Poly
 	{
 		glm::mat4 Transform;
 		uint32    MaterialIndex;
-		uint32    _Pad[3];
+		uint32    DrawIndex;   // SceneDrawBatch (and source draw command) the instance belongs to, INVALID_DRAW_INDEX = free slot
+		uint32    BoundsIndex; // entry in GeometryPool's bounds buffer
+		uint32    Flags;       // FLAG_* bits, properties of the instance's mesh the culling pass needs
+
+		static constexpr uint32 INVALID_DRAW_INDEX = ~0u;
+		static constexpr uint32 FLAG_INDEX16       = 1u << 0; // mesh indices are in GeometryPool's 16-bit index buffer
 	};
 	static_assert(offsetof(GPUInstanceData, MaterialIndex) == 64, "GPUInstanceData::MaterialIndex must sit right after Transform");
 	static_assert(sizeof(GPUInstanceData) == 80, "GPUInstanceData must match common/bindless.glsl's GPUInstanceData layout (80-byte std430 stride)");
 
+	// What every instance of a SceneDrawBatch shares, indexed by batch slot in SceneRenderBridge's batch buffer - the
+	// compact instance layout only keeps the DrawIndex to look it up with. Must match BatchData in common/bindless.glsl.
+	struct GPUBatchData
+	{
+		uint32 MaterialIndex;
+		uint32 BoundsIndex;
+		uint32 Flags; // GPUInstanceData::FLAG_* of the batch's mesh
+		uint32 _Pad;
+	};
+	static_assert(sizeof(GPUBatchData) == 16, "GPUBatchData must match common/bindless.glsl's BatchData layout (16-byte std430 stride)");
+
+	// Compact alternative layout, used when SceneRenderBridge is set to EInstanceFormat::COMPACT - only the transform's
+	// affine rows, translation in w. The DrawIndex goes to a parallel stream of its own (Scene::INSTANCE_DRAWS_RESOURCE_NAME_2),
+	// everything else comes from the batch's GPUBatchData. Must match CompactInstanceData in common/bindless.glsl.
+	struct GPUCompactInstanceData
+	{
+		glm::vec4 AffineRows[3];
+
+		static GPUCompactInstanceData FromTransform(const glm::mat4& transform)
+		{
+			const glm::mat4 rows = glm::transpose(transform);
+			return {{rows[0], rows[1], rows[2]}};
+		}
+	};
+	static_assert(sizeof(GPUCompactInstanceData) == 48, "GPUCompactInstanceData must match common/bindless.glsl's CompactInstanceData layout (48-byte std430 stride)");
+
 } // namespace Poly
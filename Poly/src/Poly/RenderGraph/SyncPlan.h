@@ -64,7 +64,9 @@ namespace Poly
 	struct PassSyncPlan
 	{
 		size_t                        PassIndex = 0;
-		BarrierGroup                  PreBarriers;              // same-queue transitions, batched into one call
+		BarrierGroup                  PreBarriers;              // same-queue transitions, batched into one call - includes the
+		                                                        // aliasing barrier for a transient whose memory was last used
+		                                                        // by another one (src = that resource's last stage/access)
 		std::vector<QueueAcquirePlan> Acquires;                 // cross-queue acquires needed before this pass runs
 		std::vector<QueueReleasePlan> PostReleases;             // cross-queue releases to run right after this pass -
 		                                                        // attached here because this pass was the resource's
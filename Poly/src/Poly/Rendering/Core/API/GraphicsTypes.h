@@ -95,8 +95,53 @@ namespace Poly
 		R32G32B32_SFLOAT    = 6,
 		R32G32B32A32_SFLOAT = 7,
 		DEPTH_STENCIL       = 8, // Shorthand for using the most optimal depth-stencil format that is supported
+		BC4_UNORM           = 9, // One channel (R), 4x4 blocks of 8 bytes
+		BC5_UNORM           = 10, // Two channels (RG), 4x4 blocks of 16 bytes - for normal maps
+		BC7_UNORM           = 11, // RGBA, 4x4 blocks of 16 bytes
 	};
 
+	inline bool IsBlockCompressed(EFormat format)
+	{
+		return format == EFormat::BC4_UNORM || format == EFormat::BC5_UNORM || format == EFormat::BC7_UNORM;
+	}
+
+	// Texels along each side of a block - 1 for formats that aren't block compressed
+	inline uint32 GetFormatBlockExtent(EFormat format)
+	{
+		return IsBlockCompressed(format) ? 4 : 1;
+	}
+
+	// Bytes per block, or per texel for formats that aren't block compressed
+	inline uint32 GetFormatBlockSize(EFormat format)
+	{
+		switch (format)
+		{
+		case EFormat::R8G8B8A8_UNORM:
+		case EFormat::B8G8R8A8_UNORM:
+		case EFormat::D24_UNORM_S8_UINT:
+		case EFormat::R32_SFLOAT:
+			return 4;
+		case EFormat::R32G32_SFLOAT:
+		case EFormat::BC4_UNORM:
+			return 8;
+		case EFormat::R32G32B32_SFLOAT:
+			return 12;
+		case EFormat::R32G32B32A32_SFLOAT:
+		case EFormat::BC5_UNORM:
+		case EFormat::BC7_UNORM:
+			return 16;
+		default:
+			return 0;
+		}
+	}
+
+	// Bytes of a tightly packed width x height image, e.g. one mip level
+	inline uint64 GetFormatImageSize(EFormat format, uint32 width, uint32 height)
+	{
+		const uint32 extent = GetFormatBlockExtent(format);
+		return static_cast<uint64>((width + extent - 1) / extent) * ((height + extent - 1) / extent) * GetFormatBlockSize(format);
+	}
+
 	enum class FTextureUsage : uint32
 	{
 		NONE                     = 0,
@@ -23,7 +23,10 @@ namespace Poly
 {
 	ImGuiPass::ImGuiPass() = default;
 
-	ImGuiPass::~ImGuiPass() = default;
+	ImGuiPass::~ImGuiPass()
+	{
+		ResourceManager::Destroy(m_FontTexture);
+	}
 
 	PassReflection ImGuiPass::Reflect()
 	{
@@ -260,7 +263,8 @@ namespace Poly
 		io.Fonts->GetTexDataAsRGBA32(&fontData, &width, &height);
 
 		// Setup texture
-		m_pFontTexture = AssetLoader::LoadTextureFromMemory(fontData, width, height, 4, EFormat::R8G8B8A8_UNORM);
+		m_FontTexture  = AssetLoader::LoadTextureFromMemory(fontData, width, height, 4, EFormat::R8G8B8A8_UNORM, nullptr, "ImGui Font Atlas");
+		m_pFontTexture = Ref<Texture>(ResourceManager::Resolve(m_FontTexture), [](auto*) {}); // ResourceManager owns it
 
 		// Setup texture view
 		TextureViewDesc viewDesc = {};
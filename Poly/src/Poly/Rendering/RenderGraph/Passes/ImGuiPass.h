@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../RenderPass.h"
+#include "Poly/RenderGraph/ResourceManager.h"
 
 namespace Poly
 {
@@ -42,7 +43,8 @@ namespace Poly
 
 		PushConstantBlock m_PushConstantData;
 
-		Ref<Texture>     m_pFontTexture;
+		TextureHandle    m_FontTexture;
+		Ref<Texture>     m_pFontTexture; // m_FontTexture, without ownership - for the render graph's Resource
 		Ref<TextureView> m_pFontTextureView;
 		Ref<Sampler>     m_pFontSampler;
 		Ref<Buffer>      m_pVertexBuffer;
@@ -24,7 +24,7 @@ namespace Poly
 		m_TotalMeshCount = 0;
 
 		// TODO: When/if possible, only go through those that are dirty and write that data instead of all of them
-		auto view = m_Scene.m_Registry.view<MeshComponent, TransformComponent>();
+		auto view = m_Scene.m_Registry.view<MeshComponent, WorldTransformComponent>();
 		for (auto [entity, meshComp, transform] : view.each())
 		{
 			MeshInstance meshInstance = meshComp.pModel->GetMeshInstance(meshComp.MeshIndex);
@@ -35,12 +35,12 @@ namespace Poly
 				// TODO: If transform matrix is needed; add it here
 				SceneBatch& batch = m_SceneBatches[m_InstanceHashToIndex[hash]];
 				batch.InstanceCount++;
-				batch.Matrices.push_back(transform.GetTransform());
+				batch.Matrices.push_back(transform.World);
 			}
 			else
 			{
 				m_InstanceHashToIndex[hash] = static_cast<uint32>(m_SceneBatches.size());
-				m_SceneBatches.push_back({meshInstance, 1, {transform.GetTransform()}});
+				m_SceneBatches.push_back({meshInstance, 1, {transform.World}});
 			}
 
 			m_TotalMeshCount++;
@@ -5,16 +5,19 @@
 #include "Poly/Core/RenderAPI.h"
 #include "Poly/Core/Window.h"
 #include "Poly/Events/WindowEvent.h"
+#include "Poly/RenderGraph/RenderProgram.h"
 #include "Poly/RenderGraph/RenderProgramInstance.h"
 #include "Poly/RenderGraph/RenderView.h"
 #include "Poly/RenderGraph/ResourceManager.h"
+#include "Poly/Resources/GeometryPool.h"
 #include "polypch.h"
 #include "RenderGraph/RenderGraphProgram.h"
 #include "RenderGraph/Resource.h"
 
 namespace Poly
 {
-	constexpr const uint32 BUFFER_COUNT = 3;
+	constexpr const uint32  BUFFER_COUNT      = 3;
+	constexpr const EFormat BACKBUFFER_FORMAT  = EFormat::B8G8R8A8_UNORM;
 
 	Renderer::Renderer() {}
 
@@ -45,12 +48,28 @@ namespace Poly
 
 	void Renderer::SetRenderProgram(Ref<RenderProgram> pRenderProgram)
 	{
+		m_pQueuedRenderProgram = std::move(pRenderProgram);
+		if (!m_pQueuedRenderProgram)
+			return;
+
+		// All windows render into BACKBUFFER_FORMAT swapchains, which is what "$Color" resolves to
+		m_pQueuedRenderProgram->PrecompilePipelines(BACKBUFFER_FORMAT);
+
 		// TODO: Handle render program init in a clearer way
 		// This is done so now so that UpdateResource can be called in the program instance instead of after a Render call
-		m_pQueuedRenderProgram = std::move(pRenderProgram);
 		SwapRenderProgramIfQueued();
 	}
 
+	bool Renderer::IsRenderProgramPending() const
+	{
+		return m_pQueuedRenderProgram != nullptr;
+	}
+
+	float Renderer::GetRenderProgramLoadProgress() const
+	{
+		return m_pQueuedRenderProgram ? m_pQueuedRenderProgram->GetPipelineCompileProgress() : 1.0f;
+	}
+
 	RenderProgramInstance* Renderer::GetRenderProgramInstance(Window* pWindow) const
 	{
 		for (const WindowContext& windowCtx : m_Windows)
@@ -70,7 +89,7 @@ namespace Poly
 		    .Width       = pWindow->GetWidth(),
 		    .Height      = pWindow->GetHeight(),
 		    .BufferCount = BUFFER_COUNT,
-		    .Format      = EFormat::B8G8R8A8_UNORM};
+		    .Format      = BACKBUFFER_FORMAT};
 		Ref<SwapChain> pSwapChain = RenderAPI::CreateSwapChain(&swapChainDesc);
 
 		WindowContext context{pWindow, pSwapChain};
@@ -87,8 +106,14 @@ namespace Poly
 
 	void Renderer::Render()
 	{
+		SwapRenderProgramIfQueued();
+		GeometryPool::Update(); // queues compaction copies for the flush below
 		ResourceManager::Update();
 
+		// The old render graph doesn't wait on the upload timeline for the textures it samples - block on it here
+		if (m_pRenderGraphProgram)
+			ResourceManager::WaitForUploads();
+
 		for (const WindowContext& windowCtx : m_Windows)
 		{
 			if (m_pRenderGraphProgram)
@@ -142,6 +167,12 @@ namespace Poly
 		if (!m_pQueuedRenderProgram)
 			return;
 
+		// Keep rendering with the active program until the queued one's pipelines are compiled. With nothing
+		// active there's nothing to keep showing, so swap straight away - the first frame waits on the
+		// compile jobs it needs instead (see RenderProgram::GetPrecompiledPipeline()).
+		if (m_pActiveRenderProgram && !m_pQueuedRenderProgram->ArePipelinesReady())
+			return;
+
 		m_pActiveRenderProgram = std::move(m_pQueuedRenderProgram);
 		m_pQueuedRenderProgram.reset();
 
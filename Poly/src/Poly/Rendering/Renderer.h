@@ -33,12 +33,24 @@ namespace Poly
 
 		/**
 		 * Sets the render program to use once it is safe to swap out the currently active one.
-		 * Queues the compiled program; a RenderProgramInstance is constructed for
-		 * each window from it at the start of the next Render() call.
+		 * Queues the compiled program and starts compiling its pipelines on the ThreadPool; a
+		 * RenderProgramInstance is constructed for each window from it at the start of the first
+		 * Render() call after they're all ready, so swapping programs doesn't stall a frame.
+		 * If no program is active yet it's swapped in right away.
 		 * @param pRenderProgram
 		 */
 		void SetRenderProgram(Ref<RenderProgram> pRenderProgram);
 
+		/**
+		 * @return true while a program set via SetRenderProgram() is still compiling and hasn't been swapped in
+		 */
+		bool IsRenderProgramPending() const;
+
+		/**
+		 * @return Fraction [0, 1] of the pending program's pipelines that have been compiled, 1 if none is pending
+		 */
+		float GetRenderProgramLoadProgress() const;
+
 		/**
 		 * Gets the RenderProgramInstance actively executing the current RenderProgram for a window.
 		 * Returns nullptr until a queued RenderProgram set via SetRenderProgram() has actually been
@@ -78,9 +90,9 @@ namespace Poly
 
 		void CreateBackbufferResources(const WindowContext& windowCtx);
 
-		// Swaps in the queued RenderProgram, if one is waiting, by constructing a fresh
-		// RenderProgramInstance per window from it. Called at a point in the frame where it's
-		// safe to retire the previously active instances (see plans/render_graph.md, "Render
+		// Swaps in the queued RenderProgram, if one is waiting and its pipelines are compiled, by
+		// constructing a fresh RenderProgramInstance per window from it. Called at a point in the frame
+		// where it's safe to retire the previously active instances (see plans/render_graph.md, "Render
 		// Program"). Real GPU-idle gating is future work.
 		void SwapRenderProgramIfQueued();
 
@@ -2,18 +2,17 @@
 
 #include "AssetManager.h"
 #include "GLSLang.h"
-#include "Platform/API/BinarySemaphore.h"
-#include "Platform/API/Buffer.h"
-#include "Platform/API/CommandBuffer.h"
-#include "Platform/API/CommandPool.h"
-#include "Platform/API/CommandQueue.h"
 #include "Platform/API/Texture.h"
 #include "Poly/Core/RenderAPI.h"
 #include "Poly/Model/Material.h"
 #include "Poly/Model/Mesh.h"
 #include "Poly/Model/Model.h"
+#include "Poly/RenderGraph/ResourceManager.h"
+#include "Poly/Resources/CookedModel.h"
 #include "Poly/Resources/GeometryPool.h"
+#include "Poly/Resources/MeshOptimizer.h"
 #include "Poly/Resources/PathUtils.h"
+#include "Poly/Resources/TextureCompressor.h"
 #include "Poly/Resources/VFS/VirtualFileSystem.h"
 #include "polypch.h"
 #include "Shader/ShaderCompiler.h"
@@ -33,62 +32,219 @@
 
 namespace
 {
-	Poly::Material::Type ConvertTextureType(aiTextureType aiType)
+	struct MaterialTextureSource
 	{
-		using namespace Poly;
+		aiTextureType Type;
+		uint32        Index;
+	};
 
-		switch (aiType)
+	// Where a material's texture for a slot comes from - the first source the material has a texture for - and the
+	// format it's cooked to, with only the channels the shaders read from the slot
+	struct MaterialTextureSlot
+	{
+		Poly::Material::Type               Slot;
+		Poly::EFormat                      Format;
+		std::vector<MaterialTextureSource> Sources;
+	};
+
+	const std::vector<MaterialTextureSlot> kMaterialTextureSlots = {
+	    {Poly::Material::Type::ALBEDO, Poly::EFormat::BC7_UNORM, {{aiTextureType_BASE_COLOR, 0}, {aiTextureType_DIFFUSE, 1}, {aiTextureType_DIFFUSE, 0}}},
+	    {Poly::Material::Type::NORMAL, Poly::EFormat::BC5_UNORM, {{aiTextureType_NORMAL_CAMERA, 0}, {aiTextureType_NORMALS, 0}, {aiTextureType_HEIGHT, 0}}},
+	    {Poly::Material::Type::AMBIENT_OCCLUSION, Poly::EFormat::BC4_UNORM, {{aiTextureType_AMBIENT_OCCLUSION, 0}, {aiTextureType_AMBIENT, 0}}},
+	    {Poly::Material::Type::METALIC, Poly::EFormat::BC4_UNORM, {{aiTextureType_METALNESS, 0}, {aiTextureType_REFLECTION, 0}}},
+	    {Poly::Material::Type::ROUGHNESS, Poly::EFormat::BC4_UNORM, {{aiTextureType_DIFFUSE_ROUGHNESS, 0}, {aiTextureType_SHININESS, 0}}},
+	    {Poly::Material::Type::COMBINED, Poly::EFormat::BC7_UNORM, {{AI_MATKEY_GLTF_PBRMETALLICROUGHNESS_METALLICROUGHNESS_TEXTURE}}}};
+
+	// Path of the texture a material uses for a slot, empty if it has none
+	std::string GetMaterialTexturePath(aiMaterial* pMaterial, const MaterialTextureSlot& slot, const std::string& folder)
+	{
+		for (const MaterialTextureSource& source : slot.Sources)
+		{
+			if (pMaterial->GetTextureCount(source.Type) <= source.Index)
+				continue;
+
+			aiString path;
+			if (pMaterial->GetTexture(source.Type, source.Index, &path) != AI_SUCCESS)
+			{
+				POLY_CORE_WARN("Failed to get texture {} with index {}", path.C_Str(), source.Index);
+				return {};
+			}
+
+			return folder + "/" + path.C_Str();
+		}
+
+		return {};
+	}
+
+	constexpr const char* TEXTURE_CACHE_DIRECTORY = "cache/textures/";
+	constexpr const char* MODEL_CACHE_DIRECTORY   = "cache/models/";
+
+	// Prefixed to a cooked texture's levels in the cache. The hash of the source file ties it to the exact image it
+	// was cooked from, so an edited image is cooked again.
+	struct CookedTextureHeader
+	{
+		static constexpr uint32 MAGIC   = 0x58545043; // "CPTX"
+		static constexpr uint32 VERSION = 1;
+
+		uint32 Magic;
+		uint32 Version;
+		uint32 Format;
+		uint32 Width;
+		uint32 Height;
+		uint32 MipLevels;
+		uint64 SourceHash;
+		uint64 DataSize;
+	};
+
+	uint64 HashBytes(const void* pData, size_t size)
+	{
+		// FNV-1a
+		const byte* pBytes = static_cast<const byte*>(pData);
+		uint64      hash   = 14695981039346656037ull;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= pBytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	// Uris of the external buffers (.bin) in a glTF file's "buffers" array, percent-decoding undone like Assimp does
+	// before opening them. Works on .glb too, its JSON chunk is plain text in the file. Embedded "data:" uris and
+	// a .glb's own BIN chunk are part of the file's bytes already, so they're skipped.
+	std::vector<std::string> GetGLTFBufferUris(const std::vector<byte>& source)
+	{
+		const std::string_view json(reinterpret_cast<const char*>(source.data()), source.size());
+
+		// The "buffers" key, not a string value that happens to read the same
+		size_t begin = json.find("\"buffers\"");
+		while (begin != std::string_view::npos && json.find_first_not_of(" \t\r\n", begin + 9) != json.find(':', begin + 9))
+			begin = json.find("\"buffers\"", begin + 9);
+		if (begin == std::string_view::npos)
+			return {};
+
+		begin            = json.find('[', begin);
+		const size_t end = begin != std::string_view::npos ? json.find(']', begin) : std::string_view::npos;
+		if (end == std::string_view::npos)
+			return {};
+
+		std::vector<std::string> uris;
+		for (size_t key = json.find("\"uri\"", begin); key < end; key = json.find("\"uri\"", key + 5))
+		{
+			const size_t valueBegin = json.find('"', json.find(':', key + 5)) + 1;
+			const size_t valueEnd   = json.find('"', valueBegin);
+			if (valueBegin == 0 || valueEnd == std::string_view::npos || valueEnd > end)
+				break;
+
+			const std::string_view value = json.substr(valueBegin, valueEnd - valueBegin);
+			if (value.starts_with("data:"))
+				continue;
+
+			std::string uri;
+			for (size_t i = 0; i < value.size(); i++)
+			{
+				if (value[i] == '%' && i + 2 < value.size() && std::isxdigit(value[i + 1]) && std::isxdigit(value[i + 2]))
+				{
+					uri += static_cast<char>(std::stoi(std::string(value.substr(i + 1, 2)), nullptr, 16));
+					i += 2;
+				}
+				else
+				{
+					uri += value[i];
+				}
+			}
+			uris.push_back(std::move(uri));
+		}
+		return uris;
+	}
+
+	// Hash of a model file together with the external buffers its geometry is read from, so a cooked model goes stale
+	// when a glTF's .bin is edited, not only the .gltf. Textures aren't part of it, they're cooked and cached on their own.
+	uint64 HashModelSource(const std::string& path, const std::vector<byte>& source)
+	{
+		uint64 hash = HashBytes(source.data(), source.size());
+
+		std::string extension = Poly::PathUtils::GetExtension(path);
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+		if (extension != "gltf" && extension != "glb")
+			return hash;
+
+		const std::string folder = Poly::PathUtils::GetDirectoryPath(path);
+		for (const std::string& uri : GetGLTFBufferUris(source))
 		{
-		case aiTextureType_BASE_COLOR:
-			return Material::Type::ALBEDO;
-		case aiTextureType_DIFFUSE:
-			return Material::Type::ALBEDO;
-
-		case aiTextureType_NORMAL_CAMERA:
-			return Material::Type::NORMAL;
-		case aiTextureType_NORMALS:
-			return Material::Type::NORMAL;
-		case aiTextureType_HEIGHT:
-			return Material::Type::NORMAL;
-
-		case aiTextureType_AMBIENT_OCCLUSION:
-			return Material::Type::AMBIENT_OCCLUSION;
-		case aiTextureType_AMBIENT:
-			return Material::Type::AMBIENT_OCCLUSION;
-
-		case aiTextureType_METALNESS:
-			return Material::Type::METALIC;
-		case aiTextureType_REFLECTION:
-			return Material::Type::METALIC;
-
-		case aiTextureType_DIFFUSE_ROUGHNESS:
-			return Material::Type::ROUGHNESS;
-		case aiTextureType_SHININESS:
-			return Material::Type::ROUGHNESS;
-
-		case aiTextureType_UNKNOWN:
-			return Material::Type::COMBINED;
-
-		default:
-			return Material::Type::NONE;
+			const std::vector<byte> buffer = Poly::VirtualFileSystem::Read(folder + "/" + uri);
+			hash ^= HashBytes(buffer.data(), buffer.size()) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
 		}
+		return hash;
 	}
 
-	void LoadAssimpMaterial(aiMaterial* pMaterial, aiTextureType type, uint32 index, const Poly::Ref<Poly::Material>& pPolyMaterial, const std::string& folder)
+	std::string GetCookedTexturePath(const std::string& path, Poly::EFormat format)
 	{
-		using namespace Poly;
+		return TEXTURE_CACHE_DIRECTORY + std::to_string(HashBytes(path.data(), path.size())) + "_" + std::to_string(static_cast<uint32>(format)) + ".ptex";
+	}
 
-		aiString path;
-		if (pMaterial->GetTexture(type, index, &path) != AI_SUCCESS)
+	bool DecodeImageData(const std::vector<byte>& content, const std::string& path, Poly::AssetLoader::Image& image)
+	{
+		int texWidth  = 0;
+		int texHeight = 0;
+		int channels  = 0;
+
+		byte* data = stbi_load_from_memory(content.data(), content.size(), &texWidth, &texHeight, &channels, STBI_rgb_alpha);
+		if (!data)
 		{
-			POLY_CORE_WARN("Failed to get texture {} with index {}", path.C_Str(), index);
-			return;
+			POLY_CORE_ERROR("Failed to load image {}", path);
+			return false;
 		}
-		PolyID id = AssetManager::ImportAndLoadTexture(std::string(folder + "/" + path.C_Str()), EFormat::R8G8B8A8_UNORM);
 
-		ManagedTexture managedTexture = AssetManager::GetManagedTexture(id);
-		pPolyMaterial->SetTexture(ConvertTextureType(type), managedTexture.pTexture.get());
-		pPolyMaterial->SetTextureView(ConvertTextureType(type), managedTexture.pTextureView.get());
+		image        = {};
+		image.Width  = texWidth;
+		image.Height = texHeight;
+		image.Pixels.assign(data, data + static_cast<size_t>(texWidth) * texHeight * 4);
+
+		stbi_image_free(data);
+
+		return true;
+	}
+
+	bool ReadCookedTexture(const std::string& cookedPath, uint64 sourceHash, Poly::EFormat format, Poly::AssetLoader::Image& image)
+	{
+		const std::vector<byte> file = Poly::VirtualFileSystem::Read(cookedPath);
+		if (file.size() < sizeof(CookedTextureHeader))
+			return false;
+
+		CookedTextureHeader header;
+		std::memcpy(&header, file.data(), sizeof(header));
+		if (header.Magic != CookedTextureHeader::MAGIC || header.Version != CookedTextureHeader::VERSION || header.SourceHash != sourceHash
+		    || header.Format != static_cast<uint32>(format) || header.DataSize != file.size() - sizeof(header))
+			return false;
+
+		image           = {};
+		image.Width     = header.Width;
+		image.Height    = header.Height;
+		image.Format    = format;
+		image.MipLevels = header.MipLevels;
+		image.Pixels.assign(file.begin() + sizeof(header), file.end());
+		return true;
+	}
+
+	void WriteCookedTexture(const std::string& cookedPath, uint64 sourceHash, const Poly::AssetLoader::Image& image)
+	{
+		CookedTextureHeader header = {};
+		header.Magic               = CookedTextureHeader::MAGIC;
+		header.Version             = CookedTextureHeader::VERSION;
+		header.Format              = static_cast<uint32>(image.Format);
+		header.Width               = image.Width;
+		header.Height              = image.Height;
+		header.MipLevels           = image.MipLevels;
+		header.SourceHash          = sourceHash;
+		header.DataSize            = image.Pixels.size();
+
+		std::vector<byte> file(sizeof(header) + image.Pixels.size());
+		std::memcpy(file.data(), &header, sizeof(header));
+		std::memcpy(file.data() + sizeof(header), image.Pixels.data(), image.Pixels.size());
+
+		if (!Poly::VirtualFileSystem::Write(cookedPath, file))
+			POLY_CORE_WARN("Failed to write cooked texture to {}", cookedPath);
 	}
 } // namespace
 
@@ -100,32 +256,12 @@ namespace Poly
 		s_GLSLInit = glslang::InitializeProcess();
 		if (!s_GLSLInit)
 			POLY_CORE_ERROR("[AssetLoader]: Failed to initialize glslang! No shaders will be loaded!");
-
-		// Command pools and buffers
-		s_TransferCommandPool   = RenderAPI::CreateCommandPool(FQueueType::TRANSFER, FCommandPoolFlags::NONE);
-		s_TransferCommandBuffer = s_TransferCommandPool->AllocateCommandBuffer(ECommandBufferLevel::PRIMARY);
-
-		s_GraphicsCommandPool   = RenderAPI::CreateCommandPool(FQueueType::GRAPHICS, FCommandPoolFlags::NONE);
-		s_GraphicsCommandBuffer = s_GraphicsCommandPool->AllocateCommandBuffer(ECommandBufferLevel::PRIMARY);
-
-		// Semaphore
-		s_Semaphore = RenderAPI::CreateBinarySemaphore();
 	}
 
 	void AssetLoader::Release()
 	{
 		if (s_GLSLInit)
 			glslang::FinalizeProcess();
-
-		// Wait for device to be done before calling the destructor for commandpool and buffer
-		RenderAPI::GetCommandQueue(FQueueType::TRANSFER)->Wait();
-		RenderAPI::GetCommandQueue(FQueueType::GRAPHICS)->Wait();
-
-		// Since AssetLoader is a static class the destructor will be called after the release
-		// of the graphics device. Therefore the graphics resources are manually deleted
-		s_TransferCommandPool.reset();
-		s_GraphicsCommandPool.reset();
-		s_Semaphore.reset();
 	}
 
 	std::vector<byte> AssetLoader::LoadShader(std::string_view path, FShaderStage shaderStage)
@@ -164,146 +300,136 @@ namespace Poly
 		return image;
 	}
 
-	Ref<Texture> AssetLoader::LoadTexture(const std::string& path, EFormat format)
+	AssetLoader::Image AssetLoader::DecodeImage(const std::string& path)
 	{
-		// Load image
-		int texWidth  = 0;
-		int texHeight = 0;
-		int channels  = 0;
+		Image image = {};
+		DecodeImageData(VirtualFileSystem::Read(path), path, image);
+		return image;
+	}
 
-		std::vector<byte> content = VirtualFileSystem::Read(path);
-		byte*             data    = stbi_load_from_memory(content.data(), content.size(), &texWidth, &texHeight, &channels, STBI_rgb_alpha);
-		if (!data)
-			POLY_VALIDATE(false, "Failed to load image {}", path);
+	AssetLoader::Image AssetLoader::LoadTextureImage(const std::string& path, EFormat format)
+	{
+		if (!IsBlockCompressed(format))
+			return DecodeImage(path);
 
-		Ref<Texture> pTexture = LoadTextureFromMemory(data, texWidth, texHeight, channels, format);
+		const std::vector<byte> content    = VirtualFileSystem::Read(path);
+		const uint64            sourceHash = HashBytes(content.data(), content.size());
+		const std::string       cookedPath = GetCookedTexturePath(path, format);
 
-		stbi_image_free(data);
+		Image image = {};
+		if (ReadCookedTexture(cookedPath, sourceHash, format, image))
+			return image;
+
+		Image decoded = {};
+		if (!DecodeImageData(content, path, decoded))
+			return {};
+
+		// Block-compressed levels can't be blitted on the GPU, so the whole chain is made here
+		image.Width     = decoded.Width;
+		image.Height    = decoded.Height;
+		image.Format    = format;
+		image.MipLevels = ResourceManager::GetMipLevelCount(decoded.Width, decoded.Height);
+
+		std::vector<byte> level       = std::move(decoded.Pixels);
+		uint32            levelWidth  = decoded.Width;
+		uint32            levelHeight = decoded.Height;
+		for (uint32 i = 0; i < image.MipLevels; i++)
+		{
+			if (i > 0)
+			{
+				level       = TextureCompressor::Downsample(level.data(), levelWidth, levelHeight);
+				levelWidth  = std::max(levelWidth / 2, 1u);
+				levelHeight = std::max(levelHeight / 2, 1u);
+			}
+
+			const std::vector<byte> blocks = TextureCompressor::Compress(level.data(), levelWidth, levelHeight, format);
+			image.Pixels.insert(image.Pixels.end(), blocks.begin(), blocks.end());
+		}
+
+		WriteCookedTexture(cookedPath, sourceHash, image);
+		return image;
+	}
+
+	TextureHandle AssetLoader::LoadTexture(const std::string& path, EFormat format, UploadToken* pUploadToken)
+	{
+		const Image image = LoadTextureImage(path, format);
+		if (image.Pixels.empty())
+			POLY_VALIDATE(false, "Failed to load image {}", path);
 
-		return pTexture;
+		return LoadTextureFromImage(image, pUploadToken, path);
 	}
 
-	Ref<Texture> AssetLoader::LoadTextureFromMemory(void* data, uint32 width, uint32 height, uint32 channels, EFormat format)
+	TextureHandle AssetLoader::LoadTextureFromImage(const Image& image, UploadToken* pUploadToken, const std::string& debugName)
 	{
-		// Create texture
-		TextureDesc textureDesc  = {};
-		textureDesc.Width        = width;
-		textureDesc.Height       = height;
-		textureDesc.Depth        = 1;
-		textureDesc.MemoryUsage  = EMemoryUsage::GPU_ONLY;
-		textureDesc.SampleCount  = 1;
-		textureDesc.ArrayLayers  = 1;
-		textureDesc.MipLevels    = 1;
-		textureDesc.TextureDim   = ETextureDim::DIM_2D;
-		textureDesc.TextureUsage = FTextureUsage::TRANSFER_DST | FTextureUsage::TRANSFER_SRC | FTextureUsage::SAMPLED;
-		textureDesc.Format       = format;
-		Ref<Texture> pTexture    = RenderAPI::CreateTexture(&textureDesc);
+		const TextureHandle texture = ResourceManager::CreateTexture2D(image.Width, image.Height, image.Format, FTextureUsage::TRANSFER_SRC | FTextureUsage::SAMPLED, debugName,
+		                                                               nullptr, 0, ResourceManager::GetMipLevelCount(image.Width, image.Height));
+		const UploadToken   upload  = ResourceManager::UploadTextureData(texture, image.Pixels.data(), image.Width, image.Height, FQueueType::GRAPHICS, image.MipLevels);
+
+		if (pUploadToken)
+			*pUploadToken = upload;
 
+		return texture;
+	}
+
+	TextureHandle AssetLoader::LoadTextureFromMemory(const void* data, uint32 width, uint32 height, uint32 channels, EFormat format,
+	                                                 UploadToken* pUploadToken, const std::string& debugName)
+	{
 		// TODO: Channels or format should be checked to get the correct size instead of hardcoding to four
 		// The value instead of channels should be the stride for the texture, which needs to be a factor of two
 
-		// Create transfer buffer
-		BufferDesc bufferDesc  = {};
-		bufferDesc.BufferUsage = FBufferUsage::TRANSFER_SRC;
-		bufferDesc.MemUsage    = EMemoryUsage::CPU_VISIBLE;
-		bufferDesc.Size        = width * height * 4;
-		Ref<Buffer> pBuffer    = RenderAPI::CreateBuffer(&bufferDesc);
-
-		// Map transfer buffer
-		void* buffMap = pBuffer->Map();
-		memcpy(buffMap, data, width * height * 4);
-		pBuffer->Unmap();
-
-		// Copy over data from buffer to texture
-		s_TransferCommandPool->Reset();
-		s_TransferCommandBuffer->Begin(FCommandBufferFlag::ONE_TIME_SUBMIT);
-
-		// 1. A newly created texture is created with the layout "UNDEFINED". This needs to be transfered to TRANSFER_DST before transfer
-		s_TransferCommandBuffer->PipelineTextureBarrier(
-		    pTexture.get(),
-		    FPipelineStage::ALL_COMMANDS,
-		    FPipelineStage::TRANSFER,
-		    FAccessFlag::NONE,
-		    FAccessFlag::TRANSFER_WRITE,
-		    ETextureLayout::UNDEFINED,
-		    ETextureLayout::TRANSFER_DST_OPTIMAL);
-
-		// 2. When in correct layout, record transfer command
-		CopyBufferDesc copyDesc = {};
-		copyDesc.Width          = width;
-		copyDesc.Height         = height;
-		copyDesc.Depth          = 1;
-		copyDesc.ArrayCount     = 1;
-		copyDesc.ArrayLayer     = 0;
-		copyDesc.MipLevel       = 0;
-		s_TransferCommandBuffer->CopyBufferToTexture(pBuffer.get(), pTexture.get(), ETextureLayout::TRANSFER_DST_OPTIMAL, copyDesc);
-
-		// 3. Release texture from transfer queue
-		const bool transferGraphicsSameQueue = RenderAPI::GetCommandQueue(FQueueType::TRANSFER)->GetQueueFamilyIndex() == RenderAPI::GetCommandQueue(FQueueType::GRAPHICS)->GetQueueFamilyIndex();
-		s_TransferCommandBuffer->ReleaseTexture(
-		    pTexture.get(),
-		    FPipelineStage::TRANSFER,
-		    FPipelineStage::TRANSFER,
-		    FAccessFlag::TRANSFER_READ,
-		    ETextureLayout::TRANSFER_DST_OPTIMAL,
-		    ETextureLayout::SHADER_READ_ONLY_OPTIMAL,
-		    RenderAPI::GetCommandQueue(FQueueType::TRANSFER)->GetQueueFamilyIndex(),
-		    RenderAPI::GetCommandQueue(FQueueType::GRAPHICS)->GetQueueFamilyIndex());
-		s_TransferCommandBuffer->End();
-
-		// 4. Semaphore to make sure the transfer is done before acquire
-		s_Semaphore->ClearWaitStageMask();
-		s_Semaphore->AddWaitStageMask(FPipelineStage::ALL_COMMANDS);
-
-		// 5. Submit to transfer queue
-		{
-			SubmitDesc submitDesc       = {};
-			submitDesc.CommandBuffers   = {s_TransferCommandBuffer};
-			submitDesc.SignalSemaphores = {s_Semaphore.get()};
-			RenderAPI::GetCommandQueue(FQueueType::TRANSFER)->Submit(submitDesc);
-		}
+		// The data is copied into ResourceManager's next upload flush, so the texture is returned before it's on the
+		// GPU - render graph passes wait for the upload there, anything else has to check the token
+		const TextureHandle texture = ResourceManager::CreateTexture2D(width, height, format, FTextureUsage::TRANSFER_SRC | FTextureUsage::SAMPLED, debugName, nullptr, 0,
+		                                                               ResourceManager::GetMipLevelCount(width, height));
+		const UploadToken   upload  = ResourceManager::UploadTextureData(texture, data, width, height);
 
-		// 6. Acquire texture to graphics queue
-		s_GraphicsCommandPool->Reset();
-		s_GraphicsCommandBuffer->Begin(FCommandBufferFlag::ONE_TIME_SUBMIT);
+		if (pUploadToken)
+			*pUploadToken = upload;
 
-		if (!transferGraphicsSameQueue)
+		return texture;
+	}
+
+	Ref<Model> AssetLoader::LoadModel(const std::string& path, Entity root)
+	{
+		const std::vector<byte> source = VirtualFileSystem::Read(path);
+		if (source.empty())
 		{
-			s_GraphicsCommandBuffer->AcquireTexture(
-			    pTexture.get(),
-			    FPipelineStage::TRANSFER,
-			    FPipelineStage::TRANSFER,
-			    FAccessFlag::TRANSFER_READ,
-			    ETextureLayout::TRANSFER_DST_OPTIMAL,
-			    ETextureLayout::SHADER_READ_ONLY_OPTIMAL,
-			    RenderAPI::GetCommandQueue(FQueueType::TRANSFER)->GetQueueFamilyIndex(),
-			    RenderAPI::GetCommandQueue(FQueueType::GRAPHICS)->GetQueueFamilyIndex());
+			POLY_CORE_ERROR("Could not read model {}", path);
+			return nullptr;
 		}
-		s_GraphicsCommandBuffer->End();
 
-		// 7. Submit to graphics queue
+		const uint64      sourceHash = HashModelSource(path, source);
+		const std::string cookedPath = MODEL_CACHE_DIRECTORY + std::to_string(HashBytes(path.data(), path.size())) + ".pmdl";
+
+		// Assimp only runs when the cache has nothing usable for this exact file
+		CookedModel cookedModel;
+		if (!cookedModel.Load(VirtualFileSystem::Read(cookedPath), sourceHash))
 		{
-			SubmitDesc submitDesc     = {};
-			submitDesc.CommandBuffers = {s_GraphicsCommandBuffer};
-			submitDesc.WaitSemaphores = {s_Semaphore.get()};
-			RenderAPI::GetCommandQueue(FQueueType::GRAPHICS)->Submit(submitDesc);
+			std::vector<byte> file = CookModel(path, sourceHash);
+			if (file.empty())
+				return nullptr;
+
+			if (!VirtualFileSystem::Write(cookedPath, file))
+				POLY_CORE_WARN("Failed to write cooked model to {}", cookedPath);
+
+			cookedModel.Load(std::move(file), sourceHash);
 		}
 
-		// 8. Wait on both queues (or something better, this is the simple approach)
-		// TODO: Use semaphore here instead!
-		RenderAPI::GetCommandQueue(FQueueType::TRANSFER)->Wait();
-		RenderAPI::GetCommandQueue(FQueueType::GRAPHICS)->Wait();
+		return CreateModel(cookedModel, root);
+	}
 
-		return pTexture;
+	Ref<Material> AssetLoader::LoadMaterial(const std::string& path)
+	{
+		return nullptr;
 	}
 
-	Ref<Model> AssetLoader::LoadModel(const std::string& path, Entity root)
+	std::vector<byte> AssetLoader::CookModel(const std::string& path, uint64 sourceHash)
 	{
 		std::string resolvedPath = VirtualFileSystem::Resolve(path);
 		if (resolvedPath.empty())
 		{
 			POLY_CORE_ERROR("Could not resolve model path {}", path);
-			return nullptr;
+			return {};
 		}
 
 		Assimp::Importer importer;
@@ -312,65 +438,40 @@ namespace Poly
 		if (!pScene)
 		{
 			POLY_CORE_WARN("Could not open mesh at path {}", resolvedPath);
-			return nullptr;
+			return {};
 		}
 
-		Ref<Model> pModel = Model::Create();
+		const std::string    folder = PathUtils::GetDirectoryPath(path);
+		CookedModel::Builder builder;
 
-		ProcessNode(pScene->mRootNode, pScene, PathUtils::GetDirectoryPath(path), pModel.get(), root);
+		// Record indices match the scene's, so nodes can refer to meshes and materials by their Assimp index
+		for (uint32 i = 0; i < pScene->mNumMaterials; i++)
+			CookMaterial(pScene->mMaterials[i], folder, builder);
 
-		return pModel;
-	}
+		for (uint32 i = 0; i < pScene->mNumMeshes; i++)
+			CookMesh(pScene->mMeshes[i], builder);
 
-	Ref<Material> AssetLoader::LoadMaterial(const std::string& path)
-	{
-		return nullptr;
+		CookNode(pScene->mRootNode, pScene, CookedModel::INVALID_INDEX, builder);
+
+		return builder.Serialize(sourceHash);
 	}
 
-	void AssetLoader::ProcessNode(aiNode* pNode, const aiScene* pScene, const std::string& folder, Model* pModel, Entity parent)
+	void AssetLoader::CookNode(aiNode* pNode, const aiScene* pScene, uint32 parent, CookedModel::Builder& builder)
 	{
+		std::vector<CookedModel::MeshInstanceRecord> meshInstances(pNode->mNumMeshes);
 		for (uint32 i = 0; i < pNode->mNumMeshes; i++)
 		{
-			uint32        index         = pModel->GetMeshInstanceCount();
-			aiMesh*       pMesh         = pScene->mMeshes[pNode->mMeshes[i]];
-			aiMaterial*   pMaterial     = pScene->mMaterials[pMesh->mMaterialIndex];
-			Ref<Mesh>     pPolyMesh     = ProcessMesh(pMesh, pScene, pModel, index);
-			Ref<Material> pPolyMaterial = ProcessMaterial(pMaterial, pScene, pModel, index, folder);
-			pModel->AddMeshInstance({pPolyMesh, pPolyMaterial});
-
-			if (parent != Entity::None())
-			{
-				Entity child = parent.GetScene()->CreateEntity();
-				child.SetParent(parent);
-				child.AddComponent<MeshComponent>(pModel, index);
-				TransformComponent& transformComp = child.GetComponent<TransformComponent>();
-
-				glm::mat4 transform = ConvertAiMatToGLM(&pNode->mTransformation);
-				glm::vec3 scale, translation, skew;
-				glm::vec4 perspective;
-				glm::quat orientation;
-				glm::decompose(transform, scale, orientation, translation, skew, perspective);
-
-				transformComp.Translation = translation;
-				transformComp.Orientation = orientation;
-				transformComp.Scale       = scale;
-			}
+			meshInstances[i].Mesh     = pNode->mMeshes[i];
+			meshInstances[i].Material = pScene->mMeshes[pNode->mMeshes[i]]->mMaterialIndex;
 		}
 
+		const uint32 node = builder.AddNode(ConvertAiMatToGLM(&pNode->mTransformation), parent, meshInstances);
+
 		for (uint32 i = 0; i < pNode->mNumChildren; i++)
-		{
-			aiNode* child       = pNode->mChildren[i];
-			Entity  childEntity = Entity::None();
-			if (parent != Entity::None())
-			{
-				childEntity = parent.GetScene()->CreateEntity();
-				childEntity.SetParent(parent);
-			}
-			ProcessNode(child, pScene, folder, pModel, childEntity);
-		}
+			CookNode(pNode->mChildren[i], pScene, node, builder);
 	}
 
-	Ref<Mesh> AssetLoader::ProcessMesh(aiMesh* pMesh, const aiScene* pScene, Model* pModel, uint32 index)
+	void AssetLoader::CookMesh(aiMesh* pMesh, CookedModel::Builder& builder)
 	{
 		std::vector<Vertex> vertices(pMesh->mNumVertices);
 		std::vector<uint32> indices(pMesh->mNumFaces * 3);
@@ -413,15 +514,39 @@ namespace Poly
 			indices[i * 3 + 2] = pMesh->mFaces[i].mIndices[2];
 		}
 
-		MeshRange meshRange = GeometryPool::UploadMesh(vertices, indices);
-		Ref<Mesh> pPolyMesh = Mesh::Create(pModel, std::move(meshRange), index);
+		// Reorders and drops unreferenced vertices, so has to come before anything that keeps their indices
+		MeshOptimizer::Optimize(vertices, indices);
 
-		return pPolyMesh;
+		// Box first, then a sphere centered on the box and grown to enclose every vertex (tighter than the
+		// box's circumsphere for anything that isn't box-shaped)
+		glm::vec3 boundsMin = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+		for (const Vertex& vertex : vertices)
+		{
+			boundsMin = glm::min(boundsMin, glm::vec3(vertex.Position));
+			boundsMax = glm::max(boundsMax, glm::vec3(vertex.Position));
+		}
+
+		const glm::vec3 center   = (boundsMin + boundsMax) * 0.5f;
+		float           radiusSq = 0.0f;
+		for (const Vertex& vertex : vertices)
+		{
+			const glm::vec3 offset = glm::vec3(vertex.Position) - center;
+			radiusSq               = std::max(radiusSq, glm::dot(offset, offset));
+		}
+
+		MeshBounds bounds = {};
+		bounds.Sphere     = glm::vec4(center, std::sqrt(radiusSq));
+		bounds.Min        = boundsMin;
+		bounds.Max        = boundsMax;
+
+		const std::vector<MeshLodData> lods = MeshOptimizer::BuildLods(vertices, indices);
+
+		builder.AddMesh(vertices, lods, bounds);
 	}
 
-	Ref<Material> AssetLoader::ProcessMaterial(aiMaterial* pMaterial, const aiScene* pScene, Model* pModel, uint32 index, const std::string& folder)
+	void AssetLoader::CookMaterial(aiMaterial* pMaterial, const std::string& folder, CookedModel::Builder& builder)
 	{
-		Ref<Material>  pPolyMaterial  = Material::Create(pModel, index);
 		MaterialValues materialValues = {};
 
 		// Constants
@@ -449,82 +574,113 @@ namespace Poly
 			materialValues.Albedo.a = diffuse.a;
 		}
 
-		// Textures
-		// Albedo
-		if (pMaterial->GetTextureCount(aiTextureType_BASE_COLOR) > 0)
-			LoadAssimpMaterial(pMaterial, aiTextureType_BASE_COLOR, 0, pPolyMaterial, folder);
-		else if (pMaterial->GetTextureCount(aiTextureType_DIFFUSE) > 1)
-			LoadAssimpMaterial(pMaterial, aiTextureType_DIFFUSE, 1, pPolyMaterial, folder);
-		else if (pMaterial->GetTextureCount(aiTextureType_DIFFUSE) > 0)
-			LoadAssimpMaterial(pMaterial, aiTextureType_DIFFUSE, 0, pPolyMaterial, folder);
-		else
-		{
-			ManagedTexture mt = AssetManager::GetManagedTexture(AssetManager::DEFAULT_TEXTURE_ID);
-			pPolyMaterial->SetTexture(Material::Type::ALBEDO, mt.pTexture.get());
-			pPolyMaterial->SetTextureView(Material::Type::ALBEDO, mt.pTextureView.get());
-		}
+		// Textures - only their paths, they're loaded when the model is created
+		std::string texturePaths[CookedModel::TEXTURE_SLOT_COUNT];
+		for (const MaterialTextureSlot& slot : kMaterialTextureSlots)
+			texturePaths[static_cast<uint32>(slot.Slot)] = GetMaterialTexturePath(pMaterial, slot, folder);
 
-		// Normal
-		if (pMaterial->GetTextureCount(aiTextureType_NORMAL_CAMERA) > 0)
-			LoadAssimpMaterial(pMaterial, aiTextureType_NORMAL_CAMERA, 0, pPolyMaterial, folder);
-		else if (pMaterial->GetTextureCount(aiTextureType_NORMALS) > 0)
-			LoadAssimpMaterial(pMaterial, aiTextureType_NORMALS, 0, pPolyMaterial, folder);
-		else if (pMaterial->GetTextureCount(aiTextureType_HEIGHT) > 0)
-			LoadAssimpMaterial(pMaterial, aiTextureType_HEIGHT, 0, pPolyMaterial, folder);
-		else
-		{
-			ManagedTexture mt = AssetManager::GetManagedTexture(AssetManager::DEFAULT_TEXTURE_ID);
-			pPolyMaterial->SetTexture(Material::Type::NORMAL, mt.pTexture.get());
-			pPolyMaterial->SetTextureView(Material::Type::NORMAL, mt.pTextureView.get());
-		}
+		builder.AddMaterial(materialValues, texturePaths);
+	}
 
-		// Ambient Occlusion
-		if (pMaterial->GetTextureCount(aiTextureType_AMBIENT_OCCLUSION) > 0)
-			LoadAssimpMaterial(pMaterial, aiTextureType_AMBIENT_OCCLUSION, 0, pPolyMaterial, folder);
-		else if (pMaterial->GetTextureCount(aiTextureType_AMBIENT) > 0)
-			LoadAssimpMaterial(pMaterial, aiTextureType_AMBIENT, 0, pPolyMaterial, folder);
-		else
+	Ref<Model> AssetLoader::CreateModel(const CookedModel& cookedModel, Entity root)
+	{
+		// Textures first, all at once - decoding them one by one as CreateMaterial() comes across them would leave
+		// all but one core idle
+		std::vector<std::pair<std::string, EFormat>> textures;
+		std::unordered_map<std::string, uint32>      textureIndices;
+		for (const CookedModel::MaterialRecord& material : cookedModel.GetMaterials())
 		{
-			ManagedTexture mt = AssetManager::GetManagedTexture(AssetManager::DEFAULT_TEXTURE_ID);
-			pPolyMaterial->SetTexture(Material::Type::AMBIENT_OCCLUSION, mt.pTexture.get());
-			pPolyMaterial->SetTextureView(Material::Type::AMBIENT_OCCLUSION, mt.pTextureView.get());
+			for (const MaterialTextureSlot& slot : kMaterialTextureSlots)
+			{
+				std::string texturePath(cookedModel.GetString(material.TexturePaths[static_cast<uint32>(slot.Slot)]));
+				if (texturePath.empty())
+					continue;
+
+				// An image used for slots with different formats (e.g. glTF's occlusion in the R channel of the
+				// metallic-roughness texture) keeps all its channels
+				auto [it, inserted] = textureIndices.emplace(texturePath, static_cast<uint32>(textures.size()));
+				if (inserted)
+					textures.emplace_back(std::move(texturePath), slot.Format);
+				else if (textures[it->second].second != slot.Format)
+					textures[it->second].second = EFormat::BC7_UNORM;
+			}
 		}
+		AssetManager::ImportAndLoadTextures(textures);
 
-		// Metallic
-		if (pMaterial->GetTextureCount(aiTextureType_METALNESS) > 0)
-			LoadAssimpMaterial(pMaterial, aiTextureType_METALNESS, 0, pPolyMaterial, folder);
-		else if (pMaterial->GetTextureCount(aiTextureType_REFLECTION) > 0)
-			LoadAssimpMaterial(pMaterial, aiTextureType_REFLECTION, 0, pPolyMaterial, folder);
-		else
-		{
-			ManagedTexture mt = AssetManager::GetManagedTexture(AssetManager::DEFAULT_TEXTURE_ID);
-			pPolyMaterial->SetTexture(Material::Type::METALIC, mt.pTexture.get());
-			pPolyMaterial->SetTextureView(Material::Type::METALIC, mt.pTextureView.get());
-		}
+		Ref<Model> pModel = Model::Create();
 
-		// Roughness
-		if (pMaterial->GetTextureCount(aiTextureType_DIFFUSE_ROUGHNESS) > 0)
-			LoadAssimpMaterial(pMaterial, aiTextureType_DIFFUSE_ROUGHNESS, 0, pPolyMaterial, folder);
-		else if (pMaterial->GetTextureCount(aiTextureType_SHININESS) > 0)
-			LoadAssimpMaterial(pMaterial, aiTextureType_SHININESS, 0, pPolyMaterial, folder);
-		else
+		// Nodes come parents first, so a node's parent entity always exists by the time it's reached
+		const std::span<const CookedModel::NodeRecord>         nodes         = cookedModel.GetNodes();
+		const std::span<const CookedModel::MeshInstanceRecord> meshInstances = cookedModel.GetMeshInstances();
+		std::vector<Entity>                                    nodeEntities(nodes.size(), Entity::None());
+		for (uint32 i = 0; i < static_cast<uint32>(nodes.size()); i++)
 		{
-			ManagedTexture mt = AssetManager::GetManagedTexture(AssetManager::DEFAULT_TEXTURE_ID);
-			pPolyMaterial->SetTexture(Material::Type::ROUGHNESS, mt.pTexture.get());
-			pPolyMaterial->SetTextureView(Material::Type::ROUGHNESS, mt.pTextureView.get());
-		}
+			const CookedModel::NodeRecord& node   = nodes[i];
+			const Entity                   parent = node.Parent == CookedModel::INVALID_INDEX ? root : nodeEntities[node.Parent];
 
-		// Combined occlusion metallic roughness
-		if (pMaterial->GetTextureCount(aiTextureType_UNKNOWN) > 0)
-		{
-			LoadAssimpMaterial(pMaterial, AI_MATKEY_GLTF_PBRMETALLICROUGHNESS_METALLICROUGHNESS_TEXTURE, pPolyMaterial, folder);
-			materialValues.IsCombined = 1.0;
+			// Every node gets its own entity carrying the node's transform, so meshes and child nodes inherit it through the hierarchy
+			Entity nodeEntity = Entity::None();
+			if (parent != Entity::None())
+			{
+				nodeEntity = parent.GetScene()->CreateEntity();
+				nodeEntity.SetParent(parent);
+
+				glm::vec3 scale, translation, skew;
+				glm::vec4 perspective;
+				glm::quat orientation;
+				glm::decompose(node.Transform, scale, orientation, translation, skew, perspective);
+
+				TransformComponent& transformComp = nodeEntity.GetComponent<TransformComponent>();
+				transformComp.Translation         = translation;
+				transformComp.Orientation         = orientation;
+				transformComp.Scale               = scale;
+			}
+			nodeEntities[i] = nodeEntity;
+
+			for (const CookedModel::MeshInstanceRecord& meshInstance : meshInstances.subspan(node.FirstMeshInstance, node.MeshInstanceCount))
+			{
+				uint32        index         = pModel->GetMeshInstanceCount();
+				Ref<Mesh>     pPolyMesh     = CreateMesh(cookedModel, cookedModel.GetMeshes()[meshInstance.Mesh], pModel.get(), index);
+				Ref<Material> pPolyMaterial = CreateMaterial(cookedModel, cookedModel.GetMaterials()[meshInstance.Material], pModel.get(), index);
+				pModel->AddMeshInstance({pPolyMesh, pPolyMaterial});
+
+				if (nodeEntity != Entity::None())
+				{
+					Entity child = nodeEntity.GetScene()->CreateEntity();
+					child.SetParent(nodeEntity);
+					child.AddComponent<MeshComponent>(pModel, index);
+				}
+			}
 		}
-		else
+
+		return pModel;
+	}
+
+	Ref<Mesh> AssetLoader::CreateMesh(const CookedModel& cookedModel, const CookedModel::MeshRecord& mesh, Model* pModel, uint32 index)
+	{
+		// Straight from the cooked file's bytes into GeometryPool's staging
+		const GeometryHandle geometry = GeometryPool::UploadMesh(cookedModel.GetVertices(mesh), cookedModel.GetIndices(mesh), cookedModel.GetMeshlets(mesh),
+		                                                         cookedModel.GetLods(mesh), mesh.Bounds);
+		return Mesh::Create(pModel, geometry, mesh.Bounds, index);
+	}
+
+	Ref<Material> AssetLoader::CreateMaterial(const CookedModel& cookedModel, const CookedModel::MaterialRecord& material, Model* pModel, uint32 index)
+	{
+		Ref<Material>  pPolyMaterial  = Material::Create(pModel, index);
+		MaterialValues materialValues = material.Values;
+
+		// Textures - CreateModel() has loaded them all already, so this only looks them up
+		for (const MaterialTextureSlot& slot : kMaterialTextureSlots)
 		{
-			ManagedTexture mt = AssetManager::GetManagedTexture(AssetManager::DEFAULT_TEXTURE_ID);
-			pPolyMaterial->SetTexture(Material::Type::COMBINED, mt.pTexture.get());
-			pPolyMaterial->SetTextureView(Material::Type::COMBINED, mt.pTextureView.get());
+			const std::string path = std::string(cookedModel.GetString(material.TexturePaths[static_cast<uint32>(slot.Slot)]));
+			const PolyID      id   = path.empty() ? AssetManager::DEFAULT_TEXTURE_ID : AssetManager::ImportAndLoadTexture(path, slot.Format);
+
+			ManagedTexture texture = AssetManager::GetManagedTexture(id);
+			pPolyMaterial->SetTexture(slot.Slot, texture.pTexture);
+			pPolyMaterial->SetTextureView(slot.Slot, texture.pTextureView);
+
+			if (slot.Slot == Material::Type::COMBINED && !path.empty())
+				materialValues.IsCombined = 1.0;
 		}
 
 		pPolyMaterial->SetMaterialValues(materialValues);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Poly/Model/Material.h"
+#include "Poly/RenderGraph/ResourceManager.h"
+#include "Poly/Resources/CookedModel.h"
 #include "Poly/Rendering/Core/API/GraphicsTypes.h"
 #include "Poly/Scene/Entity.h"
 
@@ -18,9 +20,6 @@ namespace Poly
 	class Shader;
 	class Buffer;
 	class Texture;
-	class CommandPool;
-	class CommandBuffer;
-	class BinarySemaphore;
 
 	struct MeshMaterialRefPair
 	{
@@ -30,6 +29,17 @@ namespace Poly
 
 	class AssetLoader
 	{
+	public:
+		// Decoded RGBA8 pixels, or the blocks of a cooked texture's levels
+		struct Image
+		{
+			std::vector<byte> Pixels; // MipLevels levels back to back, largest first
+			uint32            Width     = 0;
+			uint32            Height    = 0;
+			EFormat           Format    = EFormat::R8G8B8A8_UNORM;
+			uint32            MipLevels = 1;
+		};
+
 	public:
 		AssetLoader()  = default;
 		~AssetLoader() = default;
@@ -41,27 +51,81 @@ namespace Poly
 
 		static std::vector<byte> LoadRawImage(const std::string& path);
 
-		static Ref<Texture> LoadTexture(const std::string& path, EFormat format);
-
-		static Ref<Texture> LoadTextureFromMemory(void* data, uint32 width, uint32 height, uint32 channels, EFormat format);
-
+		/*
+		 * Reads and decodes an image, without touching the GPU - safe to call from several threads at once
+		 * @param path - path of the image
+		 * @return Image - the image, with no pixels if it couldn't be read or decoded
+		 */
+		static Image DecodeImage(const std::string& path);
+
+		/*
+		 * Reads an image for a texture of the given format - safe to call from several threads at once. Images for
+		 * block-compressed formats are cooked: compressed with a full mip chain and written to cache/textures/, from
+		 * where they're read the next time, as long as the source file hasn't changed. Other formats are only decoded.
+		 * @param path - path of the image
+		 * @param format - format of the texture
+		 * @return Image - the image, with no pixels if it couldn't be read or decoded
+		 */
+		static Image LoadTextureImage(const std::string& path, EFormat format);
+
+		/*
+		 * Loads an image into a new texture. Returns as soon as the pixels are queued for upload - see
+		 * LoadTextureFromMemory().
+		 * @param path - path of the image
+		 * @param format - format of the texture
+		 * @param pUploadToken - receives the upload's token, can be nullptr
+		 * @return TextureHandle - the texture, owned by the caller
+		 */
+		static TextureHandle LoadTexture(const std::string& path, EFormat format, UploadToken* pUploadToken = nullptr);
+
+		/*
+		 * Creates a texture of the image's format with a full mip chain and queues the image for upload - see
+		 * LoadTextureFromMemory(). Levels the image doesn't have are generated on the GPU.
+		 * @param image - image from LoadTextureImage(), copied before returning
+		 * @param pUploadToken - receives the upload's token, can be nullptr
+		 * @param debugName - debug name of the texture
+		 * @return TextureHandle - the texture, owned by the caller
+		 */
+		static TextureHandle LoadTextureFromImage(const Image& image, UploadToken* pUploadToken = nullptr, const std::string& debugName = "");
+
+		/*
+		 * Creates a texture and queues its pixels for ResourceManager's next upload flush, without waiting for it.
+		 * Render graph passes wait for the upload on the GPU (ResourceManager::GetTextureUploadSync()),
+		 * anything else reading the texture has to check the token first (ResourceManager::IsUploadComplete()).
+		 * The texture gets a full mip chain, downsampled from the pixels on the GPU.
+		 * @param data - width * height RGBA8 pixels, copied before returning
+		 * @param pUploadToken - receives the upload's token, can be nullptr
+		 * @param debugName - debug name of the texture
+		 * @return TextureHandle - the texture, owned by the caller
+		 */
+		static TextureHandle LoadTextureFromMemory(const void* data, uint32 width, uint32 height, uint32 channels, EFormat format,
+		                                           UploadToken* pUploadToken = nullptr, const std::string& debugName = "");
+
+		/*
+		 * Loads a model and creates a hierarchy of its nodes under the entity. The imported model is cooked into
+		 * cache/models/ (see CookedModel), so Assimp only runs again once the file, or a glTF file's external buffers, change.
+		 * @param path - path of the model
+		 * @param root - root entity of the hierarchy, none to only create the model
+		 * @return Ref<Model> - the model, nullptr if it couldn't be imported
+		 */
 		static Ref<Model> LoadModel(const std::string& path, Entity root);
 
 		static Ref<Material> LoadMaterial(const std::string& path);
 
 	private:
-		static void          ProcessNode(aiNode* pNode, const aiScene* pScene, const std::string& folder, Model* pModel, Entity parent);
-		static Ref<Mesh>     ProcessMesh(aiMesh* pMesh, const aiScene* pScene, Model* pModel, uint32 index);
-		static Ref<Material> ProcessMaterial(aiMaterial* pMaterial, const aiScene* pScene, Model* pModel, uint32 index, const std::string& folder);
-		static glm::mat4     ConvertAiMatToGLM(const void* pMat);
+		// Importing with Assimp, into a cooked model file (see CookedModel)
+		static std::vector<byte> CookModel(const std::string& path, uint64 sourceHash);
+		static void              CookNode(aiNode* pNode, const aiScene* pScene, uint32 parent, CookedModel::Builder& builder);
+		static void              CookMesh(aiMesh* pMesh, CookedModel::Builder& builder);
+		static void              CookMaterial(aiMaterial* pMaterial, const std::string& folder, CookedModel::Builder& builder);
 
-		inline static bool s_GLSLInit = false;
-		;
+		// Creating the model, its entities and resources from a cooked model
+		static Ref<Model>    CreateModel(const CookedModel& cookedModel, Entity root);
+		static Ref<Mesh>     CreateMesh(const CookedModel& cookedModel, const CookedModel::MeshRecord& mesh, Model* pModel, uint32 index);
+		static Ref<Material> CreateMaterial(const CookedModel& cookedModel, const CookedModel::MaterialRecord& material, Model* pModel, uint32 index);
+
+		static glm::mat4 ConvertAiMatToGLM(const void* pMat);
 
-		inline static Ref<CommandPool>     s_TransferCommandPool;
-		inline static CommandBuffer*       s_TransferCommandBuffer = nullptr;
-		inline static Ref<CommandPool>     s_GraphicsCommandPool;
-		inline static CommandBuffer*       s_GraphicsCommandBuffer = nullptr;
-		inline static Ref<BinarySemaphore> s_Semaphore;
+		inline static bool s_GLSLInit = false;
 	};
 } // namespace Poly
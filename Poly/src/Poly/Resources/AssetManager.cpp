@@ -4,10 +4,11 @@
 #include "AssetLoader.h"
 #include "Platform/API/Texture.h"
 #include "Platform/API/TextureView.h"
-#include "Poly/Core/RenderAPI.h"
+#include "Poly/Core/ThreadPool.h"
 #include "Poly/Model/Material.h"
 #include "Poly/Model/Mesh.h"
 #include "Poly/Model/Model.h"
+#include "Poly/RenderGraph/ResourceManager.h"
 #include "Poly/Resources/VFS/VirtualFileSystem.h"
 #include "polypch.h"
 
@@ -22,6 +23,9 @@ namespace Poly
 
 	void AssetManager::Release()
 	{
+		for (const ManagedTexture& texture : m_Textures)
+			ResourceManager::Destroy(texture.Handle);
+
 		m_Models.clear();
 		m_Textures.clear();
 		m_Materials.clear();
@@ -63,23 +67,13 @@ namespace Poly
 		if (handle.IsLoaded)
 			return;
 
-		Ref<Texture> pTex = AssetLoader::LoadTexture(handle.Path, format);
-
-		// TODO: Grab necessary data from texture
-		Poly::TextureViewDesc textureViewDesc = {
-		    .pTexture        = pTex.get(),
-		    .ImageViewType   = Poly::EImageViewType::TYPE_2D,
-		    .Format          = format,
-		    .ImageViewFlag   = Poly::FImageViewFlag::COLOR,
-		    .MipLevel        = 0,
-		    .MipLevelCount   = 1,
-		    .ArrayLayer      = 0,
-		    .ArrayLayerCount = 1,
-		};
-		Ref<TextureView> pTextureView = RenderAPI::CreateTextureView(&textureViewDesc);
+		ManagedTexture texture = {};
+		texture.Handle         = AssetLoader::LoadTexture(handle.Path, format, &texture.Upload);
+		texture.pTexture       = ResourceManager::Resolve(texture.Handle);
+		texture.pTextureView   = ResourceManager::ResolveView(texture.Handle);
 
 		uint32 index = static_cast<uint32>(m_Textures.size());
-		m_Textures.push_back({.pTexture = pTex, .pTextureView = pTextureView});
+		m_Textures.push_back(texture);
 
 		handle.Index    = index;
 		handle.IsLoaded = true;
@@ -102,6 +96,53 @@ namespace Poly
 		return pathID;
 	}
 
+	void AssetManager::ImportAndLoadTextures(const std::vector<std::pair<std::string, EFormat>>& textures)
+	{
+		// Importing touches the project file, so it stays on this thread
+		std::vector<std::pair<PolyID, EFormat>> toLoad;
+		std::unordered_set<PolyID>              queued;
+		for (const auto& [path, format] : textures)
+		{
+			PolyID pathID = AssetImporter::ImportTexture(path);
+
+			if (!m_IDToHandle.contains(pathID))
+			{
+				ResourceHandle handle = {};
+				handle.Path           = path;
+				handle.Type           = ResourceType::TEXTURE;
+				m_IDToHandle[pathID]  = handle;
+			}
+
+			if (!m_IDToHandle[pathID].IsLoaded && queued.insert(pathID).second)
+				toLoad.emplace_back(pathID, format);
+		}
+
+		// One job per image - reading the file in the job too lets the reads overlap with other images' decoding (or
+		// compressing, for images that aren't in the texture cache yet)
+		std::vector<AssetLoader::Image> images(toLoad.size());
+		ThreadPool::ParallelFor(static_cast<uint32>(toLoad.size()), 1, [&](uint32 i) {
+			images[i] = AssetLoader::LoadTextureImage(m_IDToHandle.at(toLoad[i].first).Path, toLoad[i].second);
+		});
+
+		for (uint32 i = 0; i < static_cast<uint32>(toLoad.size()); i++)
+		{
+			const AssetLoader::Image& image = images[i];
+			if (image.Pixels.empty())
+				continue;
+
+			ResourceHandle& handle = m_IDToHandle[toLoad[i].first];
+
+			ManagedTexture texture = {};
+			texture.Handle         = AssetLoader::LoadTextureFromImage(image, &texture.Upload, handle.Path);
+			texture.pTexture       = ResourceManager::Resolve(texture.Handle);
+			texture.pTextureView   = ResourceManager::ResolveView(texture.Handle);
+
+			handle.Index    = static_cast<uint32>(m_Textures.size());
+			handle.IsLoaded = true;
+			m_Textures.push_back(texture);
+		}
+	}
+
 	void AssetManager::LoadModel(PolyID modelID, Entity root)
 	{
 		if (!m_IDToHandle.contains(modelID))
@@ -181,6 +222,28 @@ namespace Poly
 		return pathID;
 	}
 
+	void AssetManager::UnloadResource(PolyID id)
+	{
+		if (!IsResourceLoaded(id))
+			return;
+
+		ResourceHandle& handle = m_IDToHandle[id];
+
+		// Materials only hold raw pointers to their textures, and meshes to their materials - only models can go for now
+		if (handle.Type != ResourceType::MODEL)
+		{
+			POLY_CORE_WARN("Tried to unload resource {}, but only models can be unloaded", id);
+			return;
+		}
+
+		// The slot stays so other models' indices stay valid. MeshComponents only point at the model, so entities
+		// using it have to be destroyed first - its meshes free their geometry once SceneRenderBridge lets go of them.
+		m_Models[handle.Index].reset();
+
+		handle.Index    = UINT32_MAX;
+		handle.IsLoaded = false;
+	}
+
 	Mesh* AssetManager::GetMesh(PolyID modelID, uint32 meshIndex)
 	{
 		if (!HasCorrectResource(modelID, ResourceType::MODEL))
@@ -226,7 +289,7 @@ namespace Poly
 		uint32 index = m_IDToHandle[textureID].Index;
 
 		if (index < m_Textures.size())
-			return m_Textures[index].pTexture.get();
+			return m_Textures[index].pTexture;
 
 		POLY_CORE_WARN("Tried to get texture with ID {}, but ID was out of range", index);
 		return nullptr;
@@ -244,7 +307,7 @@ namespace Poly
 		uint32 index = m_IDToHandle[textureViewID].Index;
 
 		if (index < m_Textures.size())
-			return m_Textures[index].pTextureView.get();
+			return m_Textures[index].pTextureView;
 
 		POLY_CORE_WARN("Tried to get texture view with ID {}, but ID was out of range", index);
 		return nullptr;
@@ -334,28 +397,19 @@ namespace Poly
 
 		m_Materials.push_back(pMaterial);
 
-		uint32       width    = 1;
-		uint32       height   = 1;
-		uint32       channels = 4;
-		byte         data[4]  = {255, 255, 255, 255};
-		Ref<Texture> pTexture = AssetLoader::LoadTextureFromMemory(&data, width, height, channels, EFormat::R8G8B8A8_UNORM);
-
-		Poly::TextureViewDesc textureViewDesc = {
-		    .pTexture        = pTexture.get(),
-		    .ImageViewType   = Poly::EImageViewType::TYPE_2D,
-		    .Format          = EFormat::R8G8B8A8_UNORM,
-		    .ImageViewFlag   = Poly::FImageViewFlag::COLOR,
-		    .MipLevel        = 0,
-		    .MipLevelCount   = 1,
-		    .ArrayLayer      = 0,
-		    .ArrayLayerCount = 1,
-		};
-		Ref<TextureView> pTextureView = RenderAPI::CreateTextureView(&textureViewDesc);
-
-		m_Textures.push_back({pTexture, pTextureView});
-
-		pMaterial->SetTexture(Material::Type::ALBEDO, pTexture.get());
-		pMaterial->SetTextureView(Material::Type::ALBEDO, pTextureView.get());
+		uint32 width    = 1;
+		uint32 height   = 1;
+		uint32 channels = 4;
+		byte   data[4]  = {255, 255, 255, 255};
+
+		ManagedTexture texture = {};
+		texture.Handle         = AssetLoader::LoadTextureFromMemory(&data, width, height, channels, EFormat::R8G8B8A8_UNORM, &texture.Upload, "Default Texture");
+		texture.pTexture       = ResourceManager::Resolve(texture.Handle);
+		texture.pTextureView   = ResourceManager::ResolveView(texture.Handle);
+		m_Textures.push_back(texture);
+
+		pMaterial->SetTexture(Material::Type::ALBEDO, texture.pTexture);
+		pMaterial->SetTextureView(Material::Type::ALBEDO, texture.pTextureView);
 
 		MaterialValues matVals = {};
 		pMaterial->SetMaterialValues(matVals);
@@ -48,6 +48,13 @@ namespace Poly
 		 */
 		static PolyID ImportAndLoadTexture(const std::string& path, EFormat format);
 
+		/**
+		 * ImportAndLoadTexture() for several textures at once - the files are read and decoded (or cooked) in parallel
+		 * on the ThreadPool, then uploaded together
+		 * @param textures - paths of the textures and their formats, ones already loaded (or listed twice) are skipped
+		 */
+		static void ImportAndLoadTextures(const std::vector<std::pair<std::string, EFormat>>& textures);
+
 		/**
 		 * Loads model from file and creates a hierarchy with the entity as root
 		 * @param path - path of model
@@ -77,7 +84,8 @@ namespace Poly
 		static PolyID ImportAndLoadMaterial(const std::string& path);
 
 		/**
-		 * Unloads the resource from memory
+		 * Unloads the resource from memory - only models for now, whose geometry is freed from GeometryPool.
+		 * Entities with a MeshComponent of the model have to be destroyed first.
 		 * @param id - PolyID of the resource
 		 */
 		static void UnloadResource(PolyID id);
@@ -1,14 +1,19 @@
 #pragma once
 
+#include "Poly/RenderGraph/ResourceManager.h"
+
 namespace Poly
 {
 	class Texture;
 	class TextureView;
 
+	// A texture owned by AssetManager - pTexture/pTextureView are resolved from Handle, and stay valid until it's released
 	struct ManagedTexture
 	{
-		Ref<Texture>     pTexture     = nullptr;
-		Ref<TextureView> pTextureView = nullptr;
+		TextureHandle Handle;
+		UploadToken   Upload; // readers outside the render graph check it before sampling (ResourceManager::IsUploadComplete())
+		Texture*      pTexture     = nullptr;
+		TextureView*  pTextureView = nullptr;
 	};
 
 	enum class ResourceType
@@ -0,0 +1,212 @@
+#include "CookedModel.h"
+
+#include "Poly/Resources/GeometryPool.h"
+#include "polypch.h"
+
+#include <cstring>
+
+namespace Poly
+{
+	uint32 CookedModel::Builder::AddMesh(const std::vector<Vertex>& vertices, const std::vector<MeshLodData>& lods, const MeshBounds& bounds)
+	{
+		MeshRecord mesh   = {};
+		mesh.Bounds       = bounds;
+		mesh.FirstVertex  = static_cast<uint32>(m_Vertices.size());
+		mesh.VertexCount  = static_cast<uint32>(vertices.size());
+		mesh.FirstIndex   = static_cast<uint32>(m_Indices.size());
+		mesh.FirstMeshlet = static_cast<uint32>(m_Meshlets.size());
+		mesh.FirstLod     = static_cast<uint32>(m_Lods.size());
+
+		std::vector<uint32>  indices;
+		std::vector<Meshlet> meshlets;
+		std::vector<MeshLod> meshLods;
+		GeometryPool::FlattenLods(lods, indices, meshlets, meshLods);
+
+		mesh.IndexCount   = static_cast<uint32>(indices.size());
+		mesh.MeshletCount = static_cast<uint32>(meshlets.size());
+		mesh.LodCount     = static_cast<uint32>(meshLods.size());
+
+		m_Vertices.insert(m_Vertices.end(), vertices.begin(), vertices.end());
+		m_Indices.insert(m_Indices.end(), indices.begin(), indices.end());
+		m_Meshlets.insert(m_Meshlets.end(), meshlets.begin(), meshlets.end());
+		m_Lods.insert(m_Lods.end(), meshLods.begin(), meshLods.end());
+
+		m_Meshes.push_back(mesh);
+		return static_cast<uint32>(m_Meshes.size() - 1);
+	}
+
+	uint32 CookedModel::Builder::AddMaterial(const MaterialValues& values, const std::string (&texturePaths)[TEXTURE_SLOT_COUNT])
+	{
+		MaterialRecord material = {};
+		material.Values         = values;
+		for (uint32 i = 0; i < TEXTURE_SLOT_COUNT; i++)
+		{
+			if (texturePaths[i].empty())
+			{
+				material.TexturePaths[i] = INVALID_INDEX;
+				continue;
+			}
+
+			material.TexturePaths[i] = static_cast<uint32>(m_Strings.size());
+			m_Strings.insert(m_Strings.end(), texturePaths[i].begin(), texturePaths[i].end());
+			m_Strings.push_back('\0');
+		}
+
+		m_Materials.push_back(material);
+		return static_cast<uint32>(m_Materials.size() - 1);
+	}
+
+	uint32 CookedModel::Builder::AddNode(const glm::mat4& transform, uint32 parent, const std::vector<MeshInstanceRecord>& meshInstances)
+	{
+		NodeRecord node        = {};
+		node.Transform         = transform;
+		node.Parent            = parent;
+		node.FirstMeshInstance = static_cast<uint32>(m_MeshInstances.size());
+		node.MeshInstanceCount = static_cast<uint32>(meshInstances.size());
+
+		m_MeshInstances.insert(m_MeshInstances.end(), meshInstances.begin(), meshInstances.end());
+
+		m_Nodes.push_back(node);
+		return static_cast<uint32>(m_Nodes.size() - 1);
+	}
+
+	std::vector<byte> CookedModel::Builder::Serialize(uint64 sourceHash) const
+	{
+		const std::pair<const void*, uint64> sections[SECTION_COUNT] = {
+		    {m_Meshes.data(), m_Meshes.size() * sizeof(MeshRecord)},
+		    {m_Materials.data(), m_Materials.size() * sizeof(MaterialRecord)},
+		    {m_Nodes.data(), m_Nodes.size() * sizeof(NodeRecord)},
+		    {m_MeshInstances.data(), m_MeshInstances.size() * sizeof(MeshInstanceRecord)},
+		    {m_Vertices.data(), m_Vertices.size() * sizeof(Vertex)},
+		    {m_Indices.data(), m_Indices.size() * sizeof(uint32)},
+		    {m_Meshlets.data(), m_Meshlets.size() * sizeof(Meshlet)},
+		    {m_Lods.data(), m_Lods.size() * sizeof(MeshLod)},
+		    {m_Strings.data(), m_Strings.size()}};
+
+		Header header     = {};
+		header.Magic      = MAGIC;
+		header.Version    = VERSION;
+		header.SourceHash = sourceHash;
+
+		uint64 offset = sizeof(Header);
+		for (uint32 i = 0; i < SECTION_COUNT; i++)
+		{
+			header.Sections[i].Offset = offset;
+			header.Sections[i].Size   = sections[i].second;
+			offset                    = (offset + sections[i].second + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+		}
+		header.FileSize = offset;
+
+		std::vector<byte> file(offset, 0);
+		std::memcpy(file.data(), &header, sizeof(header));
+		for (uint32 i = 0; i < SECTION_COUNT; i++)
+		{
+			if (sections[i].second > 0)
+				std::memcpy(file.data() + header.Sections[i].Offset, sections[i].first, sections[i].second);
+		}
+
+		return file;
+	}
+
+	bool CookedModel::Load(std::vector<byte> data, uint64 sourceHash)
+	{
+		m_Data.clear();
+		if (data.size() < sizeof(Header))
+			return false;
+
+		Header header;
+		std::memcpy(&header, data.data(), sizeof(header));
+		if (header.Magic != MAGIC || header.Version != VERSION || header.SourceHash != sourceHash || header.FileSize != data.size())
+			return false;
+
+		m_Data = std::move(data);
+		if (!Validate())
+		{
+			m_Data.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	std::string_view CookedModel::GetString(uint32 offset) const
+	{
+		if (offset == INVALID_INDEX)
+			return {};
+
+		return GetSection<char>(SECTION_STRINGS).data() + offset;
+	}
+
+	bool CookedModel::Validate() const
+	{
+		// A file cut short or written by something else mustn't take the loader out of bounds - every section has to
+		// be in the file, and every index in a record has to be in the section it refers to
+		const Header& header = *reinterpret_cast<const Header*>(m_Data.data());
+		for (const Section& section : header.Sections)
+		{
+			if (section.Offset % SECTION_ALIGNMENT != 0 || section.Offset > m_Data.size() || section.Size > m_Data.size() - section.Offset)
+				return false;
+		}
+
+		const auto isRange = [](uint64 first, uint64 count, uint64 size) { return first <= size && count <= size - first; };
+
+		const uint64 vertexCount  = GetSection<Vertex>(SECTION_VERTICES).size();
+		const uint64 indexCount   = GetSection<uint32>(SECTION_INDICES).size();
+		const uint64 meshletCount = GetSection<Meshlet>(SECTION_MESHLETS).size();
+		const uint64 lodCount     = GetSection<MeshLod>(SECTION_LODS).size();
+		for (const MeshRecord& mesh : GetMeshes())
+		{
+			if (!isRange(mesh.FirstVertex, mesh.VertexCount, vertexCount) || !isRange(mesh.FirstIndex, mesh.IndexCount, indexCount)
+			    || !isRange(mesh.FirstMeshlet, mesh.MeshletCount, meshletCount) || !isRange(mesh.FirstLod, mesh.LodCount, lodCount))
+				return false;
+
+			// Within a mesh, meshlets and LODs are relative to the mesh's own ranges, and indices to its vertices
+			for (const Meshlet& meshlet : GetMeshlets(mesh))
+			{
+				if (!isRange(meshlet.FirstIndex, meshlet.IndexCount, mesh.IndexCount))
+					return false;
+			}
+
+			for (const MeshLod& lod : GetLods(mesh))
+			{
+				if (!isRange(lod.FirstMeshlet, lod.MeshletCount, mesh.MeshletCount))
+					return false;
+			}
+
+			for (uint32 index : GetIndices(mesh))
+			{
+				if (index >= mesh.VertexCount)
+					return false;
+			}
+		}
+
+		const std::span<const char> strings = GetSection<char>(SECTION_STRINGS);
+		if (!strings.empty() && strings.back() != '\0')
+			return false;
+
+		for (const MaterialRecord& material : GetMaterials())
+		{
+			for (uint32 path : material.TexturePaths)
+			{
+				if (path != INVALID_INDEX && path >= strings.size())
+					return false;
+			}
+		}
+
+		const std::span<const MeshInstanceRecord> meshInstances = GetMeshInstances();
+		for (const MeshInstanceRecord& meshInstance : meshInstances)
+		{
+			if (meshInstance.Mesh >= GetMeshes().size() || meshInstance.Material >= GetMaterials().size())
+				return false;
+		}
+
+		const std::span<const NodeRecord> nodes = GetNodes();
+		for (uint32 i = 0; i < nodes.size(); i++)
+		{
+			if ((nodes[i].Parent != INVALID_INDEX && nodes[i].Parent >= i) || !isRange(nodes[i].FirstMeshInstance, nodes[i].MeshInstanceCount, meshInstances.size()))
+				return false;
+		}
+
+		return true;
+	}
+} // namespace Poly
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "Poly/Model/Material.h"
+#include "Poly/Model/Mesh.h"
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Poly
+{
+	/*
+	 * An imported model in the binary form AssetLoader caches under cache/models/, so loading it again skips Assimp
+	 * and MeshOptimizer. The file is a Header followed by sections of fixed-size records, each at a 16-byte aligned
+	 * offset. Geometry is stored the way GeometryPool::UploadMesh() takes it, so loading is one read of the file and
+	 * spans into its bytes, with nothing to parse. Records refer to each other by index:
+	 *   - MeshRecord: a mesh's bounds and its ranges of the vertex, index, meshlet and LOD sections
+	 *   - MaterialRecord: the material's constants and, per Material::Type, the path of its texture
+	 *   - NodeRecord: the node hierarchy in depth-first order, so a node's parent always comes before it, with each
+	 *     node's transform and range of MeshInstanceRecords (a mesh and the material it's drawn with)
+	 *
+	 * A cooked model is only used if it was cooked from a source file with the same hash, by the same VERSION - the
+	 * hash only covers the file the model was imported from, not files it references (e.g. a glTF's .bin).
+	 */
+	class CookedModel
+	{
+	public:
+		static constexpr uint32 MAGIC = 0x4C444D50; // "PMDL"
+
+		// Has to change whenever importing gives a different result - Assimp's flags, MeshOptimizer or the records
+		static constexpr uint32 VERSION = 2;
+
+		static constexpr uint32 INVALID_INDEX      = UINT32_MAX;
+		static constexpr uint32 TEXTURE_SLOT_COUNT = static_cast<uint32>(Material::Type::COMBINED) + 1;
+
+		struct MeshRecord
+		{
+			MeshBounds Bounds;
+			uint32     FirstVertex;
+			uint32     VertexCount;
+			uint32     FirstIndex;
+			uint32     IndexCount;
+			uint32     FirstMeshlet;
+			uint32     MeshletCount;
+			uint32     FirstLod;
+			uint32     LodCount;
+		};
+
+		struct MaterialRecord
+		{
+			MaterialValues Values;
+			uint32         TexturePaths[TEXTURE_SLOT_COUNT]; // offsets in the string section, INVALID_INDEX for none
+		};
+
+		struct NodeRecord
+		{
+			glm::mat4 Transform;
+			uint32    Parent; // INVALID_INDEX for the root
+			uint32    FirstMeshInstance;
+			uint32    MeshInstanceCount;
+			uint32    _Pad;
+		};
+
+		struct MeshInstanceRecord
+		{
+			uint32 Mesh;
+			uint32 Material;
+		};
+
+		/*
+		 * Collects a model's records while it's imported, then writes them out in the cooked layout
+		 */
+		class Builder
+		{
+		public:
+			/*
+			 * Adds a mesh
+			 * @param vertices - vertices of the mesh, after MeshOptimizer
+			 * @param lods - levels of detail from MeshOptimizer::BuildLods()
+			 * @param bounds - object-space bounds of the vertices
+			 * @return index of the mesh
+			 */
+			uint32 AddMesh(const std::vector<Vertex>& vertices, const std::vector<MeshLodData>& lods, const MeshBounds& bounds);
+
+			/*
+			 * Adds a material
+			 * @param values - constants of the material
+			 * @param texturePaths - path of the texture for each Material::Type, empty for none
+			 * @return index of the material
+			 */
+			uint32 AddMaterial(const MaterialValues& values, const std::string (&texturePaths)[TEXTURE_SLOT_COUNT]);
+
+			/*
+			 * Adds a node - has to come after its parent
+			 * @param transform - transform relative to the parent
+			 * @param parent - index of the parent, INVALID_INDEX for the root
+			 * @param meshInstances - meshes of the node, and their materials
+			 * @return index of the node
+			 */
+			uint32 AddNode(const glm::mat4& transform, uint32 parent, const std::vector<MeshInstanceRecord>& meshInstances);
+
+			/*
+			 * Lays the records out as a cooked model file
+			 * @param sourceHash - hash of the file the model was imported from
+			 * @return the file
+			 */
+			std::vector<byte> Serialize(uint64 sourceHash) const;
+
+		private:
+			std::vector<MeshRecord>         m_Meshes;
+			std::vector<MaterialRecord>     m_Materials;
+			std::vector<NodeRecord>         m_Nodes;
+			std::vector<MeshInstanceRecord> m_MeshInstances;
+			std::vector<Vertex>             m_Vertices;
+			std::vector<uint32>             m_Indices;
+			std::vector<Meshlet>            m_Meshlets;
+			std::vector<MeshLod>            m_Lods;
+			std::vector<char>               m_Strings;
+		};
+
+	public:
+		CookedModel()  = default;
+		~CookedModel() = default;
+
+		/*
+		 * Takes a cooked model file's bytes, if they're a complete file of the current VERSION cooked from the source
+		 * @param data - the file
+		 * @param sourceHash - hash of the file the model has to have been imported from
+		 * @return whether the file is usable - if not, the CookedModel is left empty
+		 */
+		bool Load(std::vector<byte> data, uint64 sourceHash);
+
+		std::span<const MeshRecord>         GetMeshes() const { return GetSection<MeshRecord>(SECTION_MESHES); }
+		std::span<const MaterialRecord>     GetMaterials() const { return GetSection<MaterialRecord>(SECTION_MATERIALS); }
+		std::span<const NodeRecord>         GetNodes() const { return GetSection<NodeRecord>(SECTION_NODES); }
+		std::span<const MeshInstanceRecord> GetMeshInstances() const { return GetSection<MeshInstanceRecord>(SECTION_MESH_INSTANCES); }
+
+		std::span<const Vertex>  GetVertices(const MeshRecord& mesh) const { return GetSection<Vertex>(SECTION_VERTICES).subspan(mesh.FirstVertex, mesh.VertexCount); }
+		std::span<const uint32>  GetIndices(const MeshRecord& mesh) const { return GetSection<uint32>(SECTION_INDICES).subspan(mesh.FirstIndex, mesh.IndexCount); }
+		std::span<const Meshlet> GetMeshlets(const MeshRecord& mesh) const { return GetSection<Meshlet>(SECTION_MESHLETS).subspan(mesh.FirstMeshlet, mesh.MeshletCount); }
+		std::span<const MeshLod> GetLods(const MeshRecord& mesh) const { return GetSection<MeshLod>(SECTION_LODS).subspan(mesh.FirstLod, mesh.LodCount); }
+
+		/*
+		 * Gets a string of a record
+		 * @param offset - offset of the string in the string section
+		 * @return the string, empty for INVALID_INDEX
+		 */
+		std::string_view GetString(uint32 offset) const;
+
+	private:
+		enum ESection : uint32
+		{
+			SECTION_MESHES,
+			SECTION_MATERIALS,
+			SECTION_NODES,
+			SECTION_MESH_INSTANCES,
+			SECTION_VERTICES,
+			SECTION_INDICES,
+			SECTION_MESHLETS,
+			SECTION_LODS,
+			SECTION_STRINGS,
+			SECTION_COUNT
+		};
+
+		struct Section
+		{
+			uint64 Offset; // from the start of the file
+			uint64 Size;   // in bytes
+		};
+
+		struct Header
+		{
+			uint32  Magic;
+			uint32  Version;
+			uint64  SourceHash;
+			uint64  FileSize;
+			uint64  _Pad;
+			Section Sections[SECTION_COUNT];
+		};
+
+		static constexpr uint64 SECTION_ALIGNMENT = 16;
+
+		template<typename T>
+		std::span<const T> GetSection(ESection section) const
+		{
+			if (m_Data.empty())
+				return {};
+
+			// The file's buffer is allocated with at least 16-byte alignment, and sections start at 16-byte offsets
+			const Section& range = reinterpret_cast<const Header*>(m_Data.data())->Sections[section];
+			return {reinterpret_cast<const T*>(m_Data.data() + range.Offset), range.Size / sizeof(T)};
+		}
+
+		bool Validate() const;
+
+		std::vector<byte> m_Data;
+	};
+} // namespace Poly
@@ -1,5 +1,7 @@
 #include "GeometryPool.h"
 
+#include <algorithm>
+
 namespace Poly
 {
 	void GeometryPool::Init()
@@ -8,24 +10,258 @@ namespace Poly
 	void GeometryPool::Release()
 	{
 		s_VertexArena.Reset();
+		s_PackedVertexArena.Reset();
 		s_IndexArena.Reset();
+		s_Index16Arena.Reset();
+		s_BoundsArena.Reset();
+		s_MeshletArena.Reset();
+		s_LodArena.Reset();
+
+		// Meshes still alive after this only have stale handles
+		s_FreeMeshSlots.clear();
+		for (uint32 i = 0; i < static_cast<uint32>(s_Meshes.size()); i++)
+		{
+			s_Meshes[i].Range = {};
+			s_Meshes[i].Alive = false;
+			s_Meshes[i].Generation++;
+			s_FreeMeshSlots.push_back(i);
+		}
+	}
+
+	void GeometryPool::Update()
+	{
+		s_VertexArena.Update();
+		s_PackedVertexArena.Update();
+		s_IndexArena.Update();
+		s_Index16Arena.Update();
+		s_BoundsArena.Update();
+		s_MeshletArena.Update();
+		s_LodArena.Update();
+
+		if (!IsFragmented(GetVertexArena()) && !IsFragmented(s_IndexArena) && !IsFragmented(s_Index16Arena))
+			return;
+
+		std::vector<BufferRange*> vertexRanges;
+		std::vector<BufferRange*> indexRanges;
+		std::vector<BufferRange*> index16Ranges;
+		for (MeshSlot& slot : s_Meshes)
+		{
+			if (!slot.Alive)
+				continue;
+
+			vertexRanges.push_back(&slot.Range.Vertices);
+			(slot.Range.IndexType == EIndexType::UINT16 ? index16Ranges : indexRanges).push_back(&slot.Range.Indices);
+		}
+
+		uint64 budgetBytes = COMPACTION_BYTES_PER_FRAME;
+		bool   moved       = CompactArena(GetVertexArena(), vertexRanges, budgetBytes);
+		moved |= CompactArena(s_IndexArena, indexRanges, budgetBytes);
+		moved |= CompactArena(s_Index16Arena, index16Ranges, budgetBytes);
+		if (moved)
+			s_Generation++;
+	}
+
+	void GeometryPool::SetVertexFormat(EVertexFormat format)
+	{
+		if (format == s_VertexFormat)
+			return;
+
+		if (s_VertexArena.GetCount() > 0 || s_PackedVertexArena.GetCount() > 0)
+		{
+			POLY_CORE_WARN("Cannot change GeometryPool's vertex format, meshes have already been uploaded");
+			return;
+		}
+
+		s_VertexFormat = format;
 	}
 
-	MeshRange GeometryPool::UploadMesh(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices)
+	GeometryHandle GeometryPool::UploadMesh(std::span<const Vertex> vertices, std::span<const uint32> indices, std::span<const Meshlet> meshlets,
+	                                        std::span<const MeshLod> lods, const MeshBounds& bounds)
 	{
 		MeshRange range;
-		range.Vertices = s_VertexArena.Upload(vertices.data(), static_cast<uint32>(vertices.size()));
-		range.Indices  = s_IndexArena.Upload(indices.data(), static_cast<uint32>(indices.size()));
-		return range;
+		if (s_VertexFormat == EVertexFormat::PACKED)
+		{
+			std::vector<PackedVertex> packedVertices(vertices.size());
+			std::transform(vertices.begin(), vertices.end(), packedVertices.begin(), PackedVertex::Pack);
+			range.Vertices = s_PackedVertexArena.Upload(packedVertices.data(), static_cast<uint32>(packedVertices.size()));
+		}
+		else
+		{
+			range.Vertices = s_VertexArena.Upload(vertices.data(), static_cast<uint32>(vertices.size()));
+		}
+
+		range.Meshlets = s_MeshletArena.Upload(meshlets.data(), static_cast<uint32>(meshlets.size()));
+
+		// Meshlets could land anywhere in the arena, so the LODs are rebased once they have
+		std::vector<MeshLod> gpuLods(lods.begin(), lods.end());
+		for (MeshLod& gpuLod : gpuLods)
+		{
+			uint32 indexCount = 0;
+			for (const Meshlet& meshlet : meshlets.subspan(gpuLod.FirstMeshlet, gpuLod.MeshletCount))
+				indexCount += meshlet.IndexCount;
+
+			gpuLod.FirstMeshlet += range.Meshlets.ElementOffset;
+			range.MaxLodMeshletCount = std::max(range.MaxLodMeshletCount, gpuLod.MeshletCount);
+			range.MaxLodIndexCount   = std::max(range.MaxLodIndexCount, indexCount);
+		}
+
+		if (vertices.size() <= MAX_INDEX16_VERTEX_COUNT)
+		{
+			std::vector<uint16> narrowIndices(indices.begin(), indices.end());
+			range.Indices   = s_Index16Arena.Upload(narrowIndices.data(), static_cast<uint32>(narrowIndices.size()));
+			range.IndexType = EIndexType::UINT16;
+		}
+		else
+		{
+			range.Indices   = s_IndexArena.Upload(indices.data(), static_cast<uint32>(indices.size()));
+			range.IndexType = EIndexType::UINT32;
+		}
+
+		range.Lods = s_LodArena.Upload(gpuLods.data(), static_cast<uint32>(gpuLods.size()));
+
+		MeshBounds gpuBounds = bounds;
+		gpuBounds.FirstLod   = range.Lods.ElementOffset;
+		gpuBounds.LodCount   = range.Lods.ElementCount;
+		range.Bounds         = s_BoundsArena.Upload(&gpuBounds, 1);
+
+		uint32 index;
+		if (!s_FreeMeshSlots.empty())
+		{
+			index = s_FreeMeshSlots.back();
+			s_FreeMeshSlots.pop_back();
+		}
+		else
+		{
+			index = static_cast<uint32>(s_Meshes.size());
+			s_Meshes.emplace_back();
+		}
+
+		MeshSlot& slot = s_Meshes[index];
+		slot.Range     = range;
+		slot.Alive     = true;
+		return GeometryHandle(index, slot.Generation);
+	}
+
+	void GeometryPool::FlattenLods(const std::vector<MeshLodData>& lods, std::vector<uint32>& indices, std::vector<Meshlet>& meshlets, std::vector<MeshLod>& gpuLods)
+	{
+		// All levels back to back, with every level's meshlets rebased from its own indices onto the mesh's
+		for (const MeshLodData& lod : lods)
+		{
+			MeshLod gpuLod      = {};
+			gpuLod.FirstMeshlet = static_cast<uint32>(meshlets.size());
+			gpuLod.MeshletCount = static_cast<uint32>(lod.Meshlets.size());
+			gpuLod.Error        = lod.Error;
+			gpuLods.push_back(gpuLod);
+
+			const uint32 firstIndex = static_cast<uint32>(indices.size());
+			for (Meshlet meshlet : lod.Meshlets)
+			{
+				meshlet.FirstIndex += firstIndex;
+				meshlets.push_back(meshlet);
+			}
+			indices.insert(indices.end(), lod.Indices.begin(), lod.Indices.end());
+		}
+	}
+
+	void GeometryPool::FreeMesh(GeometryHandle handle)
+	{
+		if (!handle.IsValid() || handle.GetIndex() >= s_Meshes.size())
+			return;
+
+		MeshSlot& slot = s_Meshes[handle.GetIndex()];
+		if (!slot.Alive || (slot.Generation & 0xFF) != handle.GetGeneration())
+			return;
+
+		GetVertexArena().Free(slot.Range.Vertices);
+		GetIndexArena(slot.Range.IndexType).Free(slot.Range.Indices);
+		s_BoundsArena.Free(slot.Range.Bounds);
+		s_MeshletArena.Free(slot.Range.Meshlets);
+		s_LodArena.Free(slot.Range.Lods);
+
+		slot.Range = {};
+		slot.Alive = false;
+		slot.Generation++;
+		s_FreeMeshSlots.push_back(handle.GetIndex());
+	}
+
+	const MeshRange& GeometryPool::GetMeshRange(GeometryHandle handle)
+	{
+		static const MeshRange s_EmptyRange = {};
+		if (!handle.IsValid() || handle.GetIndex() >= s_Meshes.size())
+			return s_EmptyRange;
+
+		const MeshSlot& slot = s_Meshes[handle.GetIndex()];
+		if (!slot.Alive || (slot.Generation & 0xFF) != handle.GetGeneration())
+			return s_EmptyRange;
+
+		return slot.Range;
 	}
 
 	BufferHandle GeometryPool::GetVertexBufferHandle()
 	{
-		return s_VertexArena.GetBufferHandle();
+		return GetVertexArena().GetBufferHandle();
+	}
+
+	BufferHandle GeometryPool::GetIndexBufferHandle(EIndexType indexType)
+	{
+		return GetIndexArena(indexType).GetBufferHandle();
+	}
+
+	BufferHandle GeometryPool::GetBoundsBufferHandle()
+	{
+		return s_BoundsArena.GetBufferHandle();
 	}
 
-	BufferHandle GeometryPool::GetIndexBufferHandle()
+	BufferHandle GeometryPool::GetMeshletBufferHandle()
 	{
-		return s_IndexArena.GetBufferHandle();
+		return s_MeshletArena.GetBufferHandle();
+	}
+
+	BufferHandle GeometryPool::GetLodBufferHandle()
+	{
+		return s_LodArena.GetBufferHandle();
+	}
+
+	BufferArena& GeometryPool::GetVertexArena()
+	{
+		return s_VertexFormat == EVertexFormat::PACKED ? s_PackedVertexArena : s_VertexArena;
+	}
+
+	BufferArena& GeometryPool::GetIndexArena(EIndexType indexType)
+	{
+		return indexType == EIndexType::UINT16 ? s_Index16Arena : s_IndexArena;
+	}
+
+	bool GeometryPool::IsFragmented(const BufferArena& arena)
+	{
+		return arena.GetFreeCount() > static_cast<uint32>(arena.GetEnd() * MIN_COMPACTION_FREE_RATIO);
+	}
+
+	bool GeometryPool::CompactArena(BufferArena& arena, std::vector<BufferRange*>& ranges, uint64& budgetBytes)
+	{
+		if (!IsFragmented(arena))
+			return false;
+
+		// Highest first - every move lets the end of the arena move down
+		std::sort(ranges.begin(), ranges.end(), [](const BufferRange* pA, const BufferRange* pB) { return pA->ElementOffset > pB->ElementOffset; });
+
+		bool moved = false;
+		for (BufferRange* pRange : ranges)
+		{
+			// A mesh bigger than the whole budget would otherwise never move, holding up every mesh below it - it
+			// gets a frame to itself instead. Anything else over what's left waits, but smaller ones can still fit.
+			const uint64 bytes     = static_cast<uint64>(pRange->ElementCount) * arena.GetElementStride();
+			const bool   untouched = budgetBytes == COMPACTION_BYTES_PER_FRAME;
+			if (bytes > budgetBytes && !untouched)
+				continue;
+
+			if (arena.Relocate(*pRange))
+			{
+				budgetBytes -= std::min(bytes, budgetBytes);
+				moved = true;
+			}
+		}
+
+		return moved;
 	}
 } // namespace Poly
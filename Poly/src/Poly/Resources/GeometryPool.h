@@ -3,42 +3,171 @@
 #include "Poly/Model/Mesh.h"
 #include "Poly/RenderGraph/BufferArena.h"
 
+#include <span>
 #include <vector>
 
 namespace Poly
 {
 	/*
 	 * Owns the engine-wide shared vertex and index buffers that all loaded meshes' geometry is
-	 * appended into at load time, instead of each Mesh owning its own standalone buffer. Meshes
-	 * are never unloaded today, so both underlying arenas only ever grow.
+	 * placed in at load time, instead of each Mesh owning its own standalone buffer, plus one
+	 * MeshBounds entry per mesh and its MeshLods and Meshlets for GPU culling. Meshes are referred to by
+	 * GeometryHandle - FreeMesh() gives their ranges back to the arenas, for the next uploads to reuse.
+	 *
+	 * Reuse leaves holes, so Update() compacts the vertex and index arenas in the background: every frame it
+	 * moves up to COMPACTION_BYTES_PER_FRAME of the highest meshes (or one mesh bigger than that on its own) down
+	 * into holes with GPU copies, while frames in flight keep reading the old copy. Moved meshes get a new
+	 * MeshRange and GetGeneration() changes, which is how users of MeshRange offsets (SceneRenderBridge's draw
+	 * commands) know to re-read them. Only the vertex and index arenas are compacted - bounds, LODs and meshlets
+	 * are small, and referenced by absolute index from each other and from instance data.
+	 *
+	 * Vertices are stored in one of two formats, each in its own arena - shaders read them through LoadVertex() in
+	 * common/bindless.glsl, which gets the format from GPUCullParams::VertexFormat. The vertex and index arenas are
+	 * paged (VERTEX_PAGE_SIZE_LOG2, INDEX_PAGE_SIZE_LOG2), so loading more geometry adds a page rather than copying
+	 * everything into a bigger buffer - GetVertexBufferHandle() and GetIndexBufferHandle() are the page tables
+	 * LoadVertex() and LoadIndex() look elements up through.
+	 *
+	 * Indices of meshes with fewer than MAX_INDEX16_VERTEX_COUNT + 1 vertices go to a separate 16-bit index arena,
+	 * halving their size - MeshRange::IndexType says which buffer a mesh's indices are in, and
+	 * GPUInstanceData::FLAG_INDEX16 tells the shaders.
 	 */
 	class GeometryPool
 	{
 	public:
 		CLASS_STATIC(GeometryPool);
 
+		enum class EVertexFormat : uint32
+		{
+			FULL   = 0, // Vertex, 64 bytes
+			PACKED = 1  // PackedVertex, 24 bytes
+		};
+
+		// Largest vertex count stored with 16-bit indices - one short of the full range, so 0xFFFF stays free as the
+		// primitive restart index
+		static constexpr uint32 MAX_INDEX16_VERTEX_COUNT = 0xFFFF;
+
+		// Vertices per page of the vertex arenas - 16 MB of Vertex, 6 MB of PackedVertex. Must match
+		// VERTEX_PAGE_SIZE_LOG2 in common/bindless.glsl.
+		static constexpr uint32 VERTEX_PAGE_SIZE_LOG2 = 18;
+
+		// Indices per page of the index arenas - 4 MB of 32-bit, 2 MB of 16-bit indices. Must match INDEX_PAGE_SIZE_LOG2
+		// in common/bindless.glsl.
+		static constexpr uint32 INDEX_PAGE_SIZE_LOG2 = 20;
+
+		static constexpr uint64 COMPACTION_BYTES_PER_FRAME = 4 * 1024 * 1024;
+		static constexpr float  MIN_COMPACTION_FREE_RATIO  = 0.125f; // of an arena's used range, in holes, before it's compacted
+
 		static void Init();
 		static void Release();
 
+		// Retires frees and compacts a bit - call once per frame, before ResourceManager::Update()
+		static void Update();
+
 		/*
-		 * Appends a mesh's vertex/index data to the shared buffers, growing them if needed.
-		 * @param vertices - CPU-side vertex data
-		 * @param indices - CPU-side index data
-		 * @return MeshRange - where the data landed in the shared vertex/index buffers
+		 * Selects the format every following UploadMesh() stores vertices in. Can only be changed while no mesh
+		 * has been uploaded, since existing MeshRanges point into the current format's arena.
+		 * @param format - vertex format to store
 		 */
-		static MeshRange UploadMesh(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices);
+		static void          SetVertexFormat(EVertexFormat format);
+		static EVertexFormat GetVertexFormat() { return s_VertexFormat; }
 
-		static BufferHandle GetVertexBufferHandle();
-		static BufferHandle GetIndexBufferHandle();
+		/*
+		 * Appends a mesh's vertex data, levels of detail and bounds to the shared buffers, growing them if needed.
+		 * Takes the levels of detail (see MeshOptimizer::BuildLods()) flattened the way they're stored, which is
+		 * how CookedModel keeps them - FlattenLods() gets there from MeshLodData.
+		 * @param vertices - CPU-side vertex data, packed on the way if the vertex format is PACKED
+		 * @param indices - all levels' indices back to back, finest first - narrowed to 16 bits on the way if there
+		 *                  are few enough vertices
+		 * @param meshlets - all levels' meshlets back to back, FirstIndex relative to indices
+		 * @param lods - the levels, FirstMeshlet relative to meshlets
+		 * @param bounds - object-space bounds of the vertices, the LOD range is filled in here
+		 * @return GeometryHandle - handle to where the data landed in the shared vertex/index/bounds/meshlet/LOD buffers
+		 */
+		static GeometryHandle UploadMesh(std::span<const Vertex> vertices, std::span<const uint32> indices, std::span<const Meshlet> meshlets,
+		                                 std::span<const MeshLod> lods, const MeshBounds& bounds);
+
+		/*
+		 * Puts levels of detail into the layout UploadMesh() takes
+		 * @param lods - levels from MeshOptimizer::BuildLods()
+		 * @param indices - receives all levels' indices back to back
+		 * @param meshlets - receives all levels' meshlets back to back, rebased onto indices
+		 * @param gpuLods - receives the levels, FirstMeshlet relative to meshlets
+		 */
+		static void FlattenLods(const std::vector<MeshLodData>& lods, std::vector<uint32>& indices, std::vector<Meshlet>& meshlets, std::vector<MeshLod>& gpuLods);
+
+		/*
+		 * Frees a mesh's geometry - its ranges are reused once frames in flight are done with them. Stale
+		 * handles are ignored, e.g. meshes outliving Release().
+		 * @param handle - handle from UploadMesh()
+		 */
+		static void FreeMesh(GeometryHandle handle);
+
+		/*
+		 * Gets where a mesh's geometry currently is
+		 * @param handle - handle from UploadMesh()
+		 * @return MeshRange - current ranges, empty for a stale handle
+		 */
+		static const MeshRange& GetMeshRange(GeometryHandle handle);
+
+		// Changes whenever compaction moves a mesh
+		static uint32 GetGeneration() { return s_Generation; }
+
+		static BufferHandle GetVertexBufferHandle(); // page table of the current vertex format
+		static BufferHandle GetIndexBufferHandle(EIndexType indexType); // page table
+		static BufferHandle GetBoundsBufferHandle();
+		static BufferHandle GetMeshletBufferHandle();
+		static BufferHandle GetLodBufferHandle();
 
 	private:
+		struct MeshSlot
+		{
+			MeshRange Range;
+			uint32    Generation = 0;
+			bool      Alive      = false;
+		};
+
+		static BufferArena& GetVertexArena();
+		static BufferArena& GetIndexArena(EIndexType indexType);
+		static bool         IsFragmented(const BufferArena& arena);
+		static bool         CompactArena(BufferArena& arena, std::vector<BufferRange*>& ranges, uint64& budgetBytes);
+
 		inline static BufferArena s_VertexArena{sizeof(Vertex),
 		                                        FBufferUsage::TRANSFER_SRC | FBufferUsage::STORAGE_BUFFER | FBufferUsage::SHADER_DEVICE_ADDRESS,
 		                                        EMemoryUsage::GPU_ONLY,
-		                                        "GeometryPool.Vertices"};
+		                                        "GeometryPool.Vertices",
+		                                        VERTEX_PAGE_SIZE_LOG2};
+		inline static BufferArena s_PackedVertexArena{sizeof(PackedVertex),
+		                                              FBufferUsage::TRANSFER_SRC | FBufferUsage::STORAGE_BUFFER | FBufferUsage::SHADER_DEVICE_ADDRESS,
+		                                              EMemoryUsage::GPU_ONLY,
+		                                              "GeometryPool.PackedVertices",
+		                                              VERTEX_PAGE_SIZE_LOG2};
 		inline static BufferArena s_IndexArena{sizeof(uint32),
-		                                       FBufferUsage::TRANSFER_SRC | FBufferUsage::INDEX_BUFFER | FBufferUsage::SHADER_DEVICE_ADDRESS,
+		                                       FBufferUsage::TRANSFER_SRC | FBufferUsage::STORAGE_BUFFER | FBufferUsage::SHADER_DEVICE_ADDRESS,
 		                                       EMemoryUsage::GPU_ONLY,
-		                                       "GeometryPool.Indices"};
+		                                       "GeometryPool.Indices",
+		                                       INDEX_PAGE_SIZE_LOG2};
+		inline static BufferArena s_Index16Arena{sizeof(uint16),
+		                                         FBufferUsage::TRANSFER_SRC | FBufferUsage::STORAGE_BUFFER | FBufferUsage::SHADER_DEVICE_ADDRESS,
+		                                         EMemoryUsage::GPU_ONLY,
+		                                         "GeometryPool.Indices16",
+		                                         INDEX_PAGE_SIZE_LOG2};
+		inline static BufferArena s_BoundsArena{sizeof(MeshBounds),
+		                                        FBufferUsage::TRANSFER_SRC | FBufferUsage::STORAGE_BUFFER | FBufferUsage::SHADER_DEVICE_ADDRESS,
+		                                        EMemoryUsage::GPU_ONLY,
+		                                        "GeometryPool.Bounds"};
+		inline static BufferArena s_MeshletArena{sizeof(Meshlet),
+		                                         FBufferUsage::TRANSFER_SRC | FBufferUsage::STORAGE_BUFFER | FBufferUsage::SHADER_DEVICE_ADDRESS,
+		                                         EMemoryUsage::GPU_ONLY,
+		                                         "GeometryPool.Meshlets"};
+		inline static BufferArena s_LodArena{sizeof(MeshLod),
+		                                     FBufferUsage::TRANSFER_SRC | FBufferUsage::STORAGE_BUFFER | FBufferUsage::SHADER_DEVICE_ADDRESS,
+		                                     EMemoryUsage::GPU_ONLY,
+		                                     "GeometryPool.Lods"};
+
+		inline static EVertexFormat s_VertexFormat = EVertexFormat::FULL;
+
+		inline static std::vector<MeshSlot> s_Meshes;
+		inline static std::vector<uint32>   s_FreeMeshSlots;
+		inline static uint32                s_Generation = 0;
 	};
 } // namespace Poly
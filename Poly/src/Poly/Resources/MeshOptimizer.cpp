@@ -0,0 +1,762 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+	constexpr uint32 INVALID_INDEX = UINT32_MAX;
+
+	// Forsyth's scoring - the three most recent vertices get a flat score so the next triangle doesn't just
+	// strip along, older ones fall off with cache age, and vertices with few triangles left get a boost so
+	// they are finished off instead of leaving lone triangles behind. Tabulated, it's evaluated for every
+	// cached vertex after every triangle.
+	struct VertexScoreTable
+	{
+		static constexpr uint32 MAX_VALENCE = 64;
+
+		float Cache[Poly::MeshOptimizer::VERTEX_CACHE_SIZE + 1]; // by cache position + 1, [0] = not cached
+		float Valence[MAX_VALENCE];                              // by remaining triangles
+
+		VertexScoreTable()
+		{
+			constexpr float cacheDecayRange = static_cast<float>(Poly::MeshOptimizer::VERTEX_CACHE_SIZE - 3);
+
+			Cache[0] = 0.0f;
+			for (uint32 position = 0; position < Poly::MeshOptimizer::VERTEX_CACHE_SIZE; position++)
+				Cache[position + 1] = position < 3 ? 0.75f : std::pow(1.0f - static_cast<float>(position - 3) / cacheDecayRange, 1.5f);
+
+			Valence[0] = 0.0f;
+			for (uint32 remaining = 1; remaining < MAX_VALENCE; remaining++)
+				Valence[remaining] = 2.0f / std::sqrt(static_cast<float>(remaining));
+		}
+	};
+
+	float VertexScore(int32_t cachePosition, uint32 remainingTriangles)
+	{
+		static const VertexScoreTable s_Table;
+
+		if (remainingTriangles == 0)
+			return -1.0f;
+
+		const float valence = remainingTriangles < VertexScoreTable::MAX_VALENCE ? s_Table.Valence[remainingTriangles] : 2.0f / std::sqrt(static_cast<float>(remainingTriangles));
+		return s_Table.Cache[cachePosition + 1] + valence;
+	}
+
+	// Runs a FIFO post-transform cache over the triangle list and reports each triangle's misses (0 - 3)
+	template<typename Fn>
+	void SimulateVertexCache(const std::vector<uint32>& indices, uint32 vertexCount, Fn onTriangle)
+	{
+		constexpr uint32 cacheSize = Poly::MeshOptimizer::VERTEX_CACHE_SIZE;
+
+		// A vertex is cached while fewer than cacheSize misses happened since its own - starting the clock at
+		// cacheSize keeps the zero-initialized timestamps from counting as hits
+		std::vector<uint32> timestamps(vertexCount, 0);
+		uint32              time = cacheSize + 1;
+
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			uint32 misses = 0;
+			for (size_t corner = 0; corner < 3; corner++)
+			{
+				const uint32 vertex = indices[i + corner];
+				if (time - timestamps[vertex] > cacheSize)
+				{
+					timestamps[vertex] = time++;
+					misses++;
+				}
+			}
+
+			onTriangle(static_cast<uint32>(i / 3), misses);
+		}
+	}
+
+	/*
+	 * Sum of squared distances to a set of planes, weighted by the area of the triangles they came from -
+	 * p^T A p + 2 b.p + c. In doubles, since meshes far from their origin square large coordinates.
+	 */
+	struct Quadric
+	{
+		double A00 = 0.0, A11 = 0.0, A22 = 0.0, A01 = 0.0, A02 = 0.0, A12 = 0.0;
+		double B0 = 0.0, B1 = 0.0, B2 = 0.0;
+		double C      = 0.0;
+		double Weight = 0.0;
+
+		static Quadric FromTriangle(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2)
+		{
+			Quadric         quadric;
+			const glm::vec3 cross  = glm::cross(p1 - p0, p2 - p0);
+			const double    length = glm::length(cross);
+			if (length == 0.0)
+				return quadric;
+
+			const double area = length * 0.5;
+			const double nx   = cross.x / length;
+			const double ny   = cross.y / length;
+			const double nz   = cross.z / length;
+			const double d    = -(nx * p0.x + ny * p0.y + nz * p0.z);
+
+			quadric.A00    = area * nx * nx;
+			quadric.A11    = area * ny * ny;
+			quadric.A22    = area * nz * nz;
+			quadric.A01    = area * nx * ny;
+			quadric.A02    = area * nx * nz;
+			quadric.A12    = area * ny * nz;
+			quadric.B0     = area * nx * d;
+			quadric.B1     = area * ny * d;
+			quadric.B2     = area * nz * d;
+			quadric.C      = area * d * d;
+			quadric.Weight = area;
+			return quadric;
+		}
+
+		Quadric& operator+=(const Quadric& other)
+		{
+			A00 += other.A00;
+			A11 += other.A11;
+			A22 += other.A22;
+			A01 += other.A01;
+			A02 += other.A02;
+			A12 += other.A12;
+			B0 += other.B0;
+			B1 += other.B1;
+			B2 += other.B2;
+			C += other.C;
+			Weight += other.Weight;
+			return *this;
+		}
+
+		// Area-weighted mean squared distance of p to the planes
+		double Evaluate(const glm::vec3& p) const
+		{
+			const double x = p.x, y = p.y, z = p.z;
+			const double error = A00 * x * x + A11 * y * y + A22 * z * z + 2.0 * (A01 * x * y + A02 * x * z + A12 * y * z)
+			                     + 2.0 * (B0 * x + B1 * y + B2 * z) + C;
+			return Weight > 0.0 ? std::max(error, 0.0) / Weight : 0.0;
+		}
+	};
+
+	// Bounding sphere and normal cone of the triangles [firstTriangle, endTriangle)
+	Poly::Meshlet ComputeMeshlet(const std::vector<Poly::Vertex>& vertices, const std::vector<uint32>& indices, uint32 firstTriangle,
+	                             uint32 endTriangle)
+	{
+		Poly::Meshlet meshlet = {};
+		meshlet.FirstIndex    = firstTriangle * 3;
+		meshlet.IndexCount    = (endTriangle - firstTriangle) * 3;
+
+		glm::vec3 boundsMin = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+		glm::vec3 normalSum = glm::vec3(0.0f);
+		for (uint32 i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.IndexCount; i += 3)
+		{
+			const glm::vec3 p0 = vertices[indices[i + 0]].Position;
+			const glm::vec3 p1 = vertices[indices[i + 1]].Position;
+			const glm::vec3 p2 = vertices[indices[i + 2]].Position;
+
+			boundsMin = glm::min(boundsMin, glm::min(p0, glm::min(p1, p2)));
+			boundsMax = glm::max(boundsMax, glm::max(p0, glm::max(p1, p2)));
+
+			const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+			const float     length = glm::length(normal);
+			if (length > 0.0f)
+				normalSum += normal / length;
+		}
+
+		const glm::vec3 center   = (boundsMin + boundsMax) * 0.5f;
+		float           radiusSq = 0.0f;
+		for (uint32 i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.IndexCount; i++)
+		{
+			const glm::vec3 offset = glm::vec3(vertices[indices[i]].Position) - center;
+			radiusSq               = std::max(radiusSq, glm::dot(offset, offset));
+		}
+		meshlet.Sphere = glm::vec4(center, std::sqrt(radiusSq));
+
+		// Cone around the average normal, as wide as the normal farthest from it. Nearly flat-out spreads (a corner,
+		// or a thin strip wrapping around) can't be backface culled from anywhere worth testing - those get the
+		// never-culled sine of 1.
+		const float sumLength = glm::length(normalSum);
+		if (sumLength == 0.0f)
+		{
+			meshlet.Cone = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+			return meshlet;
+		}
+
+		const glm::vec3 axis      = normalSum / sumLength;
+		float           minCosine = 1.0f;
+		for (uint32 i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.IndexCount; i += 3)
+		{
+			const glm::vec3 p0     = vertices[indices[i + 0]].Position;
+			const glm::vec3 normal = glm::cross(glm::vec3(vertices[indices[i + 1]].Position) - p0, glm::vec3(vertices[indices[i + 2]].Position) - p0);
+			const float     length = glm::length(normal);
+			if (length > 0.0f)
+				minCosine = std::min(minCosine, glm::dot(normal / length, axis));
+		}
+
+		meshlet.Cone = glm::vec4(axis, minCosine <= 0.1f ? 1.0f : std::sqrt(1.0f - minCosine * minCosine));
+		return meshlet;
+	}
+} // namespace
+
+namespace Poly
+{
+	void MeshOptimizer::Optimize(std::vector<Vertex>& vertices, std::vector<uint32>& indices)
+	{
+		if (indices.size() < 3 || vertices.empty())
+			return;
+
+		OptimizeVertexCache(indices, static_cast<uint32>(vertices.size()));
+		OptimizeOverdraw(indices, vertices);
+		OptimizeVertexFetch(vertices, indices);
+	}
+
+	void MeshOptimizer::OptimizeVertexCache(std::vector<uint32>& indices, uint32 vertexCount)
+	{
+		const uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+		if (triangleCount == 0)
+			return;
+
+		// Vertex -> triangle adjacency, as one flat list with a range per vertex. A vertex's remaining
+		// triangles are kept at the front of its range, so emitting one is a swap and a decrement.
+		std::vector<uint32> remaining(vertexCount, 0);
+		for (uint32 i = 0; i < triangleCount * 3; i++)
+			remaining[indices[i]]++;
+
+		std::vector<uint32> adjacencyOffsets(vertexCount + 1, 0);
+		std::partial_sum(remaining.begin(), remaining.end(), adjacencyOffsets.begin() + 1);
+
+		std::vector<uint32> adjacency(triangleCount * 3);
+		{
+			std::vector<uint32> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (uint32 i = 0; i < triangleCount * 3; i++)
+				adjacency[fill[indices[i]]++] = i / 3;
+		}
+
+		std::vector<float> vertexScores(vertexCount);
+		for (uint32 vertex = 0; vertex < vertexCount; vertex++)
+			vertexScores[vertex] = VertexScore(-1, remaining[vertex]);
+
+		std::vector<float> triangleScores(triangleCount);
+		std::vector<uint8> emitted(triangleCount, 0);
+		for (uint32 triangle = 0; triangle < triangleCount; triangle++)
+		{
+			const uint32* pCorners   = &indices[triangle * 3];
+			triangleScores[triangle] = vertexScores[pCorners[0]] + vertexScores[pCorners[1]] + vertexScores[pCorners[2]];
+		}
+
+		// Room for the emitted triangle's vertices on top of a full cache, before the oldest ones are pushed out
+		uint32 cache[VERTEX_CACHE_SIZE + 3];
+		uint32 newCache[VERTEX_CACHE_SIZE + 3];
+		uint32 cacheCount = 0;
+
+		std::vector<uint32> output(triangleCount * 3);
+		uint32              bestTriangle = static_cast<uint32>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+		uint32              inputCursor  = 0;
+
+		for (uint32 outputTriangle = 0; outputTriangle < triangleCount; outputTriangle++)
+		{
+			// Nothing connected to the cache is left - continue with the next triangle in input order
+			if (bestTriangle == INVALID_INDEX)
+			{
+				while (emitted[inputCursor])
+					inputCursor++;
+				bestTriangle = inputCursor;
+			}
+
+			const uint32 corners[3] = {indices[bestTriangle * 3 + 0], indices[bestTriangle * 3 + 1], indices[bestTriangle * 3 + 2]};
+			std::copy(corners, corners + 3, &output[outputTriangle * 3]);
+			emitted[bestTriangle] = 1;
+
+			// The emitted vertices move to the front, everything else keeps its order behind them
+			uint32 newCacheCount = 0;
+			for (uint32 corner : corners)
+			{
+				if (std::find(newCache, newCache + newCacheCount, corner) == newCache + newCacheCount) // degenerate triangles
+					newCache[newCacheCount++] = corner;
+			}
+			for (uint32 i = 0; i < cacheCount; i++)
+			{
+				const uint32 vertex = cache[i];
+				if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2])
+					newCache[newCacheCount++] = vertex;
+			}
+
+			for (uint32 corner : corners)
+			{
+				const uint32 first = adjacencyOffsets[corner];
+				const uint32 last  = first + remaining[corner];
+				for (uint32 i = first; i < last; i++)
+				{
+					if (adjacency[i] == bestTriangle)
+					{
+						std::swap(adjacency[i], adjacency[last - 1]);
+						remaining[corner]--;
+						break;
+					}
+				}
+			}
+
+			// Rescore everything that was in the cache - vertices pushed out of it drop back to no cache score
+			for (uint32 i = 0; i < newCacheCount; i++)
+			{
+				const uint32  vertex   = newCache[i];
+				const int32_t position = i < VERTEX_CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+				const float   score    = VertexScore(position, remaining[vertex]);
+				const float   delta    = score - vertexScores[vertex];
+				vertexScores[vertex]   = score;
+
+				const uint32 first = adjacencyOffsets[vertex];
+				for (uint32 j = first; j < first + remaining[vertex]; j++)
+					triangleScores[adjacency[j]] += delta;
+			}
+
+			cacheCount = std::min(newCacheCount, VERTEX_CACHE_SIZE);
+			std::copy(newCache, newCache + cacheCount, cache);
+
+			// Only triangles touching the cache can have gained - the rest keep losing to them
+			bestTriangle    = INVALID_INDEX;
+			float bestScore = 0.0f;
+			for (uint32 i = 0; i < cacheCount; i++)
+			{
+				const uint32 vertex = cache[i];
+				const uint32 first  = adjacencyOffsets[vertex];
+				for (uint32 j = first; j < first + remaining[vertex]; j++)
+				{
+					const uint32 triangle = adjacency[j];
+					if (triangleScores[triangle] > bestScore)
+					{
+						bestScore    = triangleScores[triangle];
+						bestTriangle = triangle;
+					}
+				}
+			}
+		}
+
+		std::copy(output.begin(), output.end(), indices.begin());
+	}
+
+	void MeshOptimizer::OptimizeOverdraw(std::vector<uint32>& indices, const std::vector<Vertex>& vertices, float threshold)
+	{
+		const uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+		if (triangleCount == 0)
+			return;
+
+		std::vector<uint32> misses(triangleCount);
+		SimulateVertexCache(indices, static_cast<uint32>(vertices.size()), [&misses](uint32 triangle, uint32 triangleMisses) { misses[triangle] = triangleMisses; });
+
+		// A triangle missing on all three vertices starts from a cold cache anyway, so moving the triangles from
+		// it on elsewhere costs nothing - those are the hard cluster boundaries
+		std::vector<uint32> clusterStarts;
+		for (uint32 triangle = 0; triangle < triangleCount; triangle++)
+		{
+			if (triangle == 0 || misses[triangle] == 3)
+				clusterStarts.push_back(triangle);
+		}
+		clusterStarts.push_back(triangleCount);
+
+		// Hard clusters can be most of the mesh - split them further where the part so far is within threshold of
+		// the whole cluster's efficiency and the next triangle is nearly cold anyway
+		std::vector<uint32> splitStarts;
+		for (size_t cluster = 0; cluster + 1 < clusterStarts.size(); cluster++)
+		{
+			const uint32 first = clusterStarts[cluster];
+			const uint32 end   = clusterStarts[cluster + 1];
+
+			uint32 clusterMisses = 0;
+			for (uint32 triangle = first; triangle < end; triangle++)
+				clusterMisses += misses[triangle];
+			const float maxACMR = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - first);
+
+			uint32 start         = first;
+			uint32 runningMisses = 0;
+			splitStarts.push_back(first);
+			for (uint32 triangle = first; triangle + 1 < end; triangle++)
+			{
+				runningMisses += misses[triangle];
+				if (misses[triangle + 1] >= 2 && static_cast<float>(runningMisses) <= maxACMR * static_cast<float>(triangle + 1 - start))
+				{
+					start         = triangle + 1;
+					runningMisses = 0;
+					splitStarts.push_back(start);
+				}
+			}
+		}
+		splitStarts.push_back(triangleCount);
+
+		// Area weighted centroid and normal per cluster - the normals' lengths are twice the areas
+		const uint32           clusterCount = static_cast<uint32>(splitStarts.size() - 1);
+		std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3(0.0f));
+		std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3(0.0f));
+		glm::vec3              meshCentroid = glm::vec3(0.0f);
+		float                  meshArea     = 0.0f;
+
+		for (uint32 cluster = 0; cluster < clusterCount; cluster++)
+		{
+			float clusterArea = 0.0f;
+			for (uint32 triangle = splitStarts[cluster]; triangle < splitStarts[cluster + 1]; triangle++)
+			{
+				const glm::vec3 p0 = vertices[indices[triangle * 3 + 0]].Position;
+				const glm::vec3 p1 = vertices[indices[triangle * 3 + 1]].Position;
+				const glm::vec3 p2 = vertices[indices[triangle * 3 + 2]].Position;
+
+				const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+				const float     area   = glm::length(normal);
+
+				clusterCentroids[cluster] += (p0 + p1 + p2) * (area / 3.0f);
+				clusterNormals[cluster] += normal;
+				clusterArea += area;
+			}
+
+			meshCentroid += clusterCentroids[cluster];
+			meshArea += clusterArea;
+			clusterCentroids[cluster] = clusterArea > 0.0f ? clusterCentroids[cluster] / clusterArea : vertices[indices[splitStarts[cluster] * 3]].Position;
+		}
+		meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : glm::vec3(0.0f);
+
+		// Clusters far out along their own normal are the ones most likely to cover the rest - draw those first
+		std::vector<float> sortKeys(clusterCount);
+		for (uint32 cluster = 0; cluster < clusterCount; cluster++)
+		{
+			const float normalLength = glm::length(clusterNormals[cluster]);
+			sortKeys[cluster]        = normalLength > 0.0f ? glm::dot(clusterCentroids[cluster] - meshCentroid, clusterNormals[cluster] / normalLength) : 0.0f;
+		}
+
+		std::vector<uint32> clusterOrder(clusterCount);
+		std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+		std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKeys](uint32 a, uint32 b) { return sortKeys[a] > sortKeys[b]; });
+
+		std::vector<uint32> output;
+		output.reserve(triangleCount * 3);
+		for (uint32 cluster : clusterOrder)
+			output.insert(output.end(), indices.begin() + splitStarts[cluster] * 3, indices.begin() + splitStarts[cluster + 1] * 3);
+
+		indices = std::move(output);
+	}
+
+	void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32>& indices)
+	{
+		std::vector<uint32> remap(vertices.size(), INVALID_INDEX);
+		std::vector<Vertex> output;
+		output.reserve(vertices.size());
+
+		for (uint32& index : indices)
+		{
+			if (remap[index] == INVALID_INDEX)
+			{
+				remap[index] = static_cast<uint32>(output.size());
+				output.push_back(vertices[index]);
+			}
+
+			index = remap[index];
+		}
+
+		vertices = std::move(output);
+	}
+
+	std::vector<Meshlet> MeshOptimizer::BuildMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices)
+	{
+		std::vector<Meshlet> meshlets;
+		const uint32         triangleCount = static_cast<uint32>(indices.size() / 3);
+		if (triangleCount == 0)
+			return meshlets;
+
+		// Which meshlet last took each vertex - a vertex is only counted once per meshlet
+		std::vector<uint32> owners(vertices.size(), INVALID_INDEX);
+		uint32              meshletIndex  = 0;
+		uint32              firstTriangle = 0;
+		uint32              vertexCount   = 0;
+
+		for (uint32 triangle = 0; triangle < triangleCount; triangle++)
+		{
+			const uint32 a = indices[triangle * 3 + 0];
+			const uint32 b = indices[triangle * 3 + 1];
+			const uint32 c = indices[triangle * 3 + 2];
+
+			auto countNewVertices = [&]() {
+				return static_cast<uint32>(owners[a] != meshletIndex) + static_cast<uint32>(owners[b] != meshletIndex && b != a)
+				       + static_cast<uint32>(owners[c] != meshletIndex && c != a && c != b);
+			};
+
+			uint32 newVertices = countNewVertices();
+			if (vertexCount + newVertices > MAX_MESHLET_VERTICES || triangle - firstTriangle == MAX_MESHLET_TRIANGLES)
+			{
+				meshlets.push_back(ComputeMeshlet(vertices, indices, firstTriangle, triangle));
+				meshletIndex++;
+				firstTriangle = triangle;
+				vertexCount   = 0;
+				newVertices   = countNewVertices();
+			}
+
+			owners[a] = owners[b] = owners[c] = meshletIndex;
+			vertexCount += newVertices;
+		}
+
+		meshlets.push_back(ComputeMeshlet(vertices, indices, firstTriangle, triangleCount));
+		return meshlets;
+	}
+
+	std::vector<uint32> MeshOptimizer::Simplify(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices, uint32 targetIndexCount,
+	                                            float maxError, float* pResultError)
+	{
+		const uint32        vertexCount = static_cast<uint32>(vertices.size());
+		std::vector<uint32> result      = indices;
+		float               resultError = 0.0f;
+
+		// An edge only one triangle uses is a border - either of the mesh, or of an attribute seam, where the
+		// neighbouring triangle uses a split copy of the vertices. Those vertices are locked, and so are the ones on
+		// edges used by more than two triangles, where collapses would tear the surface.
+		std::vector<uint8> locked(vertexCount, 0);
+		{
+			std::vector<uint64> edges;
+			edges.reserve(result.size());
+			for (size_t i = 0; i + 2 < result.size(); i += 3)
+			{
+				for (uint32 corner = 0; corner < 3; corner++)
+				{
+					const uint64 a = result[i + corner];
+					const uint64 b = result[i + (corner + 1) % 3];
+					edges.push_back(a < b ? (a << 32) | b : (b << 32) | a);
+				}
+			}
+			std::sort(edges.begin(), edges.end());
+
+			for (size_t first = 0; first < edges.size();)
+			{
+				size_t end = first + 1;
+				while (end < edges.size() && edges[end] == edges[first])
+					end++;
+
+				if (end - first != 2)
+				{
+					locked[edges[first] >> 32]         = 1;
+					locked[edges[first] & 0xFFFFFFFFu] = 1;
+				}
+				first = end;
+			}
+		}
+
+		std::vector<Quadric> quadrics(vertexCount);
+		for (size_t i = 0; i + 2 < result.size(); i += 3)
+		{
+			const Quadric quadric = Quadric::FromTriangle(vertices[result[i]].Position, vertices[result[i + 1]].Position, vertices[result[i + 2]].Position);
+			for (uint32 corner = 0; corner < 3; corner++)
+				quadrics[result[i + corner]] += quadric;
+		}
+
+		const double maxErrorSq = static_cast<double>(maxError) * maxError;
+
+		std::vector<uint32> remap(vertexCount);
+		std::vector<uint32> adjacencyOffsets(vertexCount + 1);
+		std::vector<uint32> adjacency;
+		std::vector<double> bestCosts(vertexCount);
+		std::vector<uint32> bestTargets(vertexCount);
+		std::vector<uint32> candidates;
+		std::vector<uint8>  touched(vertexCount);
+		std::vector<float>  vertexErrors(vertexCount, 0.0f); // how far the surface around each vertex has moved so far
+
+		// In passes - each one collapses a set of edges that don't share a neighbourhood, cheapest first, so
+		// every collapse is checked against the mesh as it is
+		while (result.size() > targetIndexCount)
+		{
+			const uint32 triangleCount = static_cast<uint32>(result.size() / 3);
+
+			std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+			for (uint32 index : result)
+				adjacencyOffsets[index + 1]++;
+			std::partial_sum(adjacencyOffsets.begin(), adjacencyOffsets.end(), adjacencyOffsets.begin());
+
+			adjacency.resize(result.size());
+			{
+				std::vector<uint32> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+				for (uint32 i = 0; i < static_cast<uint32>(result.size()); i++)
+					adjacency[fill[result[i]]++] = i / 3;
+			}
+
+			// Cheapest collapse out of every unlocked vertex - into one of its neighbours, which keeps its position
+			std::fill(bestCosts.begin(), bestCosts.end(), std::numeric_limits<double>::max());
+			for (uint32 triangle = 0; triangle < triangleCount; triangle++)
+			{
+				for (uint32 corner = 0; corner < 3; corner++)
+				{
+					const uint32 from = result[triangle * 3 + corner];
+					if (locked[from])
+						continue;
+
+					for (uint32 other = 1; other < 3; other++)
+					{
+						const uint32 to     = result[triangle * 3 + (corner + other) % 3];
+						Quadric      merged = quadrics[from];
+						merged += quadrics[to];
+
+						const double cost = merged.Evaluate(vertices[to].Position);
+						if (cost < bestCosts[from])
+						{
+							bestCosts[from]   = cost;
+							bestTargets[from] = to;
+						}
+					}
+				}
+			}
+
+			// The quadric cost is a mean over the planes, so it only rules collapses out - the distance they move the
+			// surface by is measured below
+			candidates.clear();
+			for (uint32 vertex = 0; vertex < vertexCount; vertex++)
+			{
+				if (bestCosts[vertex] <= maxErrorSq)
+					candidates.push_back(vertex);
+			}
+			std::sort(candidates.begin(), candidates.end(), [&bestCosts](uint32 a, uint32 b) { return bestCosts[a] < bestCosts[b]; });
+
+			std::iota(remap.begin(), remap.end(), 0);
+			std::fill(touched.begin(), touched.end(), 0);
+
+			// Every collapse removes the two triangles sharing the edge
+			uint32 remainingTriangles = triangleCount;
+			uint32 collapses          = 0;
+			for (uint32 from : candidates)
+			{
+				if (remainingTriangles * 3 <= targetIndexCount)
+					break;
+
+				const uint32 to = bestTargets[from];
+				if (touched[from] || touched[to])
+					continue;
+
+				// Reject collapses that would turn a triangle around from, and measure how far the rest move - the
+				// target from the triangles' planes before, and the vertex from them after
+				const glm::vec3 source   = vertices[from].Position;
+				const glm::vec3 target   = vertices[to].Position;
+				const uint32    adjFirst = adjacencyOffsets[from];
+				const uint32    adjEnd   = adjacencyOffsets[from + 1];
+				bool            flips    = false;
+				float           moved    = 0.0f;
+				float           fanError = 0.0f;
+				for (uint32 i = adjFirst; i < adjEnd && !flips; i++)
+				{
+					const uint32* pCorners = &result[adjacency[i] * 3];
+					fanError               = std::max({fanError, vertexErrors[pCorners[0]], vertexErrors[pCorners[1]], vertexErrors[pCorners[2]]});
+					if (pCorners[0] == to || pCorners[1] == to || pCorners[2] == to)
+						continue;
+
+					glm::vec3       p[3]   = {vertices[pCorners[0]].Position, vertices[pCorners[1]].Position, vertices[pCorners[2]].Position};
+					const glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+					for (uint32 corner = 0; corner < 3; corner++)
+					{
+						if (pCorners[corner] == from)
+							p[corner] = target;
+					}
+					const glm::vec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+
+					const float beforeLength = glm::length(before);
+					const float afterLength  = glm::length(after);
+					flips                    = glm::dot(before, after) <= 0.25f * beforeLength * afterLength;
+					if (beforeLength > 0.0f)
+						moved = std::max(moved, std::abs(glm::dot(before, target - source)) / beforeLength);
+					if (afterLength > 0.0f)
+						moved = std::max(moved, std::abs(glm::dot(after, source - target)) / afterLength);
+				}
+
+				// Earlier collapses this call already moved the fan's surface, the new move comes on top of that
+				const float collapseError = fanError + moved;
+				if (flips || collapseError > maxError)
+					continue;
+
+				remap[from] = to;
+				quadrics[to] += quadrics[from];
+				resultError = std::max(resultError, collapseError);
+				collapses++;
+
+				// The whole neighbourhood sits out the rest of the pass, its costs and flip checks are stale now
+				for (uint32 i = adjFirst; i < adjEnd; i++)
+				{
+					const uint32* pCorners = &result[adjacency[i] * 3];
+					touched[pCorners[0]] = touched[pCorners[1]] = touched[pCorners[2]] = 1;
+					for (uint32 corner = 0; corner < 3; corner++)
+						vertexErrors[pCorners[corner]] = std::max(vertexErrors[pCorners[corner]], collapseError);
+					if (pCorners[0] == to || pCorners[1] == to || pCorners[2] == to)
+						remainingTriangles--;
+				}
+			}
+
+			if (collapses == 0)
+				break;
+
+			// Apply the pass, dropping the triangles that collapsed to edges
+			size_t writeIndex = 0;
+			for (size_t i = 0; i + 2 < result.size(); i += 3)
+			{
+				const uint32 a = remap[result[i + 0]];
+				const uint32 b = remap[result[i + 1]];
+				const uint32 c = remap[result[i + 2]];
+				if (a == b || b == c || a == c)
+					continue;
+
+				result[writeIndex++] = a;
+				result[writeIndex++] = b;
+				result[writeIndex++] = c;
+			}
+			result.resize(writeIndex);
+		}
+
+		if (pResultError)
+			*pResultError = resultError;
+
+		return result;
+	}
+
+	std::vector<MeshLodData> MeshOptimizer::BuildLods(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices)
+	{
+		std::vector<MeshLodData> lods(1);
+		lods[0].Indices  = indices;
+		lods[0].Meshlets = BuildMeshlets(vertices, indices);
+
+		// Error budget per level, relative to the mesh's size
+		glm::vec3 boundsMin = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+		for (uint32 index : indices)
+		{
+			boundsMin = glm::min(boundsMin, glm::vec3(vertices[index].Position));
+			boundsMax = glm::max(boundsMax, glm::vec3(vertices[index].Position));
+		}
+		const float maxError = indices.empty() ? 0.0f : glm::length(boundsMax - boundsMin) * 0.5f * MAX_LOD_ERROR;
+
+		while (lods.size() < MAX_LOD_COUNT)
+		{
+			const std::vector<uint32>& previous = lods.back().Indices;
+			if (previous.size() / 3 <= MIN_LOD_TRIANGLES)
+				break;
+
+			float               error      = 0.0f;
+			const uint32        target     = static_cast<uint32>(previous.size() / 6) * 3;
+			std::vector<uint32> simplified = Simplify(vertices, previous, target, maxError, &error);
+
+			// Mostly locked (seams, borders) or already as coarse as the error budget allows - a level this close to
+			// the previous one would only cost memory
+			if (simplified.size() * 4 > previous.size() * 3)
+				break;
+
+			OptimizeVertexCache(simplified, static_cast<uint32>(vertices.size()));
+
+			MeshLodData lod;
+			lod.Error    = lods.back().Error + error; // each level is simplified from the previous one, so errors add up
+			lod.Meshlets = BuildMeshlets(vertices, simplified);
+			lod.Indices  = std::move(simplified);
+			lods.push_back(std::move(lod));
+		}
+
+		return lods;
+	}
+
+	float MeshOptimizer::CalculateACMR(const std::vector<uint32>& indices, uint32 vertexCount)
+	{
+		const uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+		if (triangleCount == 0)
+			return 0.0f;
+
+		uint32 totalMisses = 0;
+		SimulateVertexCache(indices, vertexCount, [&totalMisses](uint32, uint32 misses) { totalMisses += misses; });
+		return static_cast<float>(totalMisses) / static_cast<float>(triangleCount);
+	}
+} // namespace Poly
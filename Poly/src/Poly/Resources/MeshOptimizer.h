@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Poly/Model/Mesh.h"
+
+#include <vector>
+
+namespace Poly
+{
+	/*
+	 * Reorders a triangle list's indices and vertices for the GPU, run by AssetLoader on every imported mesh
+	 * before it goes to GeometryPool. None of the passes add or remove triangles - only their order, and the
+	 * order (and number, unreferenced ones are dropped) of the vertices, changes. Optimize() runs them in the
+	 * order they depend on each other:
+	 *   1. OptimizeVertexCache() - triangles sharing vertices end up close together, so the post-transform
+	 *      cache can reuse the shaded vertices (Forsyth, "Linear-Speed Vertex Cache Optimisation")
+	 *   2. OptimizeOverdraw() - the clusters the first pass produced are sorted so outward-facing ones draw
+	 *      first, which early depth testing can then reject the rest of the mesh against (Sander et al.,
+	 *      "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw")
+	 *   3. OptimizeVertexFetch() - vertices are laid out in the order the indices first reference them, so
+	 *      vertex fetches walk memory mostly linearly
+	 *
+	 * BuildMeshlets() then splits the optimized triangle list into meshlets for cluster culling, and BuildLods()
+	 * derives coarser levels of detail from it with Simplify().
+	 */
+	class MeshOptimizer
+	{
+	public:
+		CLASS_STATIC(MeshOptimizer);
+
+		static constexpr uint32 VERTEX_CACHE_SIZE = 16; // FIFO size the passes model, conservative for current GPUs
+
+		/*
+		 * How much worse than the vertex cache order (in cache misses per triangle) OptimizeOverdraw() may make
+		 * a cluster when splitting it up further - 1.0 keeps the vertex cache order's efficiency
+		 */
+		static constexpr float DEFAULT_OVERDRAW_THRESHOLD = 1.05f;
+
+		static constexpr uint32 MAX_MESHLET_VERTICES  = 64;
+		static constexpr uint32 MAX_MESHLET_TRIANGLES = 124;
+
+		static constexpr uint32 MAX_LOD_COUNT     = 6;
+		static constexpr uint32 MIN_LOD_TRIANGLES = 64;    // no further level is built once one is down to this
+		static constexpr float  MAX_LOD_ERROR     = 0.05f; // of the mesh's bounding radius, per level
+
+		/*
+		 * Runs all passes below
+		 * @param vertices - vertices to reorder, unreferenced ones are removed
+		 * @param indices - triangle list to reorder, remapped to the new vertex order
+		 */
+		static void Optimize(std::vector<Vertex>& vertices, std::vector<uint32>& indices);
+
+		/*
+		 * Reorders triangles for post-transform vertex cache hits
+		 * @param indices - triangle list to reorder
+		 * @param vertexCount - number of vertices the indices reference
+		 */
+		static void OptimizeVertexCache(std::vector<uint32>& indices, uint32 vertexCount);
+
+		/*
+		 * Reorders clusters of a vertex cache optimized triangle list front-to-back, as seen from outside the mesh
+		 * @param indices - triangle list, output of OptimizeVertexCache()
+		 * @param vertices - positions the indices reference
+		 * @param threshold - see DEFAULT_OVERDRAW_THRESHOLD
+		 */
+		static void OptimizeOverdraw(std::vector<uint32>& indices, const std::vector<Vertex>& vertices, float threshold = DEFAULT_OVERDRAW_THRESHOLD);
+
+		/*
+		 * Reorders vertices by first use and remaps the indices to match
+		 * @param vertices - vertices to reorder, unreferenced ones are removed
+		 * @param indices - indices to remap
+		 */
+		static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32>& indices);
+
+		/*
+		 * Splits a triangle list into meshlets of consecutive triangles, each closed as soon as the next triangle
+		 * would take it over MAX_MESHLET_VERTICES or MAX_MESHLET_TRIANGLES. Keeps the index order, so run it after
+		 * Optimize(), whose order already keeps neighbouring triangles together.
+		 * @param vertices - positions the indices reference
+		 * @param indices - triangle list
+		 * @return meshlets in index order, with their bounding spheres and normal cones
+		 */
+		static std::vector<Meshlet> BuildMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices);
+
+		/*
+		 * Collapses edges, cheapest first by quadric error (Garland & Heckbert), until at most targetIndexCount
+		 * indices are left or every remaining collapse would move the surface by more than maxError. How far a
+		 * collapse moves it is measured against the planes of the triangles around the collapsed vertex, and adds
+		 * to how far earlier collapses moved them. Vertices on borders and attribute seams stay where they are, so
+		 * the result still indexes the given vertices.
+		 * @param vertices - positions the indices reference
+		 * @param indices - triangle list to simplify
+		 * @param targetIndexCount - index count to stop at
+		 * @param maxError - largest object-space distance a collapse may move the surface by
+		 * @param pResultError - receives the largest distance any collapse made moved the surface by, can be nullptr
+		 * @return the simplified triangle list
+		 */
+		static std::vector<uint32> Simplify(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices, uint32 targetIndexCount,
+		                                    float maxError, float* pResultError = nullptr);
+
+		/*
+		 * Builds a mesh's LOD chain - level 0 is the mesh itself, every further level Simplify()'s the previous one
+		 * to half its triangles, for as long as that gets anywhere, up to MAX_LOD_COUNT levels. Every level gets its
+		 * own vertex cache order and meshlets.
+		 * @param vertices - the mesh's vertices, shared by all levels
+		 * @param indices - the mesh's triangle list, output of Optimize()
+		 * @return levels from finest to coarsest, with their errors relative to level 0
+		 */
+		static std::vector<MeshLodData> BuildLods(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices);
+
+		/*
+		 * Average cache misses per triangle of a FIFO cache of VERTEX_CACHE_SIZE entries - 0.5 is the best a
+		 * regular grid can get, 3.0 the worst
+		 * @param indices - triangle list
+		 * @param vertexCount - number of vertices the indices reference
+		 */
+		static float CalculateACMR(const std::vector<uint32>& indices, uint32 vertexCount);
+	};
+} // namespace Poly
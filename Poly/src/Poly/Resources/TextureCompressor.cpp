@@ -0,0 +1,292 @@
+#include "TextureCompressor.h"
+
+#include "polypch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+	using namespace Poly;
+
+	// BC7 interpolation weights (out of 64) of the 16 levels of a 4-bit index
+	constexpr uint32 BC7_WEIGHTS_4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+	// Packs fields into a zeroed block, lowest bit first
+	class BlockBitWriter
+	{
+	public:
+		explicit BlockBitWriter(byte* pBlock)
+		    : m_pBlock(pBlock)
+		{}
+
+		void Write(uint32 value, uint32 bitCount)
+		{
+			for (uint32 i = 0; i < bitCount; i++, m_Bit++)
+			{
+				if (value & (1u << i))
+					m_pBlock[m_Bit >> 3] |= static_cast<byte>(1u << (m_Bit & 7));
+			}
+		}
+
+	private:
+		byte*  m_pBlock;
+		uint32 m_Bit = 0;
+	};
+
+	// 7-bit endpoint plus its low bit, chosen for the smallest error over all four channels
+	struct BC7Endpoint
+	{
+		uint32 Value[4] = {};
+		uint32 PBit     = 0;
+
+		uint32 Expand(uint32 channel) const { return (Value[channel] << 1) | PBit; }
+	};
+
+	BC7Endpoint QuantizeBC7Endpoint(const float endpoint[4])
+	{
+		BC7Endpoint best      = {};
+		float       bestError = std::numeric_limits<float>::max();
+		for (uint32 pBit = 0; pBit < 2; pBit++)
+		{
+			BC7Endpoint candidate = {};
+			candidate.PBit        = pBit;
+
+			float error = 0.0f;
+			for (uint32 c = 0; c < 4; c++)
+			{
+				candidate.Value[c] = static_cast<uint32>(std::clamp(std::lround((endpoint[c] - pBit) * 0.5f), 0l, 127l));
+				const float diff   = static_cast<float>(candidate.Expand(c)) - endpoint[c];
+				error += diff * diff;
+			}
+
+			if (error < bestError)
+			{
+				best      = candidate;
+				bestError = error;
+			}
+		}
+
+		return best;
+	}
+} // namespace
+
+namespace Poly
+{
+	std::vector<byte> TextureCompressor::Compress(const byte* pPixels, uint32 width, uint32 height, EFormat format)
+	{
+		POLY_VALIDATE(IsBlockCompressed(format), "TextureCompressor can only compress to block-compressed formats");
+
+		const uint32      blockSize   = GetFormatBlockSize(format);
+		const uint32      blockCountX = (width + 3) / 4;
+		const uint32      blockCountY = (height + 3) / 4;
+		std::vector<byte> blocks(GetFormatImageSize(format, width, height));
+
+		byte texels[16 * 4];
+		for (uint32 blockY = 0; blockY < blockCountY; blockY++)
+		{
+			for (uint32 blockX = 0; blockX < blockCountX; blockX++)
+			{
+				for (uint32 y = 0; y < 4; y++)
+				{
+					for (uint32 x = 0; x < 4; x++)
+					{
+						const uint32 srcX = std::min(blockX * 4 + x, width - 1);
+						const uint32 srcY = std::min(blockY * 4 + y, height - 1);
+						std::memcpy(&texels[(y * 4 + x) * 4], pPixels + (static_cast<size_t>(srcY) * width + srcX) * 4, 4);
+					}
+				}
+
+				byte* pBlock = blocks.data() + (static_cast<size_t>(blockY) * blockCountX + blockX) * blockSize;
+				switch (format)
+				{
+				case EFormat::BC4_UNORM:
+					EncodeBC4Block(texels, 4, pBlock);
+					break;
+				case EFormat::BC5_UNORM:
+					EncodeBC4Block(texels, 4, pBlock);
+					EncodeBC4Block(texels + 1, 4, pBlock + 8);
+					break;
+				case EFormat::BC7_UNORM:
+					EncodeBC7Block(texels, pBlock);
+					break;
+				default:
+					break;
+				}
+			}
+		}
+
+		return blocks;
+	}
+
+	std::vector<byte> TextureCompressor::Downsample(const byte* pPixels, uint32 width, uint32 height)
+	{
+		const uint32      dstWidth  = std::max(width / 2, 1u);
+		const uint32      dstHeight = std::max(height / 2, 1u);
+		std::vector<byte> dst(static_cast<size_t>(dstWidth) * dstHeight * 4);
+
+		for (uint32 y = 0; y < dstHeight; y++)
+		{
+			// A side of 1 has nothing to average with - the clamped texel is the same one
+			const size_t row0 = static_cast<size_t>(std::min(y * 2, height - 1)) * width;
+			const size_t row1 = static_cast<size_t>(std::min(y * 2 + 1, height - 1)) * width;
+			for (uint32 x = 0; x < dstWidth; x++)
+			{
+				const size_t col0 = std::min(x * 2, width - 1);
+				const size_t col1 = std::min(x * 2 + 1, width - 1);
+				for (uint32 c = 0; c < 4; c++)
+				{
+					const uint32 sum = pPixels[(row0 + col0) * 4 + c] + pPixels[(row0 + col1) * 4 + c] + pPixels[(row1 + col0) * 4 + c] + pPixels[(row1 + col1) * 4 + c];
+					dst[(static_cast<size_t>(y) * dstWidth + x) * 4 + c] = static_cast<byte>((sum + 2) / 4);
+				}
+			}
+		}
+
+		return dst;
+	}
+
+	void TextureCompressor::EncodeBC4Block(const byte* pValues, uint32 stride, byte* pBlock)
+	{
+		uint32 minValue = 255;
+		uint32 maxValue = 0;
+		for (uint32 i = 0; i < 16; i++)
+		{
+			minValue = std::min<uint32>(minValue, pValues[i * stride]);
+			maxValue = std::max<uint32>(maxValue, pValues[i * stride]);
+		}
+
+		// The first endpoint being the larger one selects the mode with six levels between them: index 0 is the
+		// first endpoint, 1 the second, and 2-7 step from the first towards the second. Equal endpoints select
+		// the other mode, where index 0 is still the first endpoint.
+		std::memset(pBlock, 0, 8);
+		pBlock[0] = static_cast<byte>(maxValue);
+		pBlock[1] = static_cast<byte>(minValue);
+
+		BlockBitWriter writer(pBlock + 2);
+		const uint32   range = maxValue - minValue;
+		for (uint32 i = 0; i < 16; i++)
+		{
+			uint32 index = 0;
+			if (range > 0)
+			{
+				const uint32 level = ((pValues[i * stride] - minValue) * 7 + range / 2) / range; // 0 - min, 7 - max
+				index              = level == 7 ? 0 : (level == 0 ? 1 : 8 - level);
+			}
+			writer.Write(index, 3);
+		}
+	}
+
+	void TextureCompressor::EncodeBC7Block(const byte* pTexels, byte* pBlock)
+	{
+		float mean[4] = {};
+		for (uint32 i = 0; i < 16; i++)
+		{
+			for (uint32 c = 0; c < 4; c++)
+				mean[c] += pTexels[i * 4 + c] / 16.0f;
+		}
+
+		float covariance[4][4] = {};
+		for (uint32 i = 0; i < 16; i++)
+		{
+			for (uint32 a = 0; a < 4; a++)
+			{
+				for (uint32 b = 0; b < 4; b++)
+					covariance[a][b] += (pTexels[i * 4 + a] - mean[a]) * (pTexels[i * 4 + b] - mean[b]);
+			}
+		}
+
+		// Principal axis by power iteration - a few steps are plenty for a line through 16 texels
+		float axis[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+		for (uint32 iteration = 0; iteration < 8; iteration++)
+		{
+			float next[4] = {};
+			for (uint32 a = 0; a < 4; a++)
+			{
+				for (uint32 b = 0; b < 4; b++)
+					next[a] += covariance[a][b] * axis[b];
+			}
+
+			const float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2] + next[3] * next[3]);
+			if (length < 1e-6f)
+				break; // a flat block, any axis works
+
+			for (uint32 c = 0; c < 4; c++)
+				axis[c] = next[c] / length;
+		}
+
+		// Endpoints at the texels' extent along the axis
+		float minProjection = std::numeric_limits<float>::max();
+		float maxProjection = std::numeric_limits<float>::lowest();
+		for (uint32 i = 0; i < 16; i++)
+		{
+			float projection = 0.0f;
+			for (uint32 c = 0; c < 4; c++)
+				projection += (pTexels[i * 4 + c] - mean[c]) * axis[c];
+
+			minProjection = std::min(minProjection, projection);
+			maxProjection = std::max(maxProjection, projection);
+		}
+
+		float endpoints[2][4];
+		for (uint32 c = 0; c < 4; c++)
+		{
+			endpoints[0][c] = std::clamp(mean[c] + minProjection * axis[c], 0.0f, 255.0f);
+			endpoints[1][c] = std::clamp(mean[c] + maxProjection * axis[c], 0.0f, 255.0f);
+		}
+
+		BC7Endpoint quantized[2] = {QuantizeBC7Endpoint(endpoints[0]), QuantizeBC7Endpoint(endpoints[1])};
+
+		// Each texel picks the closest of the 16 levels between the quantized endpoints
+		uint32 palette[16][4];
+		for (uint32 level = 0; level < 16; level++)
+		{
+			for (uint32 c = 0; c < 4; c++)
+				palette[level][c] = ((64 - BC7_WEIGHTS_4[level]) * quantized[0].Expand(c) + BC7_WEIGHTS_4[level] * quantized[1].Expand(c) + 32) >> 6;
+		}
+
+		uint32 indices[16];
+		for (uint32 i = 0; i < 16; i++)
+		{
+			uint32 bestError = UINT32_MAX;
+			for (uint32 level = 0; level < 16; level++)
+			{
+				uint32 error = 0;
+				for (uint32 c = 0; c < 4; c++)
+				{
+					const int32 diff = static_cast<int32>(palette[level][c]) - pTexels[i * 4 + c];
+					error += diff * diff;
+				}
+
+				if (error < bestError)
+				{
+					bestError  = error;
+					indices[i] = level;
+				}
+			}
+		}
+
+		// The first texel's index is stored without its top bit, so it has to be below 8 - swapping the
+		// endpoints mirrors every index (the weights are symmetric)
+		if (indices[0] >= 8)
+		{
+			std::swap(quantized[0], quantized[1]);
+			for (uint32& index : indices)
+				index = 15 - index;
+		}
+
+		std::memset(pBlock, 0, 16);
+		BlockBitWriter writer(pBlock);
+		writer.Write(1u << 6, 7); // mode 6 - six zeros, then a one
+		for (uint32 c = 0; c < 4; c++)
+		{
+			writer.Write(quantized[0].Value[c], 7);
+			writer.Write(quantized[1].Value[c], 7);
+		}
+		writer.Write(quantized[0].PBit, 1);
+		writer.Write(quantized[1].PBit, 1);
+		for (uint32 i = 0; i < 16; i++)
+			writer.Write(indices[i], i == 0 ? 3 : 4);
+	}
+} // namespace Poly
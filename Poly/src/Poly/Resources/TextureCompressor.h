@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Poly/Rendering/Core/API/GraphicsTypes.h"
+
+#include <vector>
+
+namespace Poly
+{
+	/*
+	 * CPU encoders for the block-compressed texture formats, run by AssetLoader when it cooks a texture. They
+	 * work on 4x4 blocks of RGBA8 texels - blocks on the edge of an image that isn't a multiple of 4 repeat its
+	 * last row/column:
+	 *   - BC4: the R channel, two 8-bit endpoints with six levels between them
+	 *   - BC5: R and G, as two BC4 blocks
+	 *   - BC7: mode 6 only - one RGBA line per block, along the block's principal axis, with 7-bit endpoints
+	 *     (plus a shared low bit each) and 16 levels. Good for smooth albedo, the partitioned modes that
+	 *     would do better on blocks with several distinct colours aren't tried.
+	 */
+	class TextureCompressor
+	{
+	public:
+		CLASS_STATIC(TextureCompressor);
+
+		/*
+		 * Encodes an image
+		 * @param pPixels - width * height RGBA8 texels
+		 * @param width - width of the image
+		 * @param height - height of the image
+		 * @param format - BC4_UNORM, BC5_UNORM or BC7_UNORM
+		 * @return the blocks row by row, GetFormatImageSize() bytes
+		 */
+		static std::vector<byte> Compress(const byte* pPixels, uint32 width, uint32 height, EFormat format);
+
+		/*
+		 * Halves an image with a box filter, for the next mip level
+		 * @param pPixels - width * height RGBA8 texels
+		 * @param width - width of the image
+		 * @param height - height of the image
+		 * @return max(width / 2, 1) * max(height / 2, 1) RGBA8 texels
+		 */
+		static std::vector<byte> Downsample(const byte* pPixels, uint32 width, uint32 height);
+
+		/*
+		 * Encodes one BC4 block
+		 * @param pValues - the 16 values, row by row, stride bytes apart
+		 * @param stride - bytes between two values
+		 * @param pBlock - 8 bytes to write the block to
+		 */
+		static void EncodeBC4Block(const byte* pValues, uint32 stride, byte* pBlock);
+
+		/*
+		 * Encodes one BC7 block
+		 * @param pTexels - the 16 RGBA8 texels, row by row
+		 * @param pBlock - 16 bytes to write the block to
+		 */
+		static void EncodeBC7Block(const byte* pTexels, byte* pBlock);
+	};
+} // namespace Poly
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Poly/Core/Utils/TransformBatch.h"
+
 #include <entt/entt.hpp>
 #include <glm/glm.hpp>
 
@@ -30,10 +32,16 @@ namespace Poly
 
 		glm::mat4 GetTransform() const
 		{
-			return glm::translate(glm::mat4(1.0f), Translation) * glm::toMat4(Orientation) * glm::scale(glm::mat4(1.0f), Scale);
+			return ComposeTransform(Translation, Orientation, Scale);
 		}
 	};
 
+	// Cached parent-relative TransformComponent concatenated down the hierarchy - written by TransformSystem only
+	struct WorldTransformComponent
+	{
+		glm::mat4 World = glm::mat4(1.0f);
+	};
+
 	struct MeshComponent
 	{
 		MeshComponent(Model* pModel, uint32 meshIndex)
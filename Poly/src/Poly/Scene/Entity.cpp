@@ -10,6 +10,10 @@ namespace Poly
 
 		if (parent.m_Entity != entt::null)
 			PlaceInParent(parent, siblingIndex);
+
+		// Links were edited in place - notify observers (TransformSystem) and recompute the world matrix
+		m_pScene->m_Registry.patch<HierarchyComponent>(m_Entity);
+		MarkDirty();
 	}
 
 	void Entity::SetSiblingIndex(uint8 index)
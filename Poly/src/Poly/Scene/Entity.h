@@ -59,6 +59,12 @@ namespace Poly
 			return m_pScene->m_Registry.get<Component>(m_Entity);
 		}
 
+		/*
+		 * Flags the entity as changed (e.g. after editing its TransformComponent), so the next Scene::Update()
+		 * re-uploads its render data.
+		 */
+		void MarkDirty() { m_pScene->m_Registry.emplace_or_replace<DirtyTag>(m_Entity); }
+
 		PolyID GetPolyID() const { return GetComponent<IDComponent>().ID; }
 
 		operator entt::entity() const { return m_Entity; }
@@ -228,6 +228,8 @@ namespace Poly
 		hierarchyComp.First         = entity.GetScene()->GetOrCreateEntityWithID(node["First"].as<uint64>());
 		hierarchyComp.Next          = entity.GetScene()->GetOrCreateEntityWithID(node["Next"].as<uint64>());
 		hierarchyComp.Previous      = entity.GetScene()->GetOrCreateEntityWithID(node["Previous"].as<uint64>());
+
+		entity.GetScene()->m_Registry.patch<HierarchyComponent>(entity);
 	}
 
 	void EntitySerializer::DeserializeMeshComponent(YAML::Node& node, Entity& entity)
@@ -10,6 +10,7 @@ namespace Poly
 	Scene::Scene(const std::string& name)
 	    : m_ResourceGroup("scene")
 	    , m_Name(name)
+	    , m_TransformSystem(m_Registry)
 	{
 		m_ResourceGroup.AddResource(VERTICES_RESOURCE_NAME, false);
 		m_ResourceGroup.AddResource(INSTANCE_RESOURCE_NAME, false);
@@ -32,6 +33,7 @@ namespace Poly
 		entt::entity entity = m_Registry.create();
 
 		m_Registry.emplace<TransformComponent>(entity);
+		m_Registry.emplace<WorldTransformComponent>(entity);
 		m_Registry.emplace<HierarchyComponent>(entity);
 		m_Registry.emplace<IDComponent>(entity, id);
 		m_Registry.emplace<DirtyTag>(entity);
@@ -66,16 +68,20 @@ namespace Poly
 
 	void Scene::Update()
 	{
-		if (m_Registry.storage<DirtyTag>().empty())
-			return;
+		// Tags the descendants of moved entities, so must run before anything reading DirtyTag
+		m_TransformSystem.Update();
 
-		if (m_pRenderScene)
+		const bool hasDirtyEntities = !m_Registry.storage<DirtyTag>().empty();
+
+		if (m_pRenderScene && hasDirtyEntities)
 			m_pRenderScene->Update();
 
+		// Runs every frame - it only touches dirty and removed entities, so is close to free when nothing changed
 		if (m_pSceneRenderBridge)
 			m_pSceneRenderBridge->Update();
 
-		m_Registry.clear<DirtyTag>();
+		if (hasDirtyEntities)
+			m_Registry.clear<DirtyTag>();
 	}
 
 	void Scene::CreateRenderScene(RenderGraphProgram& program)
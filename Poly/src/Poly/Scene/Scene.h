@@ -2,6 +2,7 @@
 
 #include "Poly/Model/Model.h" // TODO: See if this can be removed
 #include "Poly/Rendering/RenderGraph/ResourceGroup.h"
+#include "TransformSystem.h"
 
 #include <entt/entt.hpp>
 
@@ -26,15 +27,25 @@ namespace Poly
 		static constexpr const char* ROUGHNESS_TEX_RESOURCE_NAME = "roughnessTex";
 		static constexpr const char* AO_TEX_RESOURCE_NAME        = "aoTex";
 
-		static constexpr const char* VERTICES_RESOURCE_NAME_2      = "scene.vertices";
-		static constexpr const char* INSTANCE_RESOURCE_NAME_2      = "scene.instances";
-		static constexpr const char* MATERIAL_RESOURCE_NAME_2      = "scene.materials";
-		static constexpr const char* ALBEDO_TEX_RESOURCE_NAME_2    = "scene.albedoTex";
-		static constexpr const char* NORMAL_TEX_RESOURCE_NAME_2    = "scene.normalTex";
-		static constexpr const char* COMBINED_TEX_RESOURCE_NAME_2  = "scene.combinedTex";
-		static constexpr const char* METALLIC_TEX_RESOURCE_NAME_2  = "scene.metallicTex";
-		static constexpr const char* ROUGHNESS_TEX_RESOURCE_NAME_2 = "scene.roughnessTex";
-		static constexpr const char* AO_TEX_RESOURCE_NAME_2        = "scene.aoTex";
+		static constexpr const char* VERTICES_RESOURCE_NAME_2       = "scene.vertices";
+		static constexpr const char* INDICES_RESOURCE_NAME_2        = "scene.indices";
+		static constexpr const char* INDICES16_RESOURCE_NAME_2      = "scene.indices16";
+		static constexpr const char* INSTANCE_RESOURCE_NAME_2       = "scene.instances";
+		static constexpr const char* INSTANCE_DRAWS_RESOURCE_NAME_2 = "scene.instanceDraws";
+		static constexpr const char* MATERIAL_RESOURCE_NAME_2       = "scene.materials";
+		static constexpr const char* DRAW_COMMANDS_RESOURCE_NAME_2  = "scene.drawCommands";
+		static constexpr const char* BATCHES_RESOURCE_NAME_2        = "scene.batches";
+		static constexpr const char* VISIBLE_DRAWS_RESOURCE_NAME_2  = "scene.visibleDraws";
+		static constexpr const char* MESH_BOUNDS_RESOURCE_NAME_2    = "scene.meshBounds";
+		static constexpr const char* MESHLETS_RESOURCE_NAME_2       = "scene.meshlets";
+		static constexpr const char* MESH_LODS_RESOURCE_NAME_2      = "scene.meshLods";
+		static constexpr const char* CULL_PARAMS_RESOURCE_NAME_2    = "scene.cullParams";
+		static constexpr const char* ALBEDO_TEX_RESOURCE_NAME_2     = "scene.albedoTex";
+		static constexpr const char* NORMAL_TEX_RESOURCE_NAME_2     = "scene.normalTex";
+		static constexpr const char* COMBINED_TEX_RESOURCE_NAME_2   = "scene.combinedTex";
+		static constexpr const char* METALLIC_TEX_RESOURCE_NAME_2   = "scene.metallicTex";
+		static constexpr const char* ROUGHNESS_TEX_RESOURCE_NAME_2  = "scene.roughnessTex";
+		static constexpr const char* AO_TEX_RESOURCE_NAME_2         = "scene.aoTex";
 
 		struct DrawData
 		{
@@ -141,6 +152,7 @@ namespace Poly
 		std::string m_Name;
 
 		entt::registry         m_Registry;
+		TransformSystem        m_TransformSystem; // after m_Registry - connects to it
 		ResourceGroup          m_ResourceGroup;
 		Ref<RenderScene>       m_pRenderScene;
 		Ref<SceneRenderBridge> m_pSceneRenderBridge;
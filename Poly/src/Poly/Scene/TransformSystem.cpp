@@ -0,0 +1,261 @@
+#include "TransformSystem.h"
+
+#include "Components.h"
+#include "Poly/Core/ThreadPool.h"
+#include "Poly/Core/Utils/TransformBatch.h"
+
+namespace Poly
+{
+	TransformSystem::TransformSystem(entt::registry& registry)
+	    : m_Registry(registry)
+	{
+		m_Registry.on_construct<HierarchyComponent>().connect<&TransformSystem::OnHierarchyChanged>(this);
+		m_Registry.on_update<HierarchyComponent>().connect<&TransformSystem::OnHierarchyChanged>(this);
+		m_Registry.on_destroy<HierarchyComponent>().connect<&TransformSystem::OnHierarchyChanged>(this);
+
+		// Jobs look components up concurrently - make sure no storage gets created lazily while they do
+		m_Registry.storage<TransformComponent>();
+		m_Registry.storage<WorldTransformComponent>();
+	}
+
+	TransformSystem::~TransformSystem()
+	{
+		m_Registry.on_construct<HierarchyComponent>().disconnect<&TransformSystem::OnHierarchyChanged>(this);
+		m_Registry.on_update<HierarchyComponent>().disconnect<&TransformSystem::OnHierarchyChanged>(this);
+		m_Registry.on_destroy<HierarchyComponent>().disconnect<&TransformSystem::OnHierarchyChanged>(this);
+	}
+
+	void TransformSystem::Update()
+	{
+		if (m_HierarchyDirty)
+		{
+			Rebuild();
+			m_HierarchyDirty = false;
+		}
+
+		if (m_Entities.empty())
+			return;
+
+		// Seed with the entities changed since the last update
+		m_DirtySubtrees.clear();
+		for (entt::entity entity : m_Registry.view<DirtyTag>())
+		{
+			auto it = m_NodeIndices.find(entity);
+			if (it == m_NodeIndices.end())
+				continue;
+
+			const uint32 index = it->second;
+			const uint32 owner = m_SubtreeOf[index];
+			m_Changed[index]   = 1;
+			if (owner != INVALID_INDEX && !m_SubtreeDirty[owner])
+			{
+				m_SubtreeDirty[owner] = 1;
+				m_DirtySubtrees.push_back(owner);
+			}
+		}
+
+		bool spineChanged = false;
+		for (uint32 index : m_SpineNodes)
+		{
+			UpdateNode(index);
+			spineChanged |= m_Changed[index] != 0;
+		}
+
+		// A moved spine node can be the parent of any subtree - let UpdateNode() sort out which ones actually changed
+		if (spineChanged)
+		{
+			m_DirtySubtrees.clear();
+			for (uint32 i = 0; i < static_cast<uint32>(m_Subtrees.size()); i++)
+			{
+				m_SubtreeDirty[i] = 1;
+				m_DirtySubtrees.push_back(i);
+			}
+		}
+
+		ThreadPool::ParallelFor(static_cast<uint32>(m_DirtySubtrees.size()), 1, [this](uint32 i) { UpdateSubtree(m_Subtrees[m_DirtySubtrees[i]]); });
+
+		// Descendants inherited the change - tag them so consumers of WorldTransformComponent re-read them
+		auto flush = [this](uint32 index) {
+			if (!m_Changed[index])
+				return;
+
+			m_Changed[index] = 0;
+			m_Registry.emplace_or_replace<DirtyTag>(m_Entities[index]);
+		};
+
+		for (uint32 index : m_SpineNodes)
+			flush(index);
+
+		for (uint32 subtreeIndex : m_DirtySubtrees)
+		{
+			const Subtree& subtree = m_Subtrees[subtreeIndex];
+			for (uint32 index = subtree.First; index < subtree.End; index++)
+				flush(index);
+			m_SubtreeDirty[subtreeIndex] = 0;
+		}
+	}
+
+	void TransformSystem::OnHierarchyChanged(entt::registry& registry, entt::entity entity)
+	{
+		m_HierarchyDirty = true;
+	}
+
+	void TransformSystem::Rebuild()
+	{
+		m_Entities.clear();
+		m_Parents.clear();
+		m_NodeIndices.clear();
+		m_SpineNodes.clear();
+		m_Subtrees.clear();
+
+		// Group by parent - an entity whose parent is gone (or has no transform) becomes a root
+		std::unordered_map<entt::entity, std::vector<entt::entity>> children;
+		std::vector<entt::entity>                                   roots;
+
+		auto view = m_Registry.view<TransformComponent, WorldTransformComponent>();
+		for (entt::entity entity : view)
+		{
+			const HierarchyComponent* pHierarchy = m_Registry.try_get<HierarchyComponent>(entity);
+			if (!pHierarchy || pHierarchy->Parent == entt::null)
+			{
+				roots.push_back(entity);
+				continue;
+			}
+
+			if (view.contains(pHierarchy->Parent))
+			{
+				children[pHierarchy->Parent].push_back(entity);
+				continue;
+			}
+
+			// Orphaned - its world matrix no longer includes the parent's
+			roots.push_back(entity);
+			m_Registry.emplace_or_replace<DirtyTag>(entity);
+		}
+
+		// Depth-first, so every subtree ends up contiguous
+		std::vector<std::pair<entt::entity, uint32>> stack;
+		for (auto it = roots.rbegin(); it != roots.rend(); it++)
+			stack.emplace_back(*it, INVALID_INDEX);
+
+		while (!stack.empty())
+		{
+			const auto [entity, parent] = stack.back();
+			stack.pop_back();
+
+			const uint32 index    = static_cast<uint32>(m_Entities.size());
+			m_NodeIndices[entity] = index;
+			m_Entities.push_back(entity);
+			m_Parents.push_back(parent);
+
+			if (auto it = children.find(entity); it != children.end())
+			{
+				for (auto child = it->second.rbegin(); child != it->second.rend(); child++)
+					stack.emplace_back(*child, index);
+			}
+		}
+
+		const uint32 nodeCount = static_cast<uint32>(m_Entities.size());
+
+		// Parents come first, so walking backwards accumulates every subtree's size into its root
+		std::vector<uint32> subtreeSizes(nodeCount, 1);
+		for (uint32 i = nodeCount; i-- > 0;)
+		{
+			if (m_Parents[i] != INVALID_INDEX)
+				subtreeSizes[m_Parents[i]] += subtreeSizes[i];
+		}
+
+		// Small subtrees become jobs - adjacent ones are merged so a flat scene doesn't turn into one job per entity
+		m_SubtreeOf.assign(nodeCount, INVALID_INDEX);
+		for (uint32 i = 0; i < nodeCount;)
+		{
+			const uint32 size = subtreeSizes[i];
+			if (size > SUBTREE_GRAIN_SIZE)
+			{
+				m_SpineNodes.push_back(i);
+				i++;
+				continue;
+			}
+
+			if (m_Subtrees.empty() || m_Subtrees.back().End != i || m_Subtrees.back().End - m_Subtrees.back().First + size > SUBTREE_GRAIN_SIZE)
+				m_Subtrees.push_back({i, i});
+
+			m_Subtrees.back().End += size;
+			std::fill(m_SubtreeOf.begin() + i, m_SubtreeOf.begin() + i + size, static_cast<uint32>(m_Subtrees.size() - 1));
+			i += size;
+		}
+
+		m_WorldMatrices.resize(nodeCount);
+		for (uint32 i = 0; i < nodeCount; i++)
+			m_WorldMatrices[i] = m_Registry.get<WorldTransformComponent>(m_Entities[i]).World;
+
+		m_Changed.assign(nodeCount, 0);
+		m_SubtreeDirty.assign(m_Subtrees.size(), 0);
+	}
+
+	void TransformSystem::UpdateNode(uint32 index)
+	{
+		const uint32 parent = m_Parents[index];
+		if (!m_Changed[index] && (parent == INVALID_INDEX || !m_Changed[parent]))
+			return;
+
+		const glm::mat4 local  = m_Registry.get<TransformComponent>(m_Entities[index]).GetTransform();
+		m_WorldMatrices[index] = parent == INVALID_INDEX ? local : m_WorldMatrices[parent] * local;
+		m_Changed[index]       = 1;
+
+		m_Registry.get<WorldTransformComponent>(m_Entities[index]).World = m_WorldMatrices[index];
+	}
+
+	void TransformSystem::UpdateSubtree(const Subtree& subtree)
+	{
+		// Parents come first, so one pass settles which nodes change
+		uint32 changedNodes[SUBTREE_GRAIN_SIZE];
+		uint32 changedCount = 0;
+		for (uint32 index = subtree.First; index < subtree.End; index++)
+		{
+			const uint32 parent = m_Parents[index];
+			if (m_Changed[index] || (parent != INVALID_INDEX && m_Changed[parent]))
+			{
+				m_Changed[index]             = 1;
+				changedNodes[changedCount++] = index;
+			}
+		}
+
+		if (changedCount == 0)
+			return;
+
+		// Gather as streams and compose every local matrix in one batch
+		float streamData[10][SUBTREE_GRAIN_SIZE];
+		for (uint32 i = 0; i < changedCount; i++)
+		{
+			const TransformComponent& transform = m_Registry.get<TransformComponent>(m_Entities[changedNodes[i]]);
+			streamData[0][i]                    = transform.Translation.x;
+			streamData[1][i]                    = transform.Translation.y;
+			streamData[2][i]                    = transform.Translation.z;
+			streamData[3][i]                    = transform.Orientation.x;
+			streamData[4][i]                    = transform.Orientation.y;
+			streamData[5][i]                    = transform.Orientation.z;
+			streamData[6][i]                    = transform.Orientation.w;
+			streamData[7][i]                    = transform.Scale.x;
+			streamData[8][i]                    = transform.Scale.y;
+			streamData[9][i]                    = transform.Scale.z;
+		}
+
+		const TransformStreams streams = {
+		    {streamData[0], streamData[1], streamData[2]},
+		    {streamData[3], streamData[4], streamData[5], streamData[6]},
+		    {streamData[7], streamData[8], streamData[9]}};
+
+		glm::mat4 localMatrices[SUBTREE_GRAIN_SIZE];
+		ComposeTransforms(streams, changedCount, localMatrices);
+
+		for (uint32 i = 0; i < changedCount; i++)
+		{
+			const uint32 index     = changedNodes[i];
+			const uint32 parent    = m_Parents[index];
+			m_WorldMatrices[index] = parent == INVALID_INDEX ? localMatrices[i] : m_WorldMatrices[parent] * localMatrices[i];
+
+			m_Registry.get<WorldTransformComponent>(m_Entities[index]).World = m_WorldMatrices[index];
+		}
+	}
+} // namespace Poly
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Poly/Core/Core.h"
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace Poly
+{
+	/*
+	 * Resolves every entity's WorldTransformComponent from its TransformComponent and HierarchyComponent::Parent.
+	 *
+	 * The hierarchy is flattened into arrays in depth-first order, so a parent always comes before its
+	 * children and every subtree is one contiguous range. The arrays are only rebuilt when a HierarchyComponent
+	 * is added, removed or patched (see Entity::SetParent()). Update() then only recomputes entities tagged with
+	 * DirtyTag and their descendants, tagging those descendants as well, so systems further down the frame
+	 * (e.g. SceneRenderBridge) pick up inherited motion.
+	 *
+	 * Subtrees of at most SUBTREE_GRAIN_SIZE entities are independent jobs on the ThreadPool, each gathering its
+	 * changed local transforms into streams for one ComposeTransforms() call. Ancestors of anything bigger
+	 * (typically an imported model's root) are the "spine" and are computed on the calling thread first.
+	 */
+	class TransformSystem
+	{
+	public:
+		static constexpr uint32 SUBTREE_GRAIN_SIZE = 256;
+		static constexpr uint32 INVALID_INDEX      = UINT32_MAX;
+
+		explicit TransformSystem(entt::registry& registry);
+		~TransformSystem();
+		CLASS_REMOVE_COPY(TransformSystem);
+
+		/*
+		 * Recomputes the world matrices of dirty entities and their descendants. Must run before anything that
+		 * consumes WorldTransformComponent, and before DirtyTag is cleared.
+		 */
+		void Update();
+
+	private:
+		// A contiguous range of the flattened arrays - one root entity and all of its descendants
+		struct Subtree
+		{
+			uint32 First = 0;
+			uint32 End   = 0;
+		};
+
+		void OnHierarchyChanged(entt::registry& registry, entt::entity entity);
+
+		void Rebuild();
+		void UpdateNode(uint32 index);
+		void UpdateSubtree(const Subtree& subtree);
+
+		entt::registry& m_Registry;
+		bool            m_HierarchyDirty = true;
+
+		// Flattened hierarchy, indexed by node index (depth-first order)
+		std::vector<entt::entity> m_Entities;
+		std::vector<uint32>       m_Parents;   // INVALID_INDEX for roots
+		std::vector<uint32>       m_SubtreeOf; // INVALID_INDEX for spine nodes
+		std::vector<glm::mat4>    m_WorldMatrices;
+		std::vector<uint8>        m_Changed; // recomputed this Update(), read by children - uint8 so jobs don't share bits
+
+		std::unordered_map<entt::entity, uint32> m_NodeIndices;
+		std::vector<uint32>                      m_SpineNodes;
+		std::vector<Subtree>                     m_Subtrees;
+		std::vector<uint8>                       m_SubtreeDirty;
+		std::vector<uint32>                      m_DirtySubtrees; // scratch
+	};
+} // namespace Poly
@@ -18,6 +18,7 @@
 #include "Poly/RenderGraph/SceneRenderBridge.h"
 #include "Poly/Rendering/Renderer.h"
 #include "Poly/Resources/AssetManager.h"
+#include "Poly/Resources/GeometryPool.h"
 #include "Poly/Scene/Entity.h"
 #include "Poly/Scene/Scene.h"
 
@@ -56,6 +57,16 @@ namespace
 	// pattern).
 	constexpr uint32 MAX_UI_VERTICES = 64 * 1024;
 	constexpr uint32 MAX_UI_INDICES  = 128 * 1024;
+
+	// One ImGui draw command, flattened out of its draw list so the "ui" pass can split them across workers
+	struct UIDraw
+	{
+		Poly::ScissorDesc   Scissor;
+		Poly::TextureHandle Texture;
+		uint32              IndexCount;
+		uint32              FirstIndex;
+		uint32              VertexOffset;
+	};
 } // namespace
 
 class RG2TestLayer : public Poly::Layer
@@ -73,6 +84,9 @@ public:
 
 		m_pScene = Poly::Scene::Create("RG2TestScene");
 
+		// Has to be picked before any mesh is loaded - less than half the vertex memory and fetch bandwidth
+		Poly::GeometryPool::SetVertexFormat(Poly::GeometryPool::EVertexFormat::PACKED);
+
 		Poly::Entity cubeEntity = m_pScene->CreateEntity();
 		// Poly::AssetManager::ImportAndLoadModel("models/Cube/Cube.gltf", cubeEntity);
 		Poly::AssetManager::ImportAndLoadModel("assets/models/sponza/gltf/sponza.gltf", cubeEntity);
@@ -119,8 +133,15 @@ public:
 			// however, currently it does not handle proper window management.
 			Poly::Ref<Poly::RenderProgramInstance> nonOwningInstance(pInstance, [](Poly::RenderProgramInstance*) {});
 			m_pScene->CreateSceneRenderBridge(nonOwningInstance);
+
+			// Every transform here is affine - 48-byte instance rows instead of 80
+			m_pScene->GetSceneRenderBridge()->SetInstanceFormat(Poly::SceneRenderBridge::EInstanceFormat::COMPACT);
 		}
 
+		// Coarser LODs wherever their simplification error stays below a pixel on screen - picked up by the bridge's Update()
+		Poly::Window* pWindow = Poly::Application::Get().GetWindow();
+		m_pScene->GetSceneRenderBridge()->SetLodErrorTarget(m_pCamera->GetProjection(), static_cast<float>(pWindow->GetHeight()), 1.0f);
+
 		m_pScene->Update();
 
 		m_pCamera->Update(dt);
@@ -142,14 +163,47 @@ public:
 
 private:
 	// Current shader restriction means the order resources are registered must match the order they are bound in the shader. Until slang, this is the case
-	// the order below is load bearing: Camera(0), scene.vertices(1), scene.instances(2), Lights(3), scene.materials(4).
+	// the order below is load bearing: Camera(0), scene.vertices(1), scene.instances(2), Lights(3), scene.materials(4), scene.visibleDraws(5),
+	// scene.cullParams(6), scene.batches(7), scene.instanceDraws(8) for "pbr", and Camera(0), scene.cullParams(1), scene.instances(2), scene.meshBounds(3),
+	// scene.drawCommands(4), scene.meshlets(5), scene.meshLods(6), scene.visibleDraws(7), scene.batches(8), scene.indices(9), scene.indices16(10),
+	// scene.instanceDraws(11) for "cull".
 	void RegisterGeometryFeature()
 	{
 		m_Graph.RegisterResource("Camera").WithType(Poly::EResourceType::UniformBuffer);
 		m_Graph.RegisterResource("Lights").WithType(Poly::EResourceType::StorageBuffer);
 		m_Graph.RegisterResource(Poly::Scene::VERTICES_RESOURCE_NAME_2).WithType(Poly::EResourceType::StorageBuffer);
+		m_Graph.RegisterResource(Poly::Scene::INDICES_RESOURCE_NAME_2).WithType(Poly::EResourceType::StorageBuffer);
+		m_Graph.RegisterResource(Poly::Scene::INDICES16_RESOURCE_NAME_2).WithType(Poly::EResourceType::StorageBuffer);
 		m_Graph.RegisterResource(Poly::Scene::INSTANCE_RESOURCE_NAME_2).WithType(Poly::EResourceType::StorageBuffer);
+		m_Graph.RegisterResource(Poly::Scene::INSTANCE_DRAWS_RESOURCE_NAME_2).WithType(Poly::EResourceType::StorageBuffer);
 		m_Graph.RegisterResource(Poly::Scene::MATERIAL_RESOURCE_NAME_2).WithType(Poly::EResourceType::StorageBuffer);
+		m_Graph.RegisterResource(Poly::Scene::CULL_PARAMS_RESOURCE_NAME_2).WithType(Poly::EResourceType::UniformBuffer);
+		m_Graph.RegisterResource(Poly::Scene::MESH_BOUNDS_RESOURCE_NAME_2).WithType(Poly::EResourceType::StorageBuffer);
+		m_Graph.RegisterResource(Poly::Scene::MESHLETS_RESOURCE_NAME_2).WithType(Poly::EResourceType::StorageBuffer);
+		m_Graph.RegisterResource(Poly::Scene::MESH_LODS_RESOURCE_NAME_2).WithType(Poly::EResourceType::StorageBuffer);
+		m_Graph.RegisterResource(Poly::Scene::DRAW_COMMANDS_RESOURCE_NAME_2).WithType(Poly::EResourceType::StorageBuffer);
+		m_Graph.RegisterResource(Poly::Scene::BATCHES_RESOURCE_NAME_2).WithType(Poly::EResourceType::StorageBuffer);
+		m_Graph.RegisterResource(Poly::Scene::VISIBLE_DRAWS_RESOURCE_NAME_2).WithType(Poly::EResourceType::IndirectBuffer);
+
+		m_Graph.RegisterPass("cull")
+		    .WithShader("assets/shaders/cull.comp", Poly::FShaderStage::COMPUTE)
+		    .WithComputePipeline()
+		    .MapGlobal("Camera", "camera")
+		    .MapGlobal(Poly::Scene::CULL_PARAMS_RESOURCE_NAME_2, "params")
+		    .MapGlobal(Poly::Scene::INSTANCE_RESOURCE_NAME_2, "instances")
+		    .MapGlobal(Poly::Scene::MESH_BOUNDS_RESOURCE_NAME_2, "meshBounds")
+		    .MapGlobal(Poly::Scene::DRAW_COMMANDS_RESOURCE_NAME_2, "drawCommands")
+		    .MapGlobal(Poly::Scene::MESHLETS_RESOURCE_NAME_2, "meshlets")
+		    .MapGlobal(Poly::Scene::MESH_LODS_RESOURCE_NAME_2, "meshLods")
+		    .WriteGlobal(Poly::Scene::VISIBLE_DRAWS_RESOURCE_NAME_2, "visibleDraws")
+		    .MapGlobal(Poly::Scene::BATCHES_RESOURCE_NAME_2, "batches")
+		    .MapGlobal(Poly::Scene::INDICES_RESOURCE_NAME_2, "indices")
+		    .MapGlobal(Poly::Scene::INDICES16_RESOURCE_NAME_2, "indices16")
+		    .MapGlobal(Poly::Scene::INSTANCE_DRAWS_RESOURCE_NAME_2, "instanceDraws")
+		    .WithExecuteFn([this](Poly::ExecuteContext& ctx) {
+			    if (Poly::SceneRenderBridge* pBridge = m_pScene->GetSceneRenderBridge())
+				    pBridge->RecordCulling(ctx.GetCommandBuffer());
+		    });
 
 		m_Graph.RegisterPass("pbr")
 		    .WithShader("assets/shaders/pbr_bindless.vert", Poly::FShaderStage::VERTEX)
@@ -161,6 +215,10 @@ private:
 		    .MapGlobal(Poly::Scene::INSTANCE_RESOURCE_NAME_2, "instances")
 		    .MapGlobal("Lights", "lights")
 		    .MapGlobal(Poly::Scene::MATERIAL_RESOURCE_NAME_2, "materialProps")
+		    .MapGlobal(Poly::Scene::VISIBLE_DRAWS_RESOURCE_NAME_2, "visibleDraws")
+		    .MapGlobal(Poly::Scene::CULL_PARAMS_RESOURCE_NAME_2, "params")
+		    .MapGlobal(Poly::Scene::BATCHES_RESOURCE_NAME_2, "batches")
+		    .MapGlobal(Poly::Scene::INSTANCE_DRAWS_RESOURCE_NAME_2, "instanceDraws")
 		    .WithGraphicsPipeline() // TODO: add a default pipeline to the graph so this can be omitted and the default used
 		    .Topology(Poly::ETopology::TRIANGLE_LIST)
 		    .PolygonMode(Poly::EPolygonMode::FILL)
@@ -177,21 +235,18 @@ private:
 		    .FinishPipeline()
 		    .WithExecuteFn([this](Poly::ExecuteContext& ctx) {
 			    Poly::SceneRenderBridge* pBridge = m_pScene->GetSceneRenderBridge();
-			    if (!pBridge)
+			    if (!pBridge || pBridge->GetInstanceCount() == 0)
 				    return;
 
-			    Poly::CommandBuffer* pCmd = ctx.GetCommandBuffer();
-			    pCmd->BindIndexBuffer(pBridge->GetIndexBuffer(), 0, Poly::EIndexType::UINT32);
-			    for (const Poly::SceneDrawBatch& batch : pBridge->GetDrawBatches())
-				    pCmd->DrawIndexedInstanced(batch.IndexCount, batch.InstanceCount, batch.BaseIndex, batch.BaseVertex, batch.FirstInstance);
+			    // "cull" wrote a draw per run of visible meshlets and their compacted indices - the whole scene in one indirect call
+			    pBridge->RecordDraws(ctx.GetCommandBuffer());
 		    });
 
-		m_Graph.RegisterFeature("geometry").WithPass("pbr");
+		m_Graph.RegisterFeature("geometry").WithPass("cull").WithPass("pbr");
 	}
 
-	// Font-only ImGui pass: only ever samples the font atlas, so its one texture resolves to a single
-	// bindless slot built once per frame - no per-draw texture switching, which RG2 doesn't support yet
-	// (ExecuteContext exposes no way to update push constants mid-pass; see ui_bindless.frag).
+	// ImGui pass - recorded in parallel, each range binding the UI buffers and switching the texture slot per draw in
+	// its own secondary command buffer. The draws are flattened by UpdateUI() before the pass is recorded.
 	void RegisterUIFeature()
 	{
 		m_Graph.RegisterResource("UIGlobals").WithType(Poly::EResourceType::UniformBuffer);
@@ -247,41 +302,21 @@ private:
 								Poly::FColorComponentFlag::ALPHA)
 		    .FinishColorBlendAttachment()
 		    .FinishPipeline()
+		    .WithParallelRecording()
 		    .WithExecuteFn([this](Poly::ExecuteContext& ctx) {
-			    ImDrawData* pDrawData = ImGui::GetDrawData();
-			    if (!pDrawData || !pDrawData->Valid || pDrawData->CmdListsCount == 0)
-				    return;
-
-			    Poly::CommandBuffer* pCmd = ctx.GetCommandBuffer();
-			    pCmd->BindVertexBuffer(Poly::ResourceManager::Resolve(m_UIVertexBufferHandle), 0, 1, 0);
-			    pCmd->BindIndexBuffer(Poly::ResourceManager::Resolve(m_UIIndexBufferHandle), 0, Poly::EIndexType::UINT16);
+			    ctx.RecordParallel(static_cast<uint32>(m_UIDraws.size()), 64, [this](Poly::ExecuteContext& rangeCtx, uint32 begin, uint32 end) {
+				    Poly::CommandBuffer* pCmd = rangeCtx.GetCommandBuffer();
+				    pCmd->BindVertexBuffer(Poly::ResourceManager::Resolve(m_UIVertexBufferHandle), 0, 1, 0);
+				    pCmd->BindIndexBuffer(Poly::ResourceManager::Resolve(m_UIIndexBufferHandle), 0, Poly::EIndexType::UINT16);
 
-			    uint32 vertexOffset = 0;
-			    uint32 indexOffset  = 0;
-			    for (int i = 0; i < pDrawData->CmdListsCount; i++)
-			    {
-				    const ImDrawList* pCmdList = pDrawData->CmdLists[i];
-				    for (int j = 0; j < pCmdList->CmdBuffer.Size; j++)
+				    for (uint32 i = begin; i < end; i++)
 				    {
-					    const ImDrawCmd* pImCmd = &pCmdList->CmdBuffer[j];
-
-					    Poly::ScissorDesc scissor = {};
-					    scissor.OffsetX           = std::max(static_cast<int>(pImCmd->ClipRect.x), 0);
-					    scissor.OffsetY           = std::max(static_cast<int>(pImCmd->ClipRect.y), 0);
-					    scissor.Width             = static_cast<uint32>(pImCmd->ClipRect.z - pImCmd->ClipRect.x);
-					    scissor.Height            = static_cast<uint32>(pImCmd->ClipRect.w - pImCmd->ClipRect.y);
-					    pCmd->SetScissor(&scissor);
-
-
-						ImTextureID texID = pImCmd->TexRef.GetTexID();
-						Poly::TextureHandle textureHandle(static_cast<uint32>(texID));
-						ctx.SetTextureSlot(0, textureHandle, m_FontSamplerHandle);
-
-					    pCmd->DrawIndexedInstanced(pImCmd->ElemCount, 1, indexOffset, vertexOffset, 0);
-					    indexOffset += pImCmd->ElemCount;
+					    const UIDraw& draw = m_UIDraws[i];
+					    pCmd->SetScissor(&draw.Scissor);
+					    rangeCtx.SetTextureSlot(0, draw.Texture, m_FontSamplerHandle);
+					    pCmd->DrawIndexedInstanced(draw.IndexCount, 1, draw.FirstIndex, draw.VertexOffset, 0);
 				    }
-				    vertexOffset += pCmdList->VtxBuffer.Size;
-			    }
+			    });
 		    });
 		// clang-format on
 
@@ -350,6 +385,7 @@ private:
 		ImGui::End();
 
 		ImGui::Render();
+		m_UIDraws.clear();
 
 		ImDrawData* pDrawData = ImGui::GetDrawData();
 		if (!pDrawData || !pDrawData->Valid)
@@ -381,6 +417,25 @@ private:
 			Poly::ResourceManager::UploadBufferData(m_UIVertexBufferHandle, pCmdList->VtxBuffer.Data, vertexBufferSize, vertexOffset);
 			Poly::ResourceManager::UploadBufferData(m_UIIndexBufferHandle, pCmdList->IdxBuffer.Data, indexBufferSize, indexOffset);
 
+			uint32 firstIndex = static_cast<uint32>(indexOffset / sizeof(ImDrawIdx));
+			for (int j = 0; j < pCmdList->CmdBuffer.Size; j++)
+			{
+				const ImDrawCmd* pImCmd = &pCmdList->CmdBuffer[j];
+
+				UIDraw draw          = {};
+				draw.Scissor.OffsetX = std::max(static_cast<int>(pImCmd->ClipRect.x), 0);
+				draw.Scissor.OffsetY = std::max(static_cast<int>(pImCmd->ClipRect.y), 0);
+				draw.Scissor.Width   = static_cast<uint32>(pImCmd->ClipRect.z - pImCmd->ClipRect.x);
+				draw.Scissor.Height  = static_cast<uint32>(pImCmd->ClipRect.w - pImCmd->ClipRect.y);
+				draw.Texture         = Poly::TextureHandle(static_cast<uint32>(pImCmd->TexRef.GetTexID()));
+				draw.IndexCount      = pImCmd->ElemCount;
+				draw.FirstIndex      = firstIndex;
+				draw.VertexOffset    = static_cast<uint32>(vertexOffset / sizeof(ImDrawVert));
+				m_UIDraws.push_back(draw);
+
+				firstIndex += pImCmd->ElemCount;
+			}
+
 			vertexOffset += vertexBufferSize;
 			indexOffset += indexBufferSize;
 		}
@@ -418,6 +473,8 @@ private:
 	Poly::BufferHandle m_UIGlobalsBufferHandle;
 	Poly::BufferHandle m_UIVertexBufferHandle;
 	Poly::BufferHandle m_UIIndexBufferHandle;
+
+	std::vector<UIDraw> m_UIDraws; // this frame's, see UpdateUI()
 };
 
 class RG2TestApp : public Poly::Application
@@ -0,0 +1,125 @@
+#include "Poly/Core/Utils/TransformBatch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/quaternion.hpp>
+
+// Times ComposeTransforms() against composing the same transforms one at a time with glm, the way
+// TransformComponent::GetTransform() does, and checks both give the same matrices. Exits with 1 if they don't.
+namespace
+{
+	constexpr uint32 TRANSFORM_COUNT = 100000;
+	constexpr uint32 RUN_COUNT       = 50;    // best run is reported, the rest only warm up caches and clocks
+	constexpr float  TOLERANCE       = 1e-5f; // relative to the element's magnitude, both paths round differently
+
+	struct TransformData
+	{
+		std::vector<float> Translation[3];
+		std::vector<float> Orientation[4];
+		std::vector<float> Scale[3];
+	};
+
+	TransformData GenerateTransforms(uint32 count)
+	{
+		std::mt19937                          rng(1234);
+		std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> scale(0.1f, 10.0f);
+
+		TransformData data;
+		for (uint32 i = 0; i < count; i++)
+		{
+			const glm::quat orientation = glm::normalize(glm::quat(axis(rng), axis(rng), axis(rng), axis(rng)));
+			for (int c = 0; c < 3; c++)
+			{
+				data.Translation[c].push_back(position(rng));
+				data.Scale[c].push_back(scale(rng));
+			}
+
+			data.Orientation[0].push_back(orientation.x);
+			data.Orientation[1].push_back(orientation.y);
+			data.Orientation[2].push_back(orientation.z);
+			data.Orientation[3].push_back(orientation.w);
+		}
+		return data;
+	}
+
+	// Best time of RUN_COUNT calls, in milliseconds
+	template<typename Func>
+	double TimeBest(Func&& func)
+	{
+		double best = 1e30;
+		for (uint32 run = 0; run < RUN_COUNT; run++)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			func();
+			const auto end = std::chrono::steady_clock::now();
+			best           = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+		}
+		return best;
+	}
+} // namespace
+
+int main()
+{
+	const TransformData data = GenerateTransforms(TRANSFORM_COUNT);
+
+	Poly::TransformStreams streams;
+	for (int c = 0; c < 3; c++)
+	{
+		streams.pTranslation[c] = data.Translation[c].data();
+		streams.pScale[c]       = data.Scale[c].data();
+	}
+	for (int c = 0; c < 4; c++)
+		streams.pOrientation[c] = data.Orientation[c].data();
+
+	std::vector<glm::mat4> batched(TRANSFORM_COUNT);
+	std::vector<glm::mat4> reference(TRANSFORM_COUNT);
+
+	const double batchedMs = TimeBest([&]() { Poly::ComposeTransforms(streams, TRANSFORM_COUNT, batched.data()); });
+
+	const double referenceMs = TimeBest([&]() {
+		for (uint32 i = 0; i < TRANSFORM_COUNT; i++)
+		{
+			const glm::vec3 translation = {data.Translation[0][i], data.Translation[1][i], data.Translation[2][i]};
+			const glm::quat orientation = glm::quat(data.Orientation[3][i], data.Orientation[0][i], data.Orientation[1][i], data.Orientation[2][i]);
+			const glm::vec3 scale       = {data.Scale[0][i], data.Scale[1][i], data.Scale[2][i]};
+
+			reference[i] = glm::translate(glm::mat4(1.0f), translation) * glm::toMat4(orientation) * glm::scale(glm::mat4(1.0f), scale);
+		}
+	});
+
+	uint32 mismatches = 0;
+	float  maxError   = 0.0f;
+	for (uint32 i = 0; i < TRANSFORM_COUNT; i++)
+	{
+		bool match = true;
+		for (int column = 0; column < 4; column++)
+		{
+			for (int row = 0; row < 4; row++)
+			{
+				const float expected = reference[i][column][row];
+				const float error    = std::abs(batched[i][column][row] - expected);
+				maxError             = std::max(maxError, error);
+				match                = match && error <= TOLERANCE * std::max(1.0f, std::abs(expected));
+			}
+		}
+
+		if (!match && mismatches++ < 4)
+			std::printf("Transform %u differs from glm\n", i);
+	}
+
+	std::printf("%u transforms, best of %u runs\n", TRANSFORM_COUNT, RUN_COUNT);
+	std::printf("  ComposeTransforms(): %8.3f ms\n", batchedMs);
+	std::printf("  glm:                 %8.3f ms (%.2fx)\n", referenceMs, referenceMs / batchedMs);
+	std::printf("  max abs error %g, %u mismatches\n", maxError, mismatches);
+
+	return mismatches == 0 ? 0 : 1;
+}
@@ -17,11 +17,236 @@ layout(set = 0, binding = 1) uniform sampler   g_Samplers[];
 	uint     textureIndices[BINDLESS_MAX_SLOTS]; \
 	uint64_t bufferAddresses[BINDLESS_MAX_SLOTS]
 
-// Mirrors Poly::InstanceData in Poly/RenderGraph/Shader/InstanceData.h byte-for-byte.
+// Mirrors Poly::GPUInstanceData in Poly/RenderGraph/Shader/GPUInstanceData.h byte-for-byte.
 struct InstanceData
 {
 	mat4 Transform;
 	uint MaterialIndex;
+	uint DrawIndex;
+	uint BoundsIndex;
+	uint Flags;
+};
+
+// Mirrors Poly::GPUCompactInstanceData in Poly/RenderGraph/Shader/GPUInstanceData.h byte-for-byte - the
+// transform's affine rows, the DrawIndex is in a parallel stream (InstanceDrawBuffer).
+struct CompactInstanceData
+{
+	vec4 AffineRows[3];
+};
+
+// Mirrors Poly::GPUBatchData in Poly/RenderGraph/Shader/GPUInstanceData.h byte-for-byte.
+struct BatchData
+{
+	uint MaterialIndex;
+	uint BoundsIndex;
+	uint Flags;
+	uint _Pad;
+};
+
+// Poly::SceneRenderBridge::EInstanceFormat
+#define INSTANCE_FORMAT_FULL    0u
+#define INSTANCE_FORMAT_COMPACT 1u
+
+// Poly::GPUInstanceData::INVALID_DRAW_INDEX - a free instance slot
+#define INVALID_DRAW_INDEX 0xFFFFFFFFu
+
+// Poly::GPUInstanceData::FLAG_*
+#define INSTANCE_FLAG_INDEX16 1u
+
+layout(buffer_reference, std430) readonly buffer InstanceBuffer
+{
+	InstanceData data[];
+};
+
+layout(buffer_reference, std430) readonly buffer CompactInstanceBuffer
+{
+	CompactInstanceData data[];
+};
+
+// Scene::INSTANCE_DRAWS_RESOURCE_NAME_2 - the DrawIndex of each compact instance row
+layout(buffer_reference, std430) readonly buffer InstanceDrawBuffer
+{
+	uint drawIndex[];
+};
+
+layout(buffer_reference, std430) readonly buffer BatchBuffer
+{
+	BatchData batches[];
+};
+
+// Mirrors Poly::GPUCullParams in Poly/RenderGraph/Shader/GPUCullParams.h byte-for-byte.
+layout(buffer_reference, std430) readonly buffer CullParamsBuffer
+{
+	uint InstanceCount;
+	uint InstanceFormat;
+	uint VertexFormat;
+	uint VisibleIndexOffset;
+	float LodScale;
+};
+
+// Reads one row of the scene's instance buffer (Scene::INSTANCE_RESOURCE_NAME_2) in whichever layout
+// CullParamsBuffer.InstanceFormat says it's in. The format is the same for the whole dispatch/draw, so
+// the branch is uniform. A compact row's DrawIndex comes from Scene::INSTANCE_DRAWS_RESOURCE_NAME_2, and its
+// material, bounds and flags from its batch's row in Scene::BATCHES_RESOURCE_NAME_2.
+InstanceData LoadInstance(uint64_t instances, uint64_t instanceDraws, uint64_t batches, uint format, uint index)
+{
+	if (format == INSTANCE_FORMAT_COMPACT)
+	{
+		CompactInstanceData compact = CompactInstanceBuffer(instances).data[index];
+
+		InstanceData instance;
+		instance.Transform     = transpose(mat4(compact.AffineRows[0], compact.AffineRows[1], compact.AffineRows[2], vec4(0.0f, 0.0f, 0.0f, 1.0f)));
+		instance.DrawIndex     = InstanceDrawBuffer(instanceDraws).drawIndex[index];
+		instance.MaterialIndex = 0;
+		instance.BoundsIndex   = 0;
+		instance.Flags         = 0;
+		if (instance.DrawIndex != INVALID_DRAW_INDEX)
+		{
+			BatchData batch        = BatchBuffer(batches).batches[instance.DrawIndex];
+			instance.MaterialIndex = batch.MaterialIndex;
+			instance.BoundsIndex   = batch.BoundsIndex;
+			instance.Flags         = batch.Flags;
+		}
+		return instance;
+	}
+
+	return InstanceBuffer(instances).data[index];
+}
+
+// Mirrors Poly::Vertex in Poly/Model/Mesh.h byte-for-byte.
+struct Vertex
+{
+	vec4 Position;
+	vec4 Normal;
+	vec4 Tangent;
+	vec4 TexCoord;
+};
+
+// Mirrors Poly::PackedVertex in Poly/Model/Mesh.h byte-for-byte - floats rather than a vec3 so it keeps
+// the 24-byte stride under std430.
+struct PackedVertex
+{
+	float Position[3];
+	uint  Normal;   // octahedral, snorm16 x2
+	uint  Tangent;  // octahedral, snorm16 x2
+	uint  TexCoord; // half2
+};
+
+// Poly::GeometryPool::EVertexFormat
+#define VERTEX_FORMAT_FULL   0u
+#define VERTEX_FORMAT_PACKED 1u
+
+// Poly::GeometryPool::VERTEX_PAGE_SIZE_LOG2 and INDEX_PAGE_SIZE_LOG2
+#define VERTEX_PAGE_SIZE_LOG2 18u
+#define INDEX_PAGE_SIZE_LOG2  20u
+
+// Device addresses of a paged Poly::BufferArena's pages
+layout(buffer_reference, std430) readonly buffer PageTableBuffer
+{
+	uint64_t page[];
+};
+
+layout(buffer_reference, std430) readonly buffer VertexBuffer
+{
+	Vertex vertex[];
+};
+
+layout(buffer_reference, std430) readonly buffer PackedVertexBuffer
+{
+	PackedVertex vertex[];
+};
+
+// Inverse of Poly::PackedVertex::EncodeOctahedral() - unfolds the lower half back over the diagonals
+vec3 DecodeOctahedral(vec2 encoded)
+{
+	vec3  direction = vec3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+	float fold      = max(-direction.z, 0.0f);
+	direction.x    += direction.x >= 0.0f ? -fold : fold;
+	direction.y    += direction.y >= 0.0f ? -fold : fold;
+	return normalize(direction);
+}
+
+// Reads one vertex of the scene's vertex buffer (Scene::VERTICES_RESOURCE_NAME_2) in whichever layout
+// CullParamsBuffer.VertexFormat says it's in, always returned as a full Vertex (w = 0, like the CPU side writes).
+// The buffer is a page table - vertex i is vertex (i & (page size - 1)) of page (i >> VERTEX_PAGE_SIZE_LOG2).
+Vertex LoadVertex(uint64_t vertices, uint format, uint index)
+{
+	uint64_t page  = PageTableBuffer(vertices).page[index >> VERTEX_PAGE_SIZE_LOG2];
+	uint     local = index & ((1u << VERTEX_PAGE_SIZE_LOG2) - 1u);
+
+	if (format == VERTEX_FORMAT_PACKED)
+	{
+		PackedVertex packed = PackedVertexBuffer(page).vertex[local];
+
+		Vertex vertex;
+		vertex.Position = vec4(packed.Position[0], packed.Position[1], packed.Position[2], 0.0f);
+		vertex.Normal   = vec4(DecodeOctahedral(unpackSnorm2x16(packed.Normal)), 0.0f);
+		vertex.Tangent  = vec4(DecodeOctahedral(unpackSnorm2x16(packed.Tangent)), 0.0f);
+		vertex.TexCoord = vec4(unpackHalf2x16(packed.TexCoord), 0.0f, 0.0f);
+		return vertex;
+	}
+
+	return VertexBuffer(page).vertex[local];
+}
+
+// A page of one of GeometryPool's index arenas, as 32-bit words
+layout(buffer_reference, std430) readonly buffer IndexBuffer
+{
+	uint index[];
+};
+
+// Reads one index of a mesh from the page table of its index arena (Scene::INDICES_RESOURCE_NAME_2 /
+// INDICES16_RESOURCE_NAME_2) - GPUInstanceData::FLAG_INDEX16 says which one it's in. Paged like LoadVertex(), and
+// a 16-bit page holds two indices per word, the lower one first - pages hold an even count, so a word never
+// straddles two.
+uint LoadIndex(uint64_t indices, bool index16, uint index)
+{
+	uint64_t page  = PageTableBuffer(indices).page[index >> INDEX_PAGE_SIZE_LOG2];
+	uint     local = index & ((1u << INDEX_PAGE_SIZE_LOG2) - 1u);
+
+	if (index16)
+	{
+		uint word = IndexBuffer(page).index[local >> 1];
+		return (local & 1u) != 0 ? word >> 16 : word & 0xFFFFu;
+	}
+
+	return IndexBuffer(page).index[local];
+}
+
+// Mirrors Poly::MeshBounds in Poly/Model/Mesh.h byte-for-byte - one entry of GeometryPool's bounds
+// buffer (Scene::MESH_BOUNDS_RESOURCE_NAME_2), in the mesh's object space.
+struct MeshBounds
+{
+	vec4 Sphere; // xyz = center, w = radius
+	vec3 Min;
+	uint FirstLod;
+	vec3 Max;
+	uint LodCount;
+};
+
+// Mirrors Poly::Meshlet in Poly/Model/Mesh.h byte-for-byte - one entry of GeometryPool's meshlet buffer
+// (Scene::MESHLETS_RESOURCE_NAME_2), in the mesh's object space.
+struct Meshlet
+{
+	vec4 Sphere;     // xyz = center, w = radius
+	vec4 Cone;       // xyz = average normal, w = sine of the widest angle from it
+	uint FirstIndex; // relative to the mesh's first index
+	uint IndexCount;
+};
+
+layout(buffer_reference, std430) readonly buffer MeshletBuffer
+{
+	Meshlet meshlets[];
+};
+
+// Mirrors Poly::MeshLod in Poly/Model/Mesh.h byte-for-byte - one entry of GeometryPool's LOD buffer
+// (Scene::MESH_LODS_RESOURCE_NAME_2).
+struct MeshLod
+{
+	uint  FirstMeshlet;
+	uint  MeshletCount;
+	float Error; // object space
+	uint  _Pad;
 };
 
 // Mirrors Poly::MaterialValues in Poly/RenderGraph/Shader/GPUMaterialData.h byte-for-byte.
@@ -41,6 +266,42 @@ struct MaterialValues
 	vec2	_Pad;
 };
 
+// Mirrors Poly::DrawIndexedIndirectCommand in Platform/API/CommandBuffer.h byte-for-byte - one entry of an
+// indirect argument buffer (e.g. Scene::VISIBLE_DRAWS_RESOURCE_NAME_2), tightly packed at a 20-byte stride.
+struct DrawIndexedCommand
+{
+	uint IndexCount;
+	uint InstanceCount;
+	uint FirstIndex;
+	int  VertexOffset;
+	uint FirstInstance;
+};
+
+// Scene::DRAW_COMMANDS_RESOURCE_NAME_2 - never drawn from, each batch slot's mesh range (IndexCount, FirstIndex,
+// VertexOffset) and member count (InstanceCount) in the command layout, read by cull.comp
+layout(buffer_reference, std430) readonly buffer DrawCommandBuffer
+{
+	DrawIndexedCommand commands[];
+};
+
+// Scene::VISIBLE_DRAWS_RESOURCE_NAME_2, written by cull.comp - the draws' count and the compacted indices they've
+// reserved up front (Poly::SceneRenderBridge::VISIBLE_DRAWS_HEADER_SIZE bytes), then the draws themselves. Read back by
+// SceneRenderBridge::RecordDraws() as the argument, count and index buffer of one DrawIndexedIndirectCount().
+layout(buffer_reference, std430) buffer VisibleDrawBuffer
+{
+	uint               DrawCount;
+	uint               IndexCount;
+	uint               _Pad[2];
+	DrawIndexedCommand draws[];
+};
+
+// The compacted indices, CullParamsBuffer.VisibleIndexOffset bytes into the visible draw buffer - relative to their
+// draw's VertexOffset, like the mesh's own
+layout(buffer_reference, std430) writeonly buffer VisibleIndexBuffer
+{
+	uint index[];
+};
+
 // Unpacks a textureIndices[] entry (see BindlessManager::TEXTURE_INDEX_BITS/SAMPLER_INDEX_BITS -
 // low 12 bits = texture index into g_Textures[], next 8 bits = sampler index into g_Samplers[])
 // and samples it. The index is dynamically uniform per draw (comes from a push constant), but
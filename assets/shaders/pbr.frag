@@ -43,8 +43,10 @@ layout(set = 3, binding = 5) uniform sampler2D combinedTex;
 
 vec3 GenerateNormal(in mat3 TBN)
 {
-	vec3 normal = texture(normalTex, in_TexCoord).rgb;
-	normal = normal * 2.0f - 1.0f;
+	// Normal maps are BC5, with only X and Y - Z is rebuilt from the unit length
+	vec3 normal;
+	normal.xy = texture(normalTex, in_TexCoord).rg * 2.0f - 1.0f;
+	normal.z = sqrt(max(1.0f - dot(normal.xy, normal.xy), 0.0f));
 	return normalize(TBN * normal);
 }
 
@@ -13,6 +13,10 @@ const float PI = 3.14159265359f;
 //   bufferAddresses[2] = pbr_bindless.Instances    (vert only)
 //   bufferAddresses[3] = $.scene:Lights
 //   bufferAddresses[4] = pbr_bindless.MaterialProperties
+//   bufferAddresses[5] = scene.visibleDraws        (neither, see vert)
+//   bufferAddresses[6] = scene.cullParams          (vert only)
+//   bufferAddresses[7] = scene.batches             (vert only)
+//   bufferAddresses[8] = scene.instanceDraws       (vert only)
 //
 // Per-material texture indices used to live in textureIndices[0..5] here, but push constants only get
 // built once per pass, before ExecuteFn's draw loop runs - a multi-material scene can't get correct
@@ -62,8 +66,10 @@ layout(push_constant, std430) uniform PushConstants
 
 vec3 GenerateNormal(in mat3 TBN, uint normalTexIndex)
 {
-	vec3 normal = SampleBindless(normalTexIndex, in_TexCoord).rgb;
-	normal = normal * 2.0f - 1.0f;
+	// Normal maps are BC5, with only X and Y - Z is rebuilt from the unit length
+	vec3 normal;
+	normal.xy = SampleBindless(normalTexIndex, in_TexCoord).rg * 2.0f - 1.0f;
+	normal.z = sqrt(max(1.0f - dot(normal.xy, normal.xy), 0.0f));
 	return normalize(TBN * normal);
 }
 
@@ -11,20 +11,15 @@
 //   bufferAddresses[1] = pbr_bindless.Vertices
 //   bufferAddresses[2] = pbr_bindless.Instances
 //   bufferAddresses[3.. ] = used by pbr_bindless.frag only, see there
+//   bufferAddresses[5] = scene.visibleDraws - not read by either stage, mapped so the graph syncs the draws against cull.comp
+//   bufferAddresses[6] = scene.cullParams - InstanceFormat/VertexFormat, the layouts Instances/Vertices are in
+//   bufferAddresses[7] = scene.batches - what a compact instance row leaves out, see LoadInstance()
+//   bufferAddresses[8] = scene.instanceDraws - likewise
 //
 // Vertices/Instances are combined, scene-wide buffers built by SceneRenderBridge (see
-// Poly/RenderGraph/SceneRenderBridge.h) - which mesh/instances a draw call touches comes from
-// DrawIndexedInstanced's own baseVertex/firstInstance parameters, not from anything in this push
-// constant, so the buffer addresses here never need to change between draw calls in the pass.
-
-// Structs
-struct Vertex
-{
-	vec4 Position;
-	vec4 Normal;
-	vec4 Tangent;
-	vec4 TexCoord;
-};
+// Poly/RenderGraph/SceneRenderBridge.h). Every draw is a run of one instance's visible meshlets, indexed through the
+// compacted indices cull.comp wrote - gl_VertexIndex already has the mesh's first vertex added and gl_InstanceIndex is
+// the instance slot, so the buffer addresses here never need to change between draw calls in the pass.
 
 // BDA buffer types
 layout(buffer_reference, std430) readonly buffer CameraBuffer
@@ -33,16 +28,6 @@ layout(buffer_reference, std430) readonly buffer CameraBuffer
 	vec4 camPos;
 };
 
-layout(buffer_reference, std430) readonly buffer VertexBuffer
-{
-	Vertex vertex[];
-};
-
-layout(buffer_reference, std430) readonly buffer InstanceBuffer
-{
-	InstanceData data[];
-};
-
 layout(push_constant, std430) uniform PushConstants
 {
 	BINDLESS_PUSH_CONSTANTS;
@@ -56,21 +41,21 @@ layout(location = 3) out flat uint out_MaterialIndex;
 layout(location = 4) out mat3 out_TBN;
 
 void main() {
-	CameraBuffer   camera    = CameraBuffer(pc.bufferAddresses[0]);
-	VertexBuffer   vertices  = VertexBuffer(pc.bufferAddresses[1]);
-	InstanceBuffer instances = InstanceBuffer(pc.bufferAddresses[2]);
+	CameraBuffer     camera = CameraBuffer(pc.bufferAddresses[0]);
+	CullParamsBuffer params = CullParamsBuffer(pc.bufferAddresses[6]);
 
-	InstanceData instanceData = instances.data[gl_InstanceIndex];
+	InstanceData instanceData = LoadInstance(pc.bufferAddresses[2], pc.bufferAddresses[8], pc.bufferAddresses[7], params.InstanceFormat, gl_InstanceIndex);
+	Vertex       vertex       = LoadVertex(pc.bufferAddresses[1], params.VertexFormat, gl_VertexIndex);
 
-	vec4 worldPosition = instanceData.Transform * vec4(vertices.vertex[gl_VertexIndex].Position.xyz, 1.0f);
+	vec4 worldPosition = instanceData.Transform * vec4(vertex.Position.xyz, 1.0f);
 
-	vec3 normal		= normalize(instanceData.Transform * vertices.vertex[gl_VertexIndex].Normal).xyz;
-	vec3 tangent	= normalize(instanceData.Transform * vertices.vertex[gl_VertexIndex].Tangent).xyz;
+	vec3 normal		= normalize(instanceData.Transform * vertex.Normal).xyz;
+	vec3 tangent	= normalize(instanceData.Transform * vertex.Tangent).xyz;
 	vec3 bitangent	= normalize(cross(normal, tangent));
 	mat3 TBN		= mat3(tangent, bitangent, normal);
 
-	out_TexCoord		= vertices.vertex[gl_VertexIndex].TexCoord.xy;
-	out_Normal			= vertices.vertex[gl_VertexIndex].Normal.xyz;
+	out_TexCoord		= vertex.TexCoord.xy;
+	out_Normal			= vertex.Normal.xyz;
 	out_TBN				= TBN;
 	out_WorldPos		= worldPosition.xyz;
 	out_MaterialIndex	= instanceData.MaterialIndex;
@@ -199,6 +199,18 @@ project "Poly"
 		systemversion "latest"
 		buildoptions { "/utf-8" }
 
+	-- Only the AVX2 kernel is built for AVX2, ComposeTransforms() checks the CPU supports it before calling it.
+	-- Kept out of the precompiled header, which is built without it.
+	filter "files:Poly/src/Poly/Core/Utils/TransformBatchAVX2.cpp"
+		flags { "NoPCH" }
+
+	filter { "files:Poly/src/Poly/Core/Utils/TransformBatchAVX2.cpp", "action:vs*" }
+		buildoptions { "/arch:AVX2" }
+
+	filter { "files:Poly/src/Poly/Core/Utils/TransformBatchAVX2.cpp", "action:not vs*" }
+		buildoptions { "-mavx2" }
+	filter {}
+
 project "RG2TestApp"
 	location "RG2TestApp"
 	kind "ConsoleApp"
@@ -292,3 +304,47 @@ project "Sandbox"
 	filter "system:windows"
 		systemversion "latest"
 		buildoptions { "/utf-8" }
+
+-- Times ComposeTransforms() against glm on 100k transforms and checks both agree, exits with 1 if they don't
+project "TransformBench"
+	location "TransformBench"
+	kind "ConsoleApp"
+	cppdialect "c++20"
+
+	setDirs()
+	srcFiles()
+
+	externalincludedirs
+	{
+		"Poly/libs/glm",
+		"Poly/src"
+	}
+
+	links
+	{
+		"Poly"
+	}
+
+	filter "system:macosx"
+		links
+		{
+			"Cocoa.framework",
+			"IOKit.framework",
+			"CoreFoundation.framework",
+			"Metal.framework",
+			"IOSurface.framework",
+			"QuartzCore.framework",
+			"vulkan"
+		}
+		libdirs
+		{
+			vkPath .. "/lib",
+		}
+		runpathdirs
+		{
+			vkPath .. "/lib",
+		}
+
+	filter "system:windows"
+		systemversion "latest"
+		buildoptions { "/utf-8" }